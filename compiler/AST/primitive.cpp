@@ -722,6 +722,9 @@ initPrimitive() {
   // like PRIM_ASSIGN but the operation can be put off until end of
   // the enclosing task or forall.
   prim_def(PRIM_UNORDERED_ASSIGN, "unordered=", returnInfoVoid, true, true);
+  // like PRIM_UNORDERED_ASSIGN but the operation can also be buffered
+  // with others to the same locale (see --auto-aggregation).
+  prim_def(PRIM_AGGREGATED_ASSIGN, "aggregated=", returnInfoVoid, true, true);
 
   prim_def(PRIM_ADD_ASSIGN, "+=", returnInfoVoid, true);
   prim_def(PRIM_SUBTRACT_ASSIGN, "-=", returnInfoVoid, true);
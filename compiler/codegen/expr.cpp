@@ -4266,6 +4266,8 @@ DEFINE_PRIM(PRIM_ASSIGN) {
 
 DEFINE_PRIM(PRIM_UNORDERED_ASSIGN) {
 
+  // PRIM_AGGREGATED_ASSIGN is forwarded here
+  bool aggregated = call->isPrimitive(PRIM_AGGREGATED_ASSIGN);
   Expr* lhsExpr = call->get(1);
   Expr* rhsExpr = call->get(2);
   bool lhsWide = lhsExpr->isWideRef();
@@ -4297,7 +4299,8 @@ DEFINE_PRIM(PRIM_UNORDERED_ASSIGN) {
     if (dstRef)
       dst = codegenDeref(dst);
 
-    codegenCall("chpl_gen_comm_get_unordered",
+    codegenCall(aggregated ? "chpl_gen_comm_get_aggregated"
+                           : "chpl_gen_comm_get_unordered",
                 codegenCastToVoidStar(codegenAddrOf(dst)),
                 codegenRnode(src),
                 codegenRaddr(src),
@@ -4315,7 +4318,8 @@ DEFINE_PRIM(PRIM_UNORDERED_ASSIGN) {
     if (srcRef)
       src = codegenDeref(src);
 
-    codegenCall("chpl_gen_comm_put_unordered",
+    codegenCall(aggregated ? "chpl_gen_comm_put_aggregated"
+                           : "chpl_gen_comm_put_unordered",
                 codegenCastToVoidStar(codegenAddrOf(src)),
                 codegenRnode(dst),
                 codegenRaddr(dst),
@@ -4323,7 +4327,7 @@ DEFINE_PRIM(PRIM_UNORDERED_ASSIGN) {
                 genCommID(gGenInfo),
                 ln, fn);
   } else {
-    // do an unordered GETPUT
+    // do an unordered GETPUT (there is no aggregated GETPUT)
     // chpl_comm_getput_unordered(
     //   c_nodeid_t dst_locale, void* dst_raddr,
     //   c_nodeid_t src_locale, void* src_raddr,
@@ -4339,6 +4343,9 @@ DEFINE_PRIM(PRIM_UNORDERED_ASSIGN) {
                 ln, fn);
   }
 }
+DEFINE_PRIM(PRIM_AGGREGATED_ASSIGN) {
+    FORWARD_PRIM(PRIM_UNORDERED_ASSIGN);
+}
 DEFINE_PRIM(PRIM_ADD_ASSIGN) {
     codegenOpAssign(call->get(1), call->get(2), " += ", codegenAdd);
 }
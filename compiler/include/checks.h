@@ -48,6 +48,8 @@ void check_parallel();
 void check_prune();
 void check_bulkCopyRecords();
 void check_removeUnnecessaryAutoCopyCalls();
+void check_devirtualize();
+void check_stackAllocateClasses();
 void check_inlineFunctions();
 void check_scalarReplace();
 void check_refPropagation();
@@ -55,9 +55,11 @@ extern bool fNoDivZeroChecks;
 extern bool fMungeUserIdents;
 extern bool fEnableTaskTracking;
 extern bool fLLVMWideOpt;
+extern bool fLLVMRuntimeLTO;
 
 extern bool fAutoLocalAccess;
 extern bool fAutoLocalAccessDynamic;
+extern bool fAutoAggregation;
 extern bool fReportAutoLocalAccess;
 
 extern bool fNoRemoteValueForwarding;
@@ -73,7 +75,10 @@ extern bool fForceVectorize;
 extern bool fNoPrivatization;
 extern bool fNoOptimizeOnClauses;
 extern bool fNoRemoveEmptyRecords;
+extern bool fNoDevirtualize;
+extern bool fNoStackAllocateClasses;
 extern bool fNoInferLocalFields;
+extern bool fNoInferLocality;
 extern bool fRemoveUnreachableBlocks;
 extern bool fReplaceArrayAccessesWithRefTemps;
 extern int  optimize_on_clause_limit;
@@ -218,6 +223,9 @@ extern bool fReportPromotion;
 extern bool fReportScalarReplace;
 extern bool fReportDeadBlocks;
 extern bool fReportDeadModules;
+extern bool fReportDevirtualization;
+extern bool fReportStackAllocation;
+extern bool fReportInferredLocality;
 
 extern bool fPermitUnhandledModuleErrors;
 
@@ -34,6 +34,8 @@ extern char pythonModulename[FILENAME_MAX+1];
 extern char saveCDir[FILENAME_MAX+1];
 extern std::string ccflags;
 extern std::string ldflags;
+extern bool fProfileGenerate;
+extern char profileUseFile[FILENAME_MAX+1];
 extern bool ccwarnings;
 extern std::vector<const char*> incDirs;
 extern std::vector<const char*> libDirs;
@@ -99,6 +101,9 @@ const char* filenameToModulename(const char* filename);
 
 const char* getIntermediateDirName();
 
+const char* getProfileUseFile();
+std::string getProfileFlags();
+
 void readArgsFromCommand(std::string path, std::vector<std::string>& args);
 bool readArgsFromFile(std::string path, std::vector<std::string>& cmds,
                       bool errFatal=true);
@@ -47,6 +47,7 @@ void createTaskFunctions();
 void cullOverReferences();
 void deadCodeElimination();
 void denormalize();
+void devirtualize();
 void docs();
 void expandExternArrayCalls();
 void flattenClasses();
@@ -74,6 +75,7 @@ void resolveIntents();
 void returnStarTuplesByRefArgs();
 void scalarReplace();
 void scopeResolve();
+void stackAllocateClasses();
 void verify();
 
 //
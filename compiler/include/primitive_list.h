@@ -79,6 +79,7 @@
   PRIMITIVE_G(PRIM_ASSIGN)
   PRIMITIVE_R(PRIM_ASSIGN_ELIDED_COPY)
   PRIMITIVE_G(PRIM_UNORDERED_ASSIGN)
+  PRIMITIVE_G(PRIM_AGGREGATED_ASSIGN)
   PRIMITIVE_G(PRIM_ADD_ASSIGN)
   PRIMITIVE_G(PRIM_SUBTRACT_ASSIGN)
   PRIMITIVE_G(PRIM_MULT_ASSIGN)
@@ -59,10 +59,13 @@
 #include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Linker/Linker.h"
 #include "llvm/MC/SubtargetFeature.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Host.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/ToolOutputFile.h"
@@ -3168,6 +3171,150 @@ void checkAdjustedDataLayout() {
   INT_ASSERT(dl.getTypeSizeInBits(testTy) == GLOBAL_PTR_SIZE);
 }
 
+// Adds the globals that a value refers to, looking through constants
+static void collectReferencedGlobals(llvm::Value* v,
+                                     std::set<llvm::GlobalValue*>& refs,
+                                     std::set<llvm::Value*>& visited) {
+  if (!visited.insert(v).second)
+    return;
+
+  if (llvm::GlobalValue* gv = llvm::dyn_cast<llvm::GlobalValue>(v)) {
+    refs.insert(gv);
+  } else if (llvm::Constant* c = llvm::dyn_cast<llvm::Constant>(v)) {
+    for (llvm::Value* op : c->operands())
+      collectReferencedGlobals(op, refs, visited);
+  }
+}
+
+/*
+ * Link the definitions of the runtime functions that the generated code
+ * calls from the runtime's bitcode (libchpl.bc), so that the optimizer can
+ * inline them and optimize them along with the generated code.
+ *
+ * The runtime's variables stay in libchpl.a and are only declared here.
+ * The runtime's functions are made available_externally, so they are
+ * dropped once optimization is done and the definitions in libchpl.a are
+ * the ones that get linked.  A function that uses a private (static)
+ * variable of the runtime can't be copied without making a second copy of
+ * that variable, so it is left as a declaration.
+ */
+static void linkRuntimeBitcode(llvm::Module* mod) {
+  std::string path(CHPL_RUNTIME_LIB);
+  path += "/";
+  path += CHPL_RUNTIME_SUBDIR;
+  path += "/libchpl.bc";
+
+  llvm::SMDiagnostic err;
+  std::unique_ptr<llvm::Module> rt = llvm::parseIRFile(path, err,
+                                                       mod->getContext());
+  if (!rt)
+    USR_FATAL("Could not read runtime bitcode %s for --llvm-runtime-lto; "
+              "build the runtime with 'make LLVM_RUNTIME_LTO=1'",
+              path.c_str());
+
+  rt->setDataLayout(mod->getDataLayout());
+  rt->setTargetTriple(mod->getTargetTriple());
+
+  // Constructors and llvm.used entries belong to libchpl.a
+  std::vector<llvm::GlobalVariable*> appending;
+  for (llvm::GlobalVariable& gv : rt->globals())
+    if (gv.hasAppendingLinkage())
+      appending.push_back(&gv);
+  for (llvm::GlobalVariable* gv : appending)
+    gv->eraseFromParent();
+
+  std::set<llvm::GlobalValue*> own;
+  for (llvm::GlobalValue& gv : mod->global_values())
+    if (!gv.isDeclaration())
+      own.insert(&gv);
+
+  if (llvm::Linker::linkModules(*mod, std::move(rt),
+                                llvm::Linker::Flags::LinkOnlyNeeded))
+    USR_FATAL("Could not link runtime bitcode %s", path.c_str());
+
+  std::vector<llvm::Function*> fns;
+  std::vector<llvm::GlobalVariable*> vars;
+  std::set<llvm::GlobalValue*> privateState;
+
+  for (llvm::Function& fn : mod->functions())
+    if (!fn.isDeclaration() && own.count(&fn) == 0)
+      fns.push_back(&fn);
+
+  for (llvm::GlobalVariable& gv : mod->globals()) {
+    if (!gv.isDeclaration() && own.count(&gv) == 0) {
+      vars.push_back(&gv);
+      if (gv.hasLocalLinkage() && !gv.isConstant())
+        privateState.insert(&gv);
+    }
+  }
+
+  // Find the functions (and constant tables) that use private state,
+  // directly or through other private functions and constants.  Calls to
+  // non-private functions that use it are fine, since they can be left
+  // to libchpl.a.
+  std::map<llvm::GlobalValue*, std::set<llvm::GlobalValue*> > refs;
+  for (llvm::Function* fn : fns) {
+    std::set<llvm::Value*> visited;
+    for (llvm::BasicBlock& bb : *fn)
+      for (llvm::Instruction& inst : bb)
+        for (llvm::Value* op : inst.operands())
+          collectReferencedGlobals(op, refs[fn], visited);
+  }
+  for (llvm::GlobalVariable* gv : vars) {
+    if (gv->hasLocalLinkage() && gv->isConstant()) {
+      std::set<llvm::Value*> visited;
+      collectReferencedGlobals(gv->getInitializer(), refs[gv], visited);
+    }
+  }
+
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (auto& it : refs) {
+      if (privateState.count(it.first))
+        continue;
+      for (llvm::GlobalValue* ref : it.second) {
+        if (ref->hasLocalLinkage() && privateState.count(ref)) {
+          privateState.insert(it.first);
+          changed = true;
+          break;
+        }
+      }
+    }
+  }
+
+  std::vector<llvm::GlobalValue*> unused;
+
+  for (llvm::Function* fn : fns) {
+    if (privateState.count(fn)) {
+      if (fn->hasLocalLinkage())
+        unused.push_back(fn);
+      fn->deleteBody();
+    } else if (fn->hasExternalLinkage()) {
+      fn->setLinkage(llvm::GlobalValue::AvailableExternallyLinkage);
+      fn->setComdat(nullptr);
+    }
+  }
+
+  for (llvm::GlobalVariable* gv : vars) {
+    if (privateState.count(gv)) {
+      gv->setInitializer(nullptr);
+      unused.push_back(gv);
+    } else if (gv->hasExternalLinkage() || gv->hasCommonLinkage()) {
+      gv->setInitializer(nullptr);
+      gv->setLinkage(llvm::GlobalValue::ExternalLinkage);
+      gv->setComdat(nullptr);
+    }
+  }
+
+  // Nothing refers to the private state any more
+  for (llvm::GlobalValue* gv : unused) {
+    gv->removeDeadConstantUsers();
+    if (gv->use_empty())
+      gv->eraseFromParent();
+  }
+}
+
 static void makeLLVMStaticLibrary(std::string moduleFilename,
                                   const char* tmpbinname,
                                   std::vector<std::string> dotOFiles);
@@ -3237,6 +3384,9 @@ void makeBinaryLLVM(void) {
   }
 #endif
 
+  if (fLLVMRuntimeLTO)
+    linkRuntimeBitcode(info->module);
+
 
   // Open the output file
   std::error_code error;
@@ -3284,6 +3434,18 @@ void makeBinaryLLVM(void) {
 
   configurePMBuilder(PMBuilder, /* for function passes */ false);
 
+  // Instrument the module to collect an execution profile, or use one to
+  // guide inlining, block placement, etc.
+  if (fProfileGenerate) {
+#if HAVE_LLVM_VER >= 90
+    PMBuilder.EnablePGOInstrGen = true;
+#else
+    PMBuilder.PGOInstrGen = "default_%m.profraw";
+#endif
+  } else if (profileUseFile[0] != '\0') {
+    PMBuilder.PGOInstrUse = getProfileUseFile();
+  }
+
   // Note, these global extensions currently only apply
   // to the module-level optimization (not the "basic" function
   // optimization we do immediately after generating LLVM IR).
@@ -3592,6 +3754,11 @@ void makeBinaryLLVM(void) {
   options += " ";
   options += ldflags;
 
+  // Link in the profiling runtime for --profile-generate
+  if (fProfileGenerate) {
+    options += " -fprofile-generate";
+  }
+
   // We may need to add the -pthread flag here for the link step
   // if we start doing link-time optimization.  For now, leave it
   // out because its unnecessary inclusion causes a warning message
@@ -52,6 +52,7 @@
 #include <string>
 #include <sstream>
 #include <map>
+#include <unistd.h>
 
 #ifdef HAVE_LLVM
 #include "llvm/Config/llvm-config.h"
@@ -155,6 +156,7 @@ bool fIgnoreNilabilityErrors = false;
 bool fOverloadSetsChecks = true;
 bool fNoStackChecks = false;
 bool fNoInferLocalFields = false;
+bool fNoInferLocality = false;
 bool fReplaceArrayAccessesWithRefTemps = false;
 bool fUserSetStackChecks = false;
 bool fNoCastChecks = false;
@@ -163,6 +165,7 @@ bool fEnableTaskTracking = false;
 
 bool fAutoLocalAccess = true;
 bool fAutoLocalAccessDynamic = true;
+bool fAutoAggregation = false;
 bool fReportAutoLocalAccess= false;
 
 bool  printPasses     = false;
@@ -171,6 +174,9 @@ FILE* printPassesFile = NULL;
 // flag for llvmWideOpt
 bool fLLVMWideOpt = false;
 
+// flag for llvmRuntimeLTO
+bool fLLVMRuntimeLTO = false;
+
 bool fWarnConstLoops = true;
 bool fWarnUnstable = false;
 
@@ -186,6 +192,8 @@ bool fNoInline = false;
 bool fNoPrivatization = false;
 bool fNoOptimizeOnClauses = false;
 bool fNoRemoveEmptyRecords = true;
+bool fNoDevirtualize = false;
+bool fNoStackAllocateClasses = false;
 bool fRemoveUnreachableBlocks = true;
 bool fMinimalModules = false;
 bool fIncrementalCompilation = false;
@@ -238,6 +246,9 @@ bool fReportPromotion = false;
 bool fReportScalarReplace = false;
 bool fReportDeadBlocks = false;
 bool fReportDeadModules = false;
+bool fReportDevirtualization = false;
+bool fReportStackAllocation = false;
+bool fReportInferredLocality = false;
 bool fPermitUnhandledModuleErrors = false;
 #ifdef HAVE_LLVM_RV
 bool fRegionVectorizer = true;
@@ -755,6 +766,7 @@ static void setFastFlag(const ArgumentDescription* desc, const char* unused) {
   fNoPrivatization = false;
   fNoChecks = true;
   fNoInferLocalFields = false;
+  fNoInferLocality = false;
   fIgnoreLocalClasses = false;
   fNoOptimizeOnClauses = false;
   //fReplaceArrayAccessesWithRefTemps = true; // don't tie this to --fast yet
@@ -787,6 +799,7 @@ static void setBaselineFlag(const ArgumentDescription* desc, const char* unused)
 
   fNoCopyPropagation = true;          // --no-copy-propagation
   fNoDeadCodeElimination = true;      // --no-dead-code-elimination
+  fNoDevirtualize = true;             // --no-devirtualize
   fNoFastFollowers = true;            // --no-fast-followers
   fNoLoopInvariantCodeMotion = true;  // --no-loop-invariant-code-motion
                                       // --no-interprocedural-alias-analysis
@@ -802,14 +815,17 @@ static void setBaselineFlag(const ArgumentDescription* desc, const char* unused)
   fNoRemoteSerialization = true;      // --no-remote-serialization
   fNoRemoveCopyCalls = true;          // --no-remove-copy-calls
   fNoScalarReplacement = true;        // --no-scalar-replacement
+  fNoStackAllocateClasses = true;     // --no-stack-allocate-classes
   fNoTupleCopyOpt = true;             // --no-tuple-copy-opt
   fNoPrivatization = true;            // --no-privatization
   fNoOptimizeOnClauses = true;        // --no-optimize-on-clauses
   fIgnoreLocalClasses = true;         // --ignore-local-classes
   fNoInferLocalFields = true;         // --no-infer-local-fields
+  fNoInferLocality = true;            // --no-infer-locality
   //fReplaceArrayAccessesWithRefTemps = false; // don't tie this to --baseline yet
   fDenormalize = false;               // --no-denormalize
   fNoOptimizeForallUnordered = true;  // --no-optimize-forall-unordered-ops
+  fAutoAggregation = false;           // --no-auto-aggregation
 }
 
 static void setCacheEnable(const ArgumentDescription* desc, const char* unused) {
@@ -929,6 +945,7 @@ static ArgumentDescription arg_desc[] = {
  {"cache-remote", ' ', NULL, "[Don't] enable cache for remote data", "N", &fCacheRemote, "CHPL_CACHE_REMOTE", setCacheEnable},
  {"copy-propagation", ' ', NULL, "Enable [disable] copy propagation", "n", &fNoCopyPropagation, "CHPL_DISABLE_COPY_PROPAGATION", NULL},
  {"dead-code-elimination", ' ', NULL, "Enable [disable] dead code elimination", "n", &fNoDeadCodeElimination, "CHPL_DISABLE_DEAD_CODE_ELIMINATION", NULL},
+ {"devirtualize", ' ', NULL, "Enable [disable] devirtualization of method calls", "n", &fNoDevirtualize, "CHPL_DISABLE_DEVIRTUALIZE", NULL},
  {"fast", ' ', NULL, "Disable checks; optimize/specialize code", "F", &fFastFlag, "CHPL_FAST", setFastFlag},
  {"fast-followers", ' ', NULL, "Enable [disable] fast followers", "n", &fNoFastFollowers, "CHPL_DISABLE_FAST_FOLLOWERS", NULL},
  {"ieee-float", ' ', NULL, "Generate code that is strict [lax] with respect to IEEE compliance", "N", &fieeefloat, "CHPL_IEEE_FLOAT", setFloatOptFlag},
@@ -949,13 +966,16 @@ static ArgumentDescription arg_desc[] = {
  {"remove-copy-calls", ' ', NULL, "Enable [disable] remove copy calls", "n", &fNoRemoveCopyCalls, "CHPL_DISABLE_REMOVE_COPY_CALLS", NULL},
  {"scalar-replacement", ' ', NULL, "Enable [disable] scalar replacement", "n", &fNoScalarReplacement, "CHPL_DISABLE_SCALAR_REPLACEMENT", NULL},
  {"scalar-replace-limit", ' ', "<limit>", "Limit on the size of tuples being replaced during scalar replacement", "I", &scalar_replace_limit, "CHPL_SCALAR_REPLACE_TUPLE_LIMIT", NULL},
+ {"stack-allocate-classes", ' ', NULL, "Enable [disable] stack allocation of class instances that do not escape", "n", &fNoStackAllocateClasses, "CHPL_DISABLE_STACK_ALLOCATE_CLASSES", NULL},
  {"tuple-copy-opt", ' ', NULL, "Enable [disable] tuple (memcpy) optimization", "n", &fNoTupleCopyOpt, "CHPL_DISABLE_TUPLE_COPY_OPT", NULL},
  {"tuple-copy-limit", ' ', "<limit>", "Limit on the size of tuples considered for optimization", "I", &tuple_copy_limit, "CHPL_TUPLE_COPY_LIMIT", NULL},
  {"infer-local-fields", ' ', NULL, "Enable [disable] analysis to infer local fields in classes and records", "n", &fNoInferLocalFields, "CHPL_DISABLE_INFER_LOCAL_FIELDS", NULL},
+ {"infer-locality", ' ', NULL, "Enable [disable] narrowing of wide references that are known to be local", "n", &fNoInferLocality, "CHPL_DISABLE_INFER_LOCALITY", NULL},
  {"vectorize", ' ', NULL, "Enable [disable] generation of vectorization hints", "n", &fNoVectorize, "CHPL_DISABLE_VECTORIZATION", setVectorize},
 
  {"auto-local-access", ' ', NULL, "Enable [disable] using local access automatically", "N", &fAutoLocalAccess, "CHPL_DISABLE_AUTO_LOCAL_ACCESS", NULL},
  {"auto-local-access-dynamic", ' ', NULL, "Enable [disable] using local access automatically (dynamic only)", "N", &fAutoLocalAccessDynamic, "CHPL_DISABLE_AUTO_LOCAL_ACCESS_DYNAMIC", NULL},
+ {"auto-aggregation", ' ', NULL, "Enable [disable] automatically aggregating remote assignments in foralls", "N", &fAutoAggregation, "CHPL_AUTO_AGGREGATION", NULL},
 
  {"", ' ', NULL, "Run-time Semantic Check Options", NULL, NULL, NULL, NULL},
  {"checks", ' ', NULL, "Enable [disable] all following run-time checks", "n", &fNoChecks, "CHPL_NO_CHECKS", setChecks},
@@ -985,10 +1005,13 @@ static ArgumentDescription arg_desc[] = {
  {"optimize", 'O', NULL, "[Don't] Optimize generated C code", "N", &optimizeCCode, "CHPL_OPTIMIZE", NULL},
  {"specialize", ' ', NULL, "[Don't] Specialize generated C code for CHPL_TARGET_CPU", "N", &specializeCCode, "CHPL_SPECIALIZE", NULL},
  {"output", 'o', "<filename>", "Name output executable", "P", executableFilename, "CHPL_EXE_NAME", NULL},
+ {"profile-generate", ' ', NULL, "Instrument the generated code to collect an execution profile", "F", &fProfileGenerate, "CHPL_PROFILE_GENERATE", NULL},
+ {"profile-use", ' ', "<file>", "Optimize the generated code using an execution profile", "P", profileUseFile, "CHPL_PROFILE_USE", NULL},
  {"static", ' ', NULL, "Generate a statically linked binary", "F", &fLinkStyle, NULL, NULL},
 
  {"", ' ', NULL, "LLVM Code Generation Options", NULL, NULL, NULL, NULL},
  {"llvm", ' ', NULL, "[Don't] use the LLVM code generator", "N", &fYesLlvmCodegen, "CHPL_LLVM_CODEGEN", setLlvmCodegen},
+ {"llvm-runtime-lto", ' ', NULL, "Enable [disable] optimizing the runtime with the generated code", "N", &fLLVMRuntimeLTO, "CHPL_LLVM_RUNTIME_LTO", NULL},
  {"llvm-wide-opt", ' ', NULL, "Enable [disable] LLVM wide pointer optimizations", "N", &fLLVMWideOpt, "CHPL_LLVM_WIDE_OPTS", NULL},
  {"mllvm", ' ', "<flags>", "LLVM flags (can be specified multiple times)", "S", NULL, "CHPL_MLLVM", setLLVMFlags},
 
@@ -1072,6 +1095,8 @@ static ArgumentDescription arg_desc[] = {
  {"report-inlining", ' ', NULL, "Print inlined functions", "F", &report_inlining, NULL, NULL},
  {"report-dead-blocks", ' ', NULL, "Print dead block removal stats", "F", &fReportDeadBlocks, NULL, NULL},
  {"report-dead-modules", ' ', NULL, "Print dead module removal stats", "F", &fReportDeadModules, NULL, NULL},
+ {"report-devirtualization", ' ', NULL, "Print devirtualization stats", "F", &fReportDevirtualization, NULL, NULL},
+ {"report-inferred-locality", ' ', NULL, "Print locality inference stats", "F", &fReportInferredLocality, NULL, NULL},
  {"report-optimized-loop-iterators", ' ', NULL, "Print stats on optimized single loop iterators", "F", &fReportOptimizedLoopIterators, NULL, NULL},
  {"report-inlined-iterators", ' ', NULL, "Print stats on inlined iterators", "F", &fReportInlinedIterators, NULL, NULL},
  {"report-vectorized-loops", ' ', NULL, "Show which loops have vectorization hints", "F", &fReportVectorizedLoops, NULL, NULL},
@@ -1080,6 +1105,7 @@ static ArgumentDescription arg_desc[] = {
  {"report-optimized-forall-unordered-ops", ' ', NULL, "Show which statements in foralls have been converted to unordered operations", "F", &fReportOptimizeForallUnordered, NULL, NULL},
  {"report-promotion", ' ', NULL, "Print information about scalar promotion", "F", &fReportPromotion, NULL, NULL},
  {"report-scalar-replace", ' ', NULL, "Print scalar replacement stats", "F", &fReportScalarReplace, NULL, NULL},
+ {"report-stack-allocation", ' ', NULL, "Print stack allocation stats", "F", &fReportStackAllocation, NULL, NULL},
 
  {"", ' ', NULL, "Developer Flags -- Miscellaneous", NULL, NULL, NULL, NULL},
  {"allow-noinit-array-not-pod", ' ', NULL, "Allow noinit for arrays of records", "N", &fAllowNoinitArrayNotPod, "CHPL_BREAK_ON_CODEGEN", NULL},
@@ -1494,6 +1520,9 @@ static void checkLLVMCodeGen() {
   if (fLlvmCodegen)
     USR_FATAL("This compiler was built without LLVM support");
 #endif
+
+  if (fLLVMRuntimeLTO && !fLlvmCodegen)
+    USR_FATAL("--llvm-runtime-lto requires --llvm");
 }
 
 static void checkTargetCpu() {
@@ -1525,6 +1554,27 @@ static void checkUnsupportedConfigs(void) {
   }
 }
 
+static void checkProfileFlags(void) {
+  if (profileUseFile[0] == '\0') {
+    if (fProfileGenerate == false) {
+      return;
+    }
+
+  } else if (fProfileGenerate) {
+    USR_FATAL("--profile-generate and --profile-use cannot be used together");
+
+  } else if (access(profileUseFile, R_OK) != 0) {
+    USR_FATAL("Could not find profile '%s'", profileUseFile);
+  }
+
+  // Profiles are read and written in LLVM's format
+  if (fLlvmCodegen == false &&
+      strstr(CHPL_TARGET_COMPILER, "clang") == NULL) {
+    USR_FATAL("--profile-generate and --profile-use require --llvm or "
+              "a clang CHPL_TARGET_COMPILER");
+  }
+}
+
 static void checkMLDebugAndLibmode(void) {
 
   if (!fMultiLocaleLibraryDebug) { return; }
@@ -1576,6 +1626,8 @@ static void postprocess_args() {
   checkIncrementalAndOptimized();
 
   checkUnsupportedConfigs();
+
+  checkProfileFlags();
 }
 
 int main(int argc, char* argv[]) {
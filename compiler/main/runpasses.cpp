@@ -65,6 +65,8 @@ struct PassInfo {
 #define LOG_prune                              LOG_NO_SHORT
 #define LOG_bulkCopyRecords                    LOG_NO_SHORT
 #define LOG_removeUnnecessaryAutoCopyCalls     LOG_NO_SHORT
+#define LOG_devirtualize                       LOG_NO_SHORT
+#define LOG_stackAllocateClasses               LOG_NO_SHORT
 #define LOG_inlineFunctions                    LOG_NO_SHORT
 #define LOG_scalarReplace                      LOG_NO_SHORT
 #define LOG_refPropagation                     LOG_NO_SHORT
@@ -132,6 +134,8 @@ static PassInfo sPassList[] = {
   // Optimizations
   RUN(bulkCopyRecords),         // replace simple assignments with PRIM_ASSIGN.
   RUN(removeUnnecessaryAutoCopyCalls),
+  RUN(devirtualize),            // replace virtual calls with direct calls
+  RUN(stackAllocateClasses),    // stack allocate non-escaping instances
   RUN(inlineFunctions),         // function inlining
   RUN(scalarReplace),           // scalar replace all tuples
   RUN(refPropagation),          // reference propagation
@@ -0,0 +1,382 @@
+/*
+ * Copyright 2020 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/************************************* | **************************************
+*                                                                             *
+* Replace virtual method calls with direct calls using whole-program class    *
+* hierarchy analysis.                                                         *
+*                                                                             *
+* A PRIM_VIRTUAL_METHOD_CALL can only dispatch to the method that the         *
+* virtual method table holds for a class that is actually allocated and that  *
+* is a subclass of the static type of the receiver.  A class is considered    *
+* allocated if some PRIM_SETCID outside of its initializers sets an object's  *
+* cid to it, or if one of its initializers runs code after setting the cid.   *
+*                                                                             *
+*   - If every such class shares one implementation the call is replaced by   *
+*     a direct call to it (monomorphic).                                      *
+*                                                                             *
+*   - If there are two implementations and one of them is used by exactly     *
+*     one class, the call is replaced by a PRIM_TESTCID guard on that class   *
+*     choosing between two direct calls (bimorphic).                          *
+*                                                                             *
+* Other calls are left alone.  Direct calls can then be inlined by            *
+* inlineFunctions() and by the back-end compiler.                             *
+*                                                                             *
+************************************** | *************************************/
+
+#include "passes.h"
+
+#include "astutil.h"
+#include "DecoratedClassType.h"
+#include "driver.h"
+#include "expr.h"
+#include "stlUtil.h"
+#include "stmt.h"
+#include "symbol.h"
+#include "type.h"
+#include "virtualDispatch.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+typedef std::map<FnSymbol*, std::vector<AggregateType*> > ImplMap;
+
+static int  numVirtualCalls   = 0;
+static int  numDevirtualized  = 0;
+static int  numGuarded        = 0;
+
+static void     findAllocatedClasses(std::set<AggregateType*>& allocated);
+static bool     initRunsAfterSetCid(CallExpr* setCid);
+static void     devirtualizeCall(CallExpr*                       call,
+                                 const std::vector<AggregateType*>& classes);
+static int      receiverIndex(FnSymbol* fn);
+static bool     sameSignature(FnSymbol* fn, FnSymbol* impl);
+static CallExpr* buildDirectCall(CallExpr* call,
+                                 FnSymbol* impl,
+                                 Expr*     anchor);
+static void     removeUnusedCid(Symbol* cid);
+
+void devirtualize() {
+  if (fNoDevirtualize == true) {
+    return;
+  }
+
+  std::set<AggregateType*>    allocated;
+  std::vector<AggregateType*> classes;
+  std::vector<CallExpr*>      calls;
+
+  findAllocatedClasses(allocated);
+
+  // Keep the classes in creation order so that the guards are deterministic
+  forv_Vec(AggregateType, at, gAggregateTypes) {
+    if (allocated.count(at) != 0) {
+      classes.push_back(at);
+    }
+  }
+
+  forv_Vec(CallExpr, call, gCallExprs) {
+    if (call->inTree() && call->isPrimitive(PRIM_VIRTUAL_METHOD_CALL)) {
+      calls.push_back(call);
+    }
+  }
+
+  for_vector(CallExpr, call, calls) {
+    devirtualizeCall(call, classes);
+  }
+
+  if (fReportDevirtualization) {
+    printf("\tDevirtualized %d of %d virtual method calls (%d guarded)\n",
+           numDevirtualized, numVirtualCalls, numGuarded);
+  }
+}
+
+static void findAllocatedClasses(std::set<AggregateType*>& allocated) {
+  forv_Vec(CallExpr, call, gCallExprs) {
+    if (call->inTree() && call->isPrimitive(PRIM_SETCID)) {
+      FnSymbol*      fn = call->getFunction();
+      AggregateType* at = toAggregateType(call->get(1)->typeInfo());
+
+      if (at == NULL) {
+        continue;
+      }
+
+      if (fn->isInitializer() == false || initRunsAfterSetCid(call)) {
+        allocated.insert(at);
+      }
+    }
+  }
+}
+
+//
+// An initializer sets the cid to its own class on its way out, after which
+// the initializer of a subclass sets it again.  The intermediate cid can only
+// be observed if the initializer runs more code after setting it.
+//
+static bool initRunsAfterSetCid(CallExpr* setCid) {
+  FnSymbol* fn = setCid->getFunction();
+
+  if (setCid->parentExpr != fn->body) {
+    return true;
+  }
+
+  for (Expr* expr = setCid->next; expr != NULL; expr = expr->next) {
+    if (isDefExpr(expr) == true) {
+      continue;
+    }
+
+    if (CallExpr* call = toCallExpr(expr)) {
+      if (call->isPrimitive(PRIM_RETURN) == true ||
+          call->isPrimitive(PRIM_SETCID) == true) {
+        continue;
+      }
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
+static void devirtualizeCall(CallExpr*                          call,
+                             const std::vector<AggregateType*>& classes) {
+  FnSymbol* fn     = toFnSymbol(toSymExpr(call->get(1))->symbol());
+  int       index  = virtualMethodMap.get(fn);
+  int       recv   = receiverIndex(fn);
+  bool      report = fReportDevirtualization &&
+                     (developer || printsUserLocation(call));
+
+  if (report) {
+    numVirtualCalls++;
+  }
+
+  if (recv < 0) {
+    return;
+  }
+
+  Vec<FnSymbol*>* fnVmt = virtualMethodTable.get(fn->_this->type);
+
+  if (fnVmt == NULL || index >= fnVmt->n || fnVmt->v[index] != fn) {
+    return;
+  }
+
+  SymExpr* recvSe = toSymExpr(call->get(3 + recv));
+
+  if (recvSe == NULL || recvSe->symbol()->isRef() == true) {
+    return;
+  }
+
+  Type*                 recvType = canonicalClassType(recvSe->typeInfo());
+  ImplMap               impls;
+  std::vector<FnSymbol*> order;
+
+  for_vector(AggregateType, at, classes) {
+    if (isSubClass(at, recvType) == true) {
+      Vec<FnSymbol*>* vmt = virtualMethodTable.get(at);
+
+      if (vmt == NULL || index >= vmt->n) {
+        return;
+      }
+
+      FnSymbol* impl = vmt->v[index];
+
+      if (sameSignature(fn, impl) == false) {
+        return;
+      }
+
+      if (impls.count(impl) == 0) {
+        order.push_back(impl);
+      }
+
+      impls[impl].push_back(at);
+    }
+  }
+
+  Expr*     stmt   = call->getStmtExpr();
+  CallExpr* move   = toCallExpr(call->parentExpr);
+  Symbol*   cid    = toSymExpr(call->get(2))->symbol();
+
+  SET_LINENO(call);
+
+  if (order.size() == 1) {
+    CallExpr* direct = buildDirectCall(call, order[0], stmt);
+
+    call->replace(direct);
+
+    if (report) {
+      USR_PRINT(direct, "Devirtualized call to %s", fn->name);
+      numDevirtualized++;
+    }
+
+  } else if (order.size() == 2                                  &&
+             (stmt == call || (move == stmt &&
+                               move->isPrimitive(PRIM_MOVE) &&
+                               move->get(2) == call))) {
+    FnSymbol* guarded = order[0];
+    FnSymbol* other   = order[1];
+
+    if (impls[guarded].size() != 1) {
+      std::swap(guarded, other);
+    }
+
+    if (impls[guarded].size() != 1) {
+      return;
+    }
+
+    AggregateType* guardType = impls[guarded][0];
+    VarSymbol*     guard     = newTemp("_devirt_guard", dtBool);
+    BlockStmt*     thenStmt  = new BlockStmt();
+    BlockStmt*     elseStmt  = new BlockStmt();
+    CondStmt*      cond      = new CondStmt(new SymExpr(guard),
+                                            thenStmt,
+                                            elseStmt);
+
+    stmt->insertBefore(new DefExpr(guard));
+    stmt->insertBefore(new CallExpr(PRIM_MOVE,
+                                    guard,
+                                    new CallExpr(PRIM_TESTCID,
+                                                 recvSe->copy(),
+                                                 guardType->symbol)));
+    stmt->insertBefore(cond);
+
+    thenStmt->insertAtTail(new CallExpr(PRIM_NOOP));
+    elseStmt->insertAtTail(new CallExpr(PRIM_NOOP));
+
+    CallExpr* thenCall = buildDirectCall(call, guarded, thenStmt->body.tail);
+    CallExpr* elseCall = buildDirectCall(call, other,   elseStmt->body.tail);
+
+    if (stmt == call) {
+      thenStmt->body.tail->replace(thenCall);
+      elseStmt->body.tail->replace(elseCall);
+
+    } else {
+      thenStmt->body.tail->replace(new CallExpr(PRIM_MOVE,
+                                                move->get(1)->copy(),
+                                                thenCall));
+      elseStmt->body.tail->replace(new CallExpr(PRIM_MOVE,
+                                                move->get(1)->copy(),
+                                                elseCall));
+    }
+
+    stmt->remove();
+
+    if (report) {
+      USR_PRINT(cond, "Devirtualized call to %s with a guard for %s",
+                fn->name, guardType->symbol->name);
+      numDevirtualized++;
+      numGuarded++;
+    }
+
+  } else {
+    return;
+  }
+
+  removeUnusedCid(cid);
+}
+
+// The position of the receiver among the formals of 'fn', or -1
+static int receiverIndex(FnSymbol* fn) {
+  int i = 0;
+
+  for_formals(formal, fn) {
+    if (formal == fn->_this) {
+      return i;
+    }
+
+    i++;
+  }
+
+  return -1;
+}
+
+// Overrides may differ in the receiver but not in anything else we pass
+static bool sameSignature(FnSymbol* fn, FnSymbol* impl) {
+  if (impl->retType != fn->retType || impl->numFormals() != fn->numFormals()) {
+    return false;
+  }
+
+  for (int i = 1; i <= fn->numFormals(); i++) {
+    ArgSymbol* formal     = fn->getFormal(i);
+    ArgSymbol* implFormal = impl->getFormal(i);
+
+    if (formal == fn->_this) {
+      if (implFormal != impl->_this || implFormal->isRef() != formal->isRef()) {
+        return false;
+      }
+
+    } else if (implFormal->type    != formal->type ||
+               implFormal->isRef() != formal->isRef()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//
+// Build a call to 'impl' with the actuals of the virtual 'call', casting the
+// receiver to the class 'impl' is defined on if needed.  Any temps are
+// inserted before 'anchor'.
+//
+static CallExpr* buildDirectCall(CallExpr* call,
+                                 FnSymbol* impl,
+                                 Expr*     anchor) {
+  CallExpr* retval = new CallExpr(impl);
+  int       i      = 0;
+
+  for_actuals(actual, call) {
+    i++;
+
+    // Skip the function symbol and the cid
+    if (i <= 2) {
+      continue;
+    }
+
+    Expr* arg = actual->copy();
+
+    if (impl->getFormal(i - 2) == impl->_this &&
+        arg->typeInfo()        != impl->_this->type) {
+      VarSymbol* tmp = newTemp("_devirt_this", impl->_this->type);
+
+      anchor->insertBefore(new DefExpr(tmp));
+      anchor->insertBefore(new CallExpr(PRIM_MOVE,
+                                        tmp,
+                                        new CallExpr(PRIM_CAST,
+                                                     impl->_this->type->symbol,
+                                                     arg)));
+
+      arg = new SymExpr(tmp);
+    }
+
+    retval->insertAtTail(arg);
+  }
+
+  return retval;
+}
+
+// Remove the cid temp computed for the virtual call if nothing else uses it
+static void removeUnusedCid(Symbol* cid) {
+  if (cid->isUsed() == false) {
+    if (SymExpr* def = cid->getSingleDef()) {
+      def->getStmtExpr()->remove();
+    }
+
+    cid->defPoint->remove();
+  }
+}
@@ -39,6 +39,7 @@
 #include "WhileStmt.h"
 
 #include <algorithm>
+#include <map>
 #include <set>
 #include <stack>
 
@@ -475,6 +476,334 @@ static bool isConst(SymExpr* symExpr) {
 }
 
 
+/*
+ * A summary of the memory that a loop might write, other than the locals of
+ * the function it is in. A read through a ref formal, which may be a wide
+ * reference to another locale once insertWideReferences has run, is loop
+ * invariant if nothing the loop writes can overlap it. Writes are described
+ * by type: a store through a ref (or to a global) notes the type stored, a
+ * SET_MEMBER notes the field, and anything that can't be described (a call
+ * that might write memory, an unknown primitive) makes the summary unknown.
+ *
+ * Other tasks can't change the value read without a data race, since
+ * canPerformCodeMotion() already rejects loops that use syncs, singles or
+ * atomics, so the summary only needs to cover this task's writes.
+ */
+class LoopWrites {
+public:
+  LoopWrites() : unknown(false), calls(false), records(false) { }
+
+  bool any() const {
+    return unknown || records || types.size() != 0 || fields.size() != 0;
+  }
+
+  bool              unknown;  // a write we could not describe
+  bool              calls;    // a call that might write memory
+  bool              records;  // a store of a record, union or tuple
+  std::set<Type*>   types;    // value types stored through refs or to globals
+  std::set<Symbol*> fields;   // fields stored with a SET_MEMBER
+};
+
+static std::map<FnSymbol*, bool> readOnlyFns;
+
+/*
+ * Primitives that neither write memory nor call anything
+ */
+static bool isNonWritingPrimitive(CallExpr* call) {
+  switch (call->primitive->tag) {
+    case PRIM_UNARY_MINUS:
+    case PRIM_UNARY_PLUS:
+    case PRIM_UNARY_NOT:
+    case PRIM_UNARY_LNOT:
+    case PRIM_ADD:
+    case PRIM_SUBTRACT:
+    case PRIM_MULT:
+    case PRIM_DIV:
+    case PRIM_MOD:
+    case PRIM_LSH:
+    case PRIM_RSH:
+    case PRIM_EQUAL:
+    case PRIM_NOTEQUAL:
+    case PRIM_LESSOREQUAL:
+    case PRIM_GREATEROREQUAL:
+    case PRIM_LESS:
+    case PRIM_GREATER:
+    case PRIM_AND:
+    case PRIM_OR:
+    case PRIM_XOR:
+    case PRIM_POW:
+    case PRIM_MIN:
+    case PRIM_MAX:
+    case PRIM_GETCID:
+    case PRIM_TESTCID:
+    case PRIM_GET_UNION_ID:
+    case PRIM_GET_MEMBER:
+    case PRIM_GET_MEMBER_VALUE:
+    case PRIM_GET_REAL:
+    case PRIM_GET_IMAG:
+    case PRIM_GET_SVEC_MEMBER:
+    case PRIM_GET_SVEC_MEMBER_VALUE:
+    case PRIM_ADDR_OF:
+    case PRIM_SET_REFERENCE:
+    case PRIM_DEREF:
+    case PRIM_CAST:
+    case PRIM_NOOP:
+    case PRIM_END_OF_STATEMENT:
+    case PRIM_RETURN:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
+static bool isStorePrimitive(CallExpr* call) {
+  return call->isPrimitive(PRIM_MOVE)   ||
+         call->isPrimitive(PRIM_ASSIGN) ||
+         isOpEqualPrim(call);
+}
+
+/*
+ * A non-ref variable declared in fn
+ */
+static bool isLocalVar(Symbol* sym, FnSymbol* fn) {
+  return isVarSymbol(sym) && !sym->isRef() && sym->defPoint->parentSymbol == fn;
+}
+
+/*
+ * A MOVE into a ref whose rhs is itself a ref binds the ref instead of
+ * storing through it
+ */
+static bool isRefBinding(CallExpr* call) {
+  return call->isPrimitive(PRIM_MOVE) &&
+         call->get(1)->isRef()        &&
+         call->get(2)->isRef();
+}
+
+/*
+ * A ref declared in fn that only ever refers to non-ref variables of fn
+ */
+static bool isLocalRef(Symbol* sym, FnSymbol* fn) {
+  if (!isVarSymbol(sym) || !sym->isRef() || sym->defPoint->parentSymbol != fn) {
+    return false;
+  }
+
+  for_SymbolSymExprs(se, sym) {
+    CallExpr* move = toCallExpr(se->parentExpr);
+
+    // Stores through the ref don't change what it refers to
+    if (move == NULL || move->get(1) != se || !isRefBinding(move)) {
+      continue;
+    }
+
+    CallExpr* rhs = toCallExpr(move->get(2));
+
+    if (rhs == NULL || !(rhs->isPrimitive(PRIM_ADDR_OF) ||
+                         rhs->isPrimitive(PRIM_SET_REFERENCE))) {
+      return false;
+    }
+
+    SymExpr* target = toSymExpr(rhs->get(1));
+
+    if (target == NULL || !isLocalVar(target->symbol(), fn)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Returns true if fn (and everything it calls) can only write its own
+ * non-ref locals. Such a function can't change anything its caller sees
+ * other than through its return value.
+ */
+static bool isReadOnlyFn(FnSymbol* fn) {
+  std::map<FnSymbol*, bool>::iterator it = readOnlyFns.find(fn);
+
+  if (it != readOnlyFns.end()) {
+    return it->second;
+  }
+
+  // Be pessimistic about recursion
+  readOnlyFns[fn] = false;
+
+  if (fn->hasFlag(FLAG_EXTERN)                    ||
+      fn->hasFlag(FLAG_ON_BLOCK)                  ||
+      fn->hasFlag(FLAG_BEGIN_BLOCK)               ||
+      fn->hasFlag(FLAG_COBEGIN_OR_COFORALL_BLOCK) ||
+      fn->hasFlag(FLAG_LOCAL_ON)                  ||
+      isTaskFun(fn)                               ||
+      fn->body == NULL                            ||
+      fn->retType->symbol->hasFlag(FLAG_REF)) {
+    return false;
+  }
+
+  std::vector<CallExpr*> calls;
+  collectCallExprs(fn->body, calls);
+
+  for_vector(CallExpr, call, calls) {
+    if (FnSymbol* callee = call->resolvedFunction()) {
+      if (!isReadOnlyFn(callee)) {
+        return false;
+      }
+
+    } else if (call->primitive == NULL) {
+      return false;
+
+    } else if (isStorePrimitive(call)) {
+      SymExpr* lhs = toSymExpr(call->get(1));
+
+      if (lhs == NULL) {
+        return false;
+      }
+
+      if (!isLocalVar(lhs->symbol(), fn) &&
+          !(isRefBinding(call) && isLocalRef(lhs->symbol(), fn))) {
+        return false;
+      }
+
+    } else if (call->isPrimitive(PRIM_SET_MEMBER)) {
+      SymExpr* base = toSymExpr(call->get(1));
+
+      if (base == NULL || !isLocalVar(base->symbol(), fn) ||
+          !isRecord(base->symbol()->type)) {
+        return false;
+      }
+
+    } else if (!isNonWritingPrimitive(call)) {
+      return false;
+    }
+  }
+
+  readOnlyFns[fn] = true;
+
+  return true;
+}
+
+static void noteStoredType(Type* type, LoopWrites& writes) {
+  writes.types.insert(type);
+
+  if (isRecord(type) || isUnion(type)) {
+    writes.records = true;
+  }
+}
+
+/*
+ * Summarize the writes in a loop that can be observed outside of the
+ * function that contains it
+ */
+static void computeLoopWrites(Loop* loop, FnSymbol* fn, LoopWrites& writes) {
+  for_vector(BasicBlock, block, *loop->getBlocks()) {
+    for_vector(Expr, expr, block->exprs) {
+      std::vector<CallExpr*> calls;
+      collectCallExprs(expr, calls);
+
+      for_vector(CallExpr, call, calls) {
+        if (FnSymbol* callee = call->resolvedFunction()) {
+          if (!isReadOnlyFn(callee)) {
+            writes.unknown = true;
+            writes.calls   = true;
+          }
+
+        } else if (call->primitive == NULL ||
+                   call->isPrimitive(PRIM_VIRTUAL_METHOD_CALL)) {
+          writes.unknown = true;
+          writes.calls   = true;
+
+        } else if (isStorePrimitive(call)) {
+          SymExpr* lhs = toSymExpr(call->get(1));
+
+          if (lhs == NULL) {
+            writes.unknown = true;
+
+          } else if (lhs->symbol()->isRef()) {
+            if (!isRefBinding(call) && !isLocalRef(lhs->symbol(), fn)) {
+              noteStoredType(lhs->getValType(), writes);
+            }
+
+          } else if (isModuleSymbol(lhs->symbol()->defPoint->parentSymbol)) {
+            noteStoredType(lhs->symbol()->type, writes);
+          }
+
+        } else if (call->isPrimitive(PRIM_SET_MEMBER)) {
+          if (SymExpr* field = toSymExpr(call->get(2))) {
+            writes.fields.insert(field->symbol());
+
+            if (isRecord(field->symbol()->type) ||
+                isUnion(field->symbol()->type)) {
+              writes.records = true;
+            }
+          } else {
+            writes.unknown = true;
+          }
+
+        } else if (call->isPrimitive(PRIM_SET_SVEC_MEMBER)) {
+          writes.records = true;
+
+        } else if (!isNonWritingPrimitive(call) &&
+                   !call->isPrimitive(PRIM_CHECK_NIL)) {
+          writes.unknown = true;
+        }
+      }
+    }
+  }
+}
+
+/*
+ * Returns true if the value read through symExpr, a use of a ref formal,
+ * can't be changed by the writes in the loop.
+ */
+static bool refReadIsInvariant(SymExpr* symExpr, LoopWrites& writes) {
+  CallExpr* call = toCallExpr(symExpr->parentExpr);
+
+  if (writes.unknown || call == NULL) {
+    return false;
+  }
+
+  Type* valType = symExpr->getValType();
+
+  if (call->isPrimitive(PRIM_GET_MEMBER) && call->get(1) == symExpr) {
+    // Only computes an address
+    return true;
+
+  } else if (call->isPrimitive(PRIM_GET_MEMBER_VALUE) &&
+             call->get(1) == symExpr) {
+    SymExpr* field = toSymExpr(call->get(2));
+
+    return field != NULL                             &&
+           writes.records == false                   &&
+           writes.fields.count(field->symbol()) == 0 &&
+           writes.types.count(field->symbol()->type) == 0;
+
+  } else if (call->isPrimitive(PRIM_DEREF) ||
+             (call->isPrimitive(PRIM_MOVE) &&
+              call->get(2) == symExpr      &&
+              call->get(1)->isRef() == false)) {
+    if (writes.records || writes.types.count(valType) != 0) {
+      return false;
+    }
+
+    if (isRecord(valType) || isUnion(valType)) {
+      return writes.fields.size() == 0;
+    }
+
+    for_set(Symbol, field, writes.fields) {
+      if (field->type == valType) {
+        return false;
+      }
+    }
+
+    return true;
+
+  } else if (FnSymbol* callee = call->resolvedFunction()) {
+    return writes.any() == false && isReadOnlyFn(callee);
+  }
+
+  return false;
+}
+
+
 /*
  * TODO The following three functions duplicate most of the functionality that is in the
  * routines found in astUtil. However, these use the STL containers instead of the
@@ -548,8 +877,10 @@ static void buildLocalDefUseMaps(Loop* loop, symToVecSymExprMap& localDefMap, sy
               addDefOrUse(localUseMap, symExpr->symbol(), symExpr);
             }
             //if we have a function call, assume any "classes" fields are changed
+            //unless the function can't write anything the caller sees
             if(CallExpr* callExpr = toCallExpr(symExpr->parentExpr)) {
-              if(callExpr->isResolved() || callExpr->isPrimitive(PRIM_VIRTUAL_METHOD_CALL)) {
+              if((callExpr->isResolved() && !isReadOnlyFn(callExpr->resolvedFunction())) ||
+                 callExpr->isPrimitive(PRIM_VIRTUAL_METHOD_CALL)) {
                 addDefOrUse(localDefMap, symExpr->symbol(), symExpr);
                 Type* type = symExpr->symbol()->type->symbol->type;
                 if(AggregateType* curClass = toAggregateType(type)) {
@@ -588,7 +919,7 @@ static void freeLocalDefUseMaps(symToVecSymExprMap& localDefMap, symToVecSymExpr
  *
  * This should only be called externally on a call expr whose lhs has only one def in a loop
  */
-static bool allOperandsAreLoopInvariant(Expr* expr, std::set<SymExpr*>& loopInvariants, std::set<SymExpr*>& loopInvariantInstructions, Loop* loop,   std::map<SymExpr*, std::set<SymExpr*> >& actualDefs) {
+static bool allOperandsAreLoopInvariant(Expr* expr, std::set<SymExpr*>& loopInvariants, std::set<SymExpr*>& loopInvariantInstructions, Loop* loop,   std::map<SymExpr*, std::set<SymExpr*> >& actualDefs, LoopWrites& writes) {
 
   //if we have an assignment, recursively compute if all operands are invariant
   //if there was a different loop invariant operand, make sure all its arguments
@@ -596,11 +927,23 @@ static bool allOperandsAreLoopInvariant(Expr* expr, std::set<SymExpr*>& loopInva
   if(CallExpr* callExpr = toCallExpr(expr)) {
     if(callExpr->primitive && isLoopInvariantPrimitive(callExpr->primitive)) {
       if(callExpr->isPrimitive(PRIM_MOVE) || callExpr->isPrimitive(PRIM_ASSIGN)) {
-        return allOperandsAreLoopInvariant(callExpr->get(2), loopInvariants, loopInvariantInstructions, loop, actualDefs);
+        return allOperandsAreLoopInvariant(callExpr->get(2), loopInvariants, loopInvariantInstructions, loop, actualDefs, writes);
       }
       else {
         for_alist(arg, callExpr->argList) {
-          if(allOperandsAreLoopInvariant(arg, loopInvariants, loopInvariantInstructions, loop, actualDefs) == false) {
+          if(allOperandsAreLoopInvariant(arg, loopInvariants, loopInvariantInstructions, loop, actualDefs, writes) == false) {
+            return false;
+          }
+        }
+        return true;
+      }
+    }
+    //a call to a function that only reads memory is invariant if its
+    //arguments are and nothing in the loop writes memory it could read
+    if(FnSymbol* fn = callExpr->resolvedFunction()) {
+      if(writes.any() == false && isReadOnlyFn(fn)) {
+        for_alist(arg, callExpr->argList) {
+          if(allOperandsAreLoopInvariant(arg, loopInvariants, loopInvariantInstructions, loop, actualDefs, writes) == false) {
             return false;
           }
         }
@@ -812,15 +1155,13 @@ static bool computeAliases(FnSymbol* fn, std::map<Symbol*, std::set<Symbol*> >&
  */
 static void computeLoopInvariants(std::vector<SymExpr*>& loopInvariants,
     std::set<Symbol*>& defsInLoop, Loop* loop, symToVecSymExprMap& localDefMap,
-    std::map<Symbol*, std::set<Symbol*> >& aliases) {
+    std::map<Symbol*, std::set<Symbol*> >& aliases, LoopWrites& writes) {
 
   // collect all of the symExprs, defExprs, and callExprs in the loop
   startTimer(collectSymExprAndDefTimer);
   std::vector<SymExpr*> loopSymExprs;
-  std::vector<CallExpr*> callsInLoop;
   for_vector(BasicBlock, block, *loop->getBlocks()) {
     for_vector(Expr, expr, block->exprs) {
-      collectFnCalls(expr, callsInLoop);
       collectSymExprs(expr, loopSymExprs);
       if (DefExpr* defExpr = toDefExpr(expr)) {
         if (toVarSymbol(defExpr->sym)) {
@@ -912,10 +1253,15 @@ static void computeLoopInvariants(std::vector<SymExpr*>& loopInvariants,
     // Note that not all things that are passed by ref will have the ref intent
     // flag, and may just be ref variables. This is a known bug, see comments
     // in addVarsToFormals(): flattenFunctions.cpp.
+    // A read through a ref formal is still invariant if nothing the loop
+    // writes could change it. This is what lets remote (wide) loads of
+    // fields that the loop doesn't write be hoisted.
+    bool invariantRefRead = isArgSymbol(symExpr->symbol()) &&
+                            refReadIsInvariant(symExpr, writes);
     if (isArgSymbol(symExpr->symbol()) &&
         symExpr->getValType()->symbol->hasFlag(FLAG_ITERATOR_CLASS) == false) {
       if(ArgSymbol* argSymbol = toArgSymbol(symExpr->symbol())) {
-        if(argSymbol->isRef()) {
+        if(argSymbol->isRef() && !invariantRefRead) {
           mightHaveBeenDeffedElseWhere = true;
         }
       }
@@ -937,14 +1283,13 @@ static void computeLoopInvariants(std::vector<SymExpr*>& loopInvariants,
       // that would have to be protected with a sync or be atomic in which case
       // no hoisting will occur in the function at all. Any defs to the global
       // inside of this loop will be detected just like any other variable
-      // definitions.
-      // TODO this could be improved to check which functions modify the global
-      // and see if any of those functions are being called in this loop.
-      if (callsInLoop.size() != 0) {
+      // definitions. Calls to functions that only write their own locals
+      // can't change it either.
+      if (writes.calls) {
         mightHaveBeenDeffedElseWhere = true;
       }
     }
-    if (symExpr->symbol()->isRef()) {
+    if (symExpr->symbol()->isRef() && !invariantRefRead) {
         mightHaveBeenDeffedElseWhere = true;
     }
     for_set(Symbol, aliasSym, aliases[symExpr->symbol()]) {
@@ -981,7 +1326,7 @@ static void computeLoopInvariants(std::vector<SymExpr*>& loopInvariants,
                  callExpr->isPrimitive(PRIM_ASSIGN)) {
                 if(callExpr->get(1) == symExpr2) {
                   startTimer(allOperandsAreLoopInvariantTimer);
-                  bool loopInvarOps = allOperandsAreLoopInvariant(callExpr, loopInvariantOperands, loopInvariantInstructions, loop, actualDefs);
+                  bool loopInvarOps = allOperandsAreLoopInvariant(callExpr, loopInvariantOperands, loopInvariantInstructions, loop, actualDefs, writes);
                   stopTimer(allOperandsAreLoopInvariantTimer);
                   if(loopInvarOps){
                     loopInvariantInstructions.insert(symExpr2);
@@ -1151,6 +1496,134 @@ static bool canPerformCodeMotion(Loop* loop) {
 }
 
 
+/*
+ * If call is a hoisted load of a field of a record through a ref formal,
+ * return the formal
+ */
+static Symbol* fieldLoadBase(CallExpr* call) {
+  if (call->inTree() && call->isPrimitive(PRIM_MOVE)) {
+    if (CallExpr* rhs = toCallExpr(call->get(2))) {
+      if (rhs->isPrimitive(PRIM_GET_MEMBER_VALUE)) {
+        SymExpr* base = toSymExpr(rhs->get(1));
+
+        if (base                          != NULL &&
+            isArgSymbol(base->symbol())           &&
+            base->symbol()->isRef()               &&
+            isRecord(base->getValType())) {
+          return base->symbol();
+        }
+      }
+    }
+  }
+
+  return NULL;
+}
+
+/*
+ * An estimate of the number of bytes in a value of type t, ignoring
+ * padding.  Records and tuples are the sum of their fields, and anything
+ * that is not a number is counted as a pointer.
+ */
+static int64_t estimateTypeBytes(Type* t) {
+  if (t == dtBool) {
+    return 1;
+  }
+
+  if (is_bool_type(t) || is_int_type(t)  || is_uint_type(t) ||
+      is_real_type(t) || is_imag_type(t) || is_complex_type(t)) {
+    return get_width(t) / 8;
+  }
+
+  if (isRecord(t) && t->symbol->hasFlag(FLAG_REF) == false) {
+    int64_t bytes = 0;
+
+    for_fields(field, toAggregateType(t)) {
+      bytes += estimateTypeBytes(field->type);
+    }
+
+    return bytes;
+  }
+
+  return 8;
+}
+
+/*
+ * Hoisted loads of most of the bytes of a record that is read through a
+ * ref formal are replaced with one load of the whole record into a temp, so
+ * that when the record is on another locale it is fetched with a single GET
+ * before the loop instead of one GET per field.
+ *
+ * Only runs of hoisted statements (and their DefExprs) are combined, so
+ * nothing between the bulk load and the field loads can write the record.
+ */
+static void bulkLoadHoistedFields(std::vector<CallExpr*>& hoisted) {
+  std::set<CallExpr*> hoistedSet(hoisted.begin(), hoisted.end());
+  std::set<CallExpr*> done;
+
+  for_vector(CallExpr, first, hoisted) {
+    Symbol* base = fieldLoadBase(first);
+
+    if (base == NULL || done.count(first) == 1) {
+      continue;
+    }
+
+    std::vector<CallExpr*> group;
+    std::set<Symbol*>      fields;
+
+    for (Expr* expr = first; expr != NULL; expr = expr->next) {
+      if (isDefExpr(expr)) {
+        continue;
+      }
+
+      CallExpr* call = toCallExpr(expr);
+
+      if (call == NULL || hoistedSet.count(call) == 0 || call->get(1)->isRef()) {
+        break;
+      }
+
+      if (fieldLoadBase(call) == base) {
+        CallExpr* rhs = toCallExpr(call->get(2));
+
+        group.push_back(call);
+        fields.insert(toSymExpr(rhs->get(2))->symbol());
+      }
+    }
+
+    AggregateType* at = toAggregateType(base->getValType());
+
+    if (fields.size() < 2) {
+      continue;
+    }
+
+    // Loading the whole record must not move much more data than loading
+    // the fields, e.g. when a large field is never read
+    int64_t fieldBytes = 0;
+
+    for_set(Symbol, field, fields) {
+      fieldBytes += estimateTypeBytes(field->type);
+    }
+
+    if (2 * fieldBytes < estimateTypeBytes(at)) {
+      continue;
+    }
+
+    SET_LINENO(first);
+
+    VarSymbol* tmp = newTemp("licm_bulk_tmp", at);
+
+    first->insertBefore(new DefExpr(tmp));
+    first->insertBefore(new CallExpr(PRIM_MOVE,
+                                     tmp,
+                                     new CallExpr(PRIM_DEREF, base)));
+
+    for_vector(CallExpr, call, group) {
+      toCallExpr(call->get(2))->get(1)->replace(new SymExpr(tmp));
+      done.insert(call);
+    }
+  }
+}
+
+
 /*
  * The basic algorithm for loop invariant code motion is as follows:
  * First figure out where the loops actually are. To do this the dominators need
@@ -1194,6 +1667,7 @@ static long licmFn(FnSymbol* fn) {
   //Collect all of the loops
   startTimer(collectNaturalLoopsTimer);
   std::vector<Loop*> loops;
+  std::vector<CallExpr*> hoisted;
   collectNaturalLoops(loops, basicBlocks, entryBlock, dominators);
   stopTimer(collectNaturalLoopsTimer);
 
@@ -1226,7 +1700,9 @@ static long licmFn(FnSymbol* fn) {
     if (tooManyAliases) {
       return 0;
     }
-    computeLoopInvariants(loopInvariants, defsInLoop, curLoop, localDefMap, aliases);
+    LoopWrites writes;
+    computeLoopWrites(curLoop, fn, writes);
+    computeLoopInvariants(loopInvariants, defsInLoop, curLoop, localDefMap, aliases, writes);
     stopTimer(computeLoopInvariantsTimer);
 
     //For each invariant, only move it if its def, dominates all uses and all exits
@@ -1238,6 +1714,7 @@ static long licmFn(FnSymbol* fn) {
               curLoop->insertBefore(symExpr->symbol()->defPoint);
             }
             curLoop->insertBefore(call);
+            hoisted.push_back(call);
           }
         }
       }
@@ -1247,6 +1724,8 @@ static long licmFn(FnSymbol* fn) {
   }
   numLoops += loops.size();
 
+  bulkLoadHoistedFields(hoisted);
+
   for_vector(Loop, loop, loops) {
     delete loop;
     loop = 0;
@@ -1272,6 +1751,8 @@ void loopInvariantCodeMotion(void) {
     return;
   }
 
+  readOnlyFns.clear();
+
   startTimer(overallTimer);
   long numLoops = 0;
 
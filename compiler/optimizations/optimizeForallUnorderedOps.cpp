@@ -58,6 +58,13 @@
    This handles PRIM_ASSIGN as well as several chpl_comm_atomic functions
    by converting them to unordered calls within the runtime.
 
+   With --auto-aggregation, PRIM_ASSIGN is converted to
+   PRIM_AGGREGATED_ASSIGN instead.  That is an unordered GET or PUT
+   that the runtime may hold in a per-task buffer for the remote
+   locale, to be sent along with others to the same locale when the
+   buffer fills or the task ends.  The atomic functions are already
+   buffered per task by the comm layers that have them.
+
    It could handle PRIM_ARRAY_SET_FIRST as well if that becomes
    important in the future.
  */
@@ -927,11 +934,16 @@ static void transformAssignStmt(Expr* stmt) {
     // add the call to getput
     if (fReportOptimizeForallUnordered) {
       if (developer || printsUserLocation(call)) {
-        USR_PRINT(call, "Optimized assign to be unordered");
+        if (fAutoAggregation)
+          USR_PRINT(call, "Optimized assign to be aggregated");
+        else
+          USR_PRINT(call, "Optimized assign to be unordered");
       }
     }
 
-    call->insertBefore(new CallExpr(PRIM_UNORDERED_ASSIGN, lhs, rhs->copy()));
+    PrimitiveTag prim = fAutoAggregation ? PRIM_AGGREGATED_ASSIGN
+                                         : PRIM_UNORDERED_ASSIGN;
+    call->insertBefore(new CallExpr(prim, lhs, rhs->copy()));
     call->remove();
     if (callToRemove)
       callToRemove->remove();
@@ -0,0 +1,572 @@
+/*
+ * Copyright 2020 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/************************************* | **************************************
+*                                                                             *
+* Allocate class instances that do not escape the function that creates      *
+* them on the stack rather than the heap.                                     *
+*                                                                             *
+* The candidates are calls to a _new wrapper or to a _getIterator function    *
+* that allocates an iterator class.  An instance escapes if a pointer to it,  *
+* or a reference into it, can outlive the block that creates it: it is        *
+* returned, stored in memory, captured by a task or on-statement, passed to   *
+* an extern function, or copied into a variable declared outside the block.   *
+* Calls are followed into the callee through formals that are passed by       *
+* value; recursion is treated as an escape.                                   *
+*                                                                             *
+* For each instance that does not escape                                      *
+*                                                                             *
+*   - the call is redirected to an inline clone of the allocating function    *
+*     in which chpl_here_alloc() is replaced by PRIM_STACK_ALLOCATE_CLASS.    *
+*     inlineFunctions() then places the storage in the caller's frame.        *
+*                                                                             *
+*   - 'delete' of the instance becomes a direct call to its deinit() and      *
+*     _freeIterator() of the instance is removed.                             *
+*                                                                             *
+* Instances stored in owned or shared, packed into the tuple of a zippered    *
+* loop, or passed through a 'ref' formal escape and stay on the heap.         *
+*                                                                             *
+************************************** | *************************************/
+
+#include "passes.h"
+
+#include "astutil.h"
+#include "driver.h"
+#include "expr.h"
+#include "stlUtil.h"
+#include "stmt.h"
+#include "stringutil.h"
+#include "symbol.h"
+#include "type.h"
+#include "wellknown.h"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+class EscapeContext {
+public:
+  EscapeContext(Expr* scopeArg, std::vector<CallExpr*>* freesArg) {
+    scope       = scopeArg;
+    frees       = freesArg;
+    mayReturn   = false;
+    returnsRef  = false;
+  }
+
+  Expr*                   scope;      // aliases must be declared within
+  std::vector<CallExpr*>* frees;      // 'delete' and _freeIterator() calls
+  bool                    mayReturn;  // the instance may be returned
+  bool                    returnsRef; // a reference into it is returned
+};
+
+enum FormalSummary {
+  FORMAL_IN_PROGRESS,
+  FORMAL_ESCAPES,
+  FORMAL_NO_ESCAPE,
+  FORMAL_RETURNS_REF
+};
+
+typedef std::pair<ArgSymbol*, bool>             FormalKey;
+typedef std::map<FormalKey, FormalSummary>      FormalSummaryMap;
+
+static FormalSummaryMap                  formalSummaries;
+static std::map<FnSymbol*, bool>         allocatorOk;
+static std::map<FnSymbol*, FnSymbol*>    stackClones;
+
+static int numAllocations   = 0;
+static int numStackAllocated = 0;
+
+static bool      isCandidate(CallExpr* call);
+static CallExpr* findAllocation(FnSymbol* fn);
+static bool      allocationStaysLocal(FnSymbol* fn);
+static void      stackAllocate(CallExpr* move);
+static bool      escapes(Symbol*        sym,
+                         bool           interior,
+                         CallExpr*      def,
+                         EscapeContext& ctx);
+static bool      aliasEscapes(CallExpr*      move,
+                              bool           interior,
+                              EscapeContext& ctx);
+static bool      callEscapes(SymExpr*       se,
+                             CallExpr*      call,
+                             bool           interior,
+                             EscapeContext& ctx);
+static FormalSummary summarizeFormal(ArgSymbol* formal, bool interior);
+static bool      isFree(CallExpr* call);
+static bool      isOpaque(FnSymbol* fn);
+static FnSymbol* stackClone(FnSymbol* fn);
+static void      replaceFree(CallExpr* call, AggregateType* at);
+
+void stackAllocateClasses() {
+  // The storage is only placed in the caller's frame by inlining
+  if (fNoStackAllocateClasses == true || fNoInline == true) {
+    return;
+  }
+
+  std::vector<CallExpr*> moves;
+
+  forv_Vec(CallExpr, call, gCallExprs) {
+    if (call->inTree() && isCandidate(call)) {
+      moves.push_back(toCallExpr(call->parentExpr));
+    }
+  }
+
+  for_vector(CallExpr, move, moves) {
+    stackAllocate(move);
+  }
+
+  if (fReportStackAllocation) {
+    printf("\tStack allocated %d of %d class allocations\n",
+           numStackAllocated, numAllocations);
+  }
+
+  formalSummaries.clear();
+  allocatorOk.clear();
+  stackClones.clear();
+}
+
+// A statement 'move v, call _new(...)' or 'move v, call _getIterator(...)'
+static bool isCandidate(CallExpr* call) {
+  FnSymbol* fn   = call->resolvedFunction();
+  CallExpr* move = toCallExpr(call->parentExpr);
+
+  if (fn == NULL || move == NULL || move->isPrimitive(PRIM_MOVE) == false) {
+    return false;
+  }
+
+  if (fn->hasFlag(FLAG_NEW_WRAPPER) == false &&
+      (fn->hasFlag(FLAG_AUTO_II) == false || fn->name != astr("_getIterator"))) {
+    return false;
+  }
+
+  return findAllocation(fn) != NULL;
+}
+
+//
+// Find 'move tmp, call chpl_here_alloc(...)' immediately followed by
+// 'move x, cast T tmp' for a class T, if it is the only allocation in 'fn'.
+//
+static CallExpr* findAllocation(FnSymbol* fn) {
+  std::vector<CallExpr*> calls;
+  CallExpr*              retval = NULL;
+
+  collectCallExprs(fn->body, calls);
+
+  for_vector(CallExpr, call, calls) {
+    if (call->resolvedFunction() == gChplHereAlloc) {
+      if (retval != NULL) {
+        return NULL;
+      }
+
+      retval = toCallExpr(call->parentExpr);
+    }
+  }
+
+  if (retval == NULL                              ||
+      retval->isPrimitive(PRIM_MOVE) == false     ||
+      retval->parentExpr             != fn->body) {
+    return NULL;
+  }
+
+  CallExpr* castMove = toCallExpr(retval->next);
+  Symbol*   tmp      = toSymExpr(retval->get(1))->symbol();
+
+  if (castMove == NULL || castMove->isPrimitive(PRIM_MOVE) == false) {
+    return NULL;
+  }
+
+  CallExpr* cast = toCallExpr(castMove->get(2));
+
+  if (cast == NULL                            ||
+      cast->isPrimitive(PRIM_CAST) == false   ||
+      toSymExpr(cast->get(2))      == NULL    ||
+      toSymExpr(cast->get(2))->symbol() != tmp) {
+    return NULL;
+  }
+
+  AggregateType* at = toAggregateType(cast->get(1)->typeInfo());
+
+  if (at == NULL || isClass(at) == false || at->symbol->hasFlag(FLAG_EXTERN)) {
+    return NULL;
+  }
+
+  return retval;
+}
+
+// The instance allocated by 'fn' reaches its caller only through the return
+static bool allocationStaysLocal(FnSymbol* fn) {
+  std::map<FnSymbol*, bool>::iterator it = allocatorOk.find(fn);
+
+  if (it != allocatorOk.end()) {
+    return it->second;
+  }
+
+  CallExpr*     castMove = toCallExpr(findAllocation(fn)->next);
+  Symbol*       sym      = toSymExpr(castMove->get(1))->symbol();
+  EscapeContext ctx(fn->body, NULL);
+  bool          retval   = false;
+
+  ctx.mayReturn = true;
+
+  if (escapes(sym, false, castMove, ctx) == false && ctx.returnsRef == false) {
+    retval = true;
+  }
+
+  allocatorOk[fn] = retval;
+
+  return retval;
+}
+
+static void stackAllocate(CallExpr* move) {
+  CallExpr*              call   = toCallExpr(move->get(2));
+  FnSymbol*              fn     = call->resolvedFunction();
+  Symbol*                sym    = toSymExpr(move->get(1))->symbol();
+  BlockStmt*             block  = toBlockStmt(move->parentExpr);
+  CallExpr*              cast   = toCallExpr(toCallExpr(findAllocation(fn)->next)->get(2));
+  AggregateType*         at     = toAggregateType(cast->get(1)->typeInfo());
+  bool                   report = fReportStackAllocation &&
+                                  (developer || printsUserLocation(call));
+  std::vector<CallExpr*> frees;
+
+  if (report) {
+    numAllocations++;
+  }
+
+  if (block == NULL || isVarSymbol(sym) == false || sym->isRef() == true) {
+    return;
+  }
+
+  EscapeContext ctx(block, &frees);
+
+  if (escapes(sym, false, move, ctx) == true ||
+      ctx.returnsRef                 == true ||
+      allocationStaysLocal(fn)       == false) {
+    return;
+  }
+
+  SET_LINENO(call);
+
+  toSymExpr(call->baseExpr)->setSymbol(stackClone(fn));
+
+  for_vector(CallExpr, free, frees) {
+    replaceFree(free, at);
+  }
+
+  if (report) {
+    if (fn->hasFlag(FLAG_NEW_WRAPPER)) {
+      USR_PRINT(call, "Allocated %s on the stack", at->symbol->name);
+    } else {
+      USR_PRINT(call, "Allocated iterator on the stack");
+    }
+
+    numStackAllocated++;
+  }
+}
+
+//
+// Does the instance held by 'sym' escape?  If 'interior' then 'sym' is a
+// reference into the instance rather than a pointer to it.  'def' is the
+// statement that set 'sym'; any other definition of it is an escape.
+//
+static bool escapes(Symbol*        sym,
+                    bool           interior,
+                    CallExpr*      def,
+                    EscapeContext& ctx) {
+  for_SymbolSymExprs(se, sym) {
+    CallExpr* call = toCallExpr(se->parentExpr);
+
+    if (call == NULL) {
+      return true;
+    }
+
+    if (call == def && se == call->get(1)) {
+      continue;
+    }
+
+    if (call->isPrimitive(PRIM_MOVE) || call->isPrimitive(PRIM_ASSIGN)) {
+      if (se == call->get(1)) {
+        // Writing through a reference is fine, redefining it is not
+        if (interior == false ||
+            (call->isPrimitive(PRIM_MOVE) && call->get(2)->isRef())) {
+          return true;
+        }
+
+      } else if (interior == true && call->get(1)->isRef() == false) {
+        // A copy of the value
+
+      } else if (aliasEscapes(call, interior, ctx) == true) {
+        return true;
+      }
+
+    } else if (call->isPrimitive(PRIM_END_OF_STATEMENT)) {
+
+    } else if ((call->isPrimitive(PRIM_GET_MEMBER_VALUE) ||
+                call->isPrimitive(PRIM_SET_MEMBER))   &&
+               se == call->get(1)) {
+
+    } else if (call->isPrimitive(PRIM_GET_MEMBER) && se == call->get(1)) {
+      CallExpr* move = toCallExpr(call->parentExpr);
+
+      if (move == NULL || move->isPrimitive(PRIM_MOVE) == false ||
+          aliasEscapes(move, true, ctx) == true) {
+        return true;
+      }
+
+    } else if (interior == false) {
+      if (call->isPrimitive(PRIM_GETCID)      ||
+          call->isPrimitive(PRIM_TESTCID)     ||
+          call->isPrimitive(PRIM_SETCID)      ||
+          call->isPrimitive(PRIM_CHECK_NIL)   ||
+          call->isPrimitive(PRIM_EQUAL)       ||
+          call->isPrimitive(PRIM_NOTEQUAL)    ||
+          call->isPrimitive(PRIM_PTR_EQUAL)   ||
+          call->isPrimitive(PRIM_PTR_NOTEQUAL)) {
+
+      } else if (call->isPrimitive(PRIM_CAST) ||
+                 call->isPrimitive(PRIM_DYNAMIC_CAST)) {
+        CallExpr* move = toCallExpr(call->parentExpr);
+
+        if (isClass(call->typeInfo()) == false ||
+            move                      == NULL  ||
+            move->isPrimitive(PRIM_MOVE) == false ||
+            aliasEscapes(move, false, ctx) == true) {
+          return true;
+        }
+
+      } else if (call->isPrimitive(PRIM_RETURN)) {
+        if (ctx.mayReturn == false) {
+          return true;
+        }
+
+      } else if (callEscapes(se, call, false, ctx) == true) {
+        return true;
+      }
+
+    } else {
+      if (call->isPrimitive(PRIM_DEREF) || isOpEqualPrim(call)) {
+
+      } else if (call->isPrimitive(PRIM_RETURN)) {
+        ctx.returnsRef = true;
+
+      } else if (callEscapes(se, call, true, ctx) == true) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+//
+// 'move' copies the instance or a reference into it to another variable.
+// The copy must be a local declared within the context's scope.
+//
+static bool aliasEscapes(CallExpr* move, bool interior, EscapeContext& ctx) {
+  SymExpr*   lhs = toSymExpr(move->get(1));
+  VarSymbol* var = lhs != NULL ? toVarSymbol(lhs->symbol()) : NULL;
+
+  if (var == NULL || var->isRef() != interior) {
+    return true;
+  }
+
+  for (Expr* expr = var->defPoint; expr != NULL; expr = expr->parentExpr) {
+    if (expr == ctx.scope) {
+      return escapes(var, interior, move, ctx);
+    }
+  }
+
+  return true;
+}
+
+static bool callEscapes(SymExpr*       se,
+                        CallExpr*      call,
+                        bool           interior,
+                        EscapeContext& ctx) {
+  FnSymbol* fn = call->resolvedFunction();
+
+  if (fn == NULL || isOpaque(fn) == true) {
+    return true;
+  }
+
+  if (interior == false && ctx.frees != NULL && isFree(call) == true) {
+    ctx.frees->push_back(call);
+    return false;
+  }
+
+  ArgSymbol* formal = actual_to_formal(se);
+
+  // A reference passed by value is a copy of the value
+  if (interior == true && formal->isRef() == false) {
+    return false;
+  }
+
+  if (interior == false && formal->isRef() == true) {
+    return true;
+  }
+
+  FormalSummary summary = summarizeFormal(formal, interior);
+
+  if (summary == FORMAL_RETURNS_REF) {
+    CallExpr* move = toCallExpr(call->parentExpr);
+
+    if (move == NULL) {
+      return false;
+    }
+
+    return move->isPrimitive(PRIM_MOVE) == false ||
+           aliasEscapes(move, true, ctx)  == true;
+  }
+
+  return summary != FORMAL_NO_ESCAPE;
+}
+
+static FormalSummary summarizeFormal(ArgSymbol* formal, bool interior) {
+  FormalKey                  key(formal, interior);
+  FormalSummaryMap::iterator it = formalSummaries.find(key);
+
+  if (it != formalSummaries.end()) {
+    // Recursion is treated as an escape
+    return it->second == FORMAL_IN_PROGRESS ? FORMAL_ESCAPES : it->second;
+  }
+
+  FnSymbol*     fn = toFnSymbol(formal->defPoint->parentSymbol);
+  EscapeContext ctx(fn->body, NULL);
+  FormalSummary retval;
+
+  formalSummaries[key] = FORMAL_IN_PROGRESS;
+
+  if (escapes(formal, interior, NULL, ctx) == true) {
+    retval = FORMAL_ESCAPES;
+
+  } else if (ctx.returnsRef == true) {
+    retval = FORMAL_RETURNS_REF;
+
+  } else {
+    retval = FORMAL_NO_ESCAPE;
+  }
+
+  formalSummaries[key] = retval;
+
+  return retval;
+}
+
+// 'delete x' or _freeIterator(x) for a class instance x
+static bool isFree(CallExpr* call) {
+  FnSymbol* fn = call->resolvedFunction();
+
+  if (call->getStmtExpr()  != call ||
+      fn->numFormals()     != 1    ||
+      isClass(fn->getFormal(1)->type) == false) {
+    return false;
+  }
+
+  return fn->name == astr("chpl__delete") || fn->name == astr("_freeIterator");
+}
+
+// Functions whose body cannot be followed
+static bool isOpaque(FnSymbol* fn) {
+  return fn->hasFlag(FLAG_EXTERN)                    ||
+         fn->hasFlag(FLAG_ON_BLOCK)                  ||
+         fn->hasFlag(FLAG_BEGIN_BLOCK)               ||
+         fn->hasFlag(FLAG_COBEGIN_OR_COFORALL_BLOCK) ||
+         fn->hasFlag(FLAG_LOCAL_ON)                  ||
+         isTaskFun(fn)                               ||
+         fn->body                      == NULL;
+}
+
+// An inline copy of 'fn' that allocates its instance on the stack
+static FnSymbol* stackClone(FnSymbol* fn) {
+  std::map<FnSymbol*, FnSymbol*>::iterator it = stackClones.find(fn);
+
+  if (it != stackClones.end()) {
+    return it->second;
+  }
+
+  FnSymbol* clone = fn->copy();
+
+  clone->addFlag(FLAG_INLINE);
+  clone->cname = astr(fn->cname, "_stack");
+
+  fn->defPoint->insertBefore(new DefExpr(clone));
+
+  CallExpr*            alloc    = findAllocation(clone);
+  CallExpr*            castMove = toCallExpr(alloc->next);
+  CallExpr*            cast     = toCallExpr(castMove->get(2));
+  Symbol*              tmp      = toSymExpr(alloc->get(1))->symbol();
+  Type*                at       = cast->get(1)->typeInfo();
+  std::vector<Symbol*> sizes;
+
+  SET_LINENO(cast);
+
+  cast->replace(new CallExpr(PRIM_STACK_ALLOCATE_CLASS, at->symbol));
+
+  for_actuals(actual, toCallExpr(alloc->get(2))) {
+    if (SymExpr* se = toSymExpr(actual)) {
+      if (isVarSymbol(se->symbol()) &&
+          se->symbol()->defPoint->parentSymbol == clone) {
+        sizes.push_back(se->symbol());
+      }
+    }
+  }
+
+  alloc->remove();
+  tmp->defPoint->remove();
+
+  // Remove the size computed for the allocation
+  for_vector(Symbol, size, sizes) {
+    SymExpr* def = size->getSingleDef();
+
+    if (size->isUsed() == false && def != NULL) {
+      def->getStmtExpr()->remove();
+      size->defPoint->remove();
+    }
+  }
+
+  stackClones[fn] = clone;
+
+  return clone;
+}
+
+// Replace 'delete x' by a call to the deinit() of 'at' and drop the free
+static void replaceFree(CallExpr* call, AggregateType* at) {
+  FnSymbol* dtor = at->getDestructor();
+  Expr*     arg  = call->get(1);
+
+  SET_LINENO(call);
+
+  if (call->resolvedFunction()->name == astr("chpl__delete") && dtor != NULL) {
+    if (arg->typeInfo() != at) {
+      VarSymbol* tmp  = newTemp("_stack_deinit_tmp_", at);
+      CallExpr*  cast = new CallExpr(PRIM_CAST, at->symbol, arg->remove());
+
+      call->insertBefore(new DefExpr(tmp));
+      call->insertBefore(new CallExpr(PRIM_MOVE, tmp, cast));
+
+      arg = new SymExpr(tmp);
+
+    } else {
+      arg->remove();
+    }
+
+    call->replace(new CallExpr(dtor, arg));
+
+  } else {
+    call->remove();
+  }
+}
@@ -96,6 +96,13 @@
 //
 // --------------------------------------------------
 //
+// Outside of local blocks, wide references that are known to be local are
+// narrowed in the same way, minus the runtime checks. This includes formals
+// of functions that are cloned for calls passing local data. See
+// inferLocality().
+//
+// --------------------------------------------------
+//
 // The "local field" pragma is also implemented in this pass. Instead of
 // widening the lhs of PRIM_GET_MEMBER_VALUE, we leave it narrow. Later
 // we'll insert some runtime checks and temporaries to make it all work.
@@ -163,6 +170,10 @@
 //   I (benharsh) think that duplicating some of these functions may result
 //   in fewer wide variables, at the cost of a larger code size.
 //
+//   inferLocality() now clones functions for calls that pass local actuals,
+//   but the formals of the clones keep their wide types and only their uses
+//   are narrowed.
+//
 // - Const global and const member forwarding
 //
 // - On-statements:
@@ -1639,13 +1650,16 @@ static void derefWideRefsToWideClasses()
 // addr field into a non-wide of otherwise the same type. Then, replace its
 // use with the non-wide version.
 //
-static void insertLocalTemp(Expr* expr) {
+// The check is omitted if 'checked' is false, which is only appropriate when
+// the compiler has proven that the wide reference is local.
+//
+static void insertLocalTemp(Expr* expr, bool checked = true) {
   SymExpr* se = toSymExpr(expr);
   Expr* stmt = expr->getStmtExpr();
   INT_ASSERT(se && stmt);
   SET_LINENO(se);
   VarSymbol* var = newTemp(astr("local_", se->symbol()->name), getNarrowType(se));
-  if (!fNoLocalChecks) {
+  if (checked && !fNoLocalChecks) {
     stmt->insertBefore(new CallExpr(PRIM_LOCAL_CHECK, se->copy(), buildCStringLiteral("cannot access remote data in local block")));
   }
   stmt->insertBefore(new DefExpr(var));
@@ -1842,6 +1856,433 @@ static void handleLocalBlocks() {
 }
 
 
+//
+// Locality inference
+//
+// A formal must be wide if any call passes it a wide actual, so calls that
+// pass local data pay for remote accesses anyway. For each call that passes
+// data known to be local to a wide formal, call a clone of the function in
+// which that formal is known to be local. Within a function, a wide class or
+// wide reference is known to be local if every definition of it comes from
+// something that is. Uses of such symbols that would communicate are then
+// narrowed, like in a local block but without a runtime check.
+//
+
+typedef std::vector<bool>                               LocalFormals;
+typedef std::queue<std::pair<FnSymbol*, LocalFormals> > LocalityQueue;
+
+static std::map<FnSymbol*, std::map<LocalFormals, FnSymbol*> > localArgsClones;
+static std::set<const char*> reportedLocality;
+static int numNarrowed = 0;
+static int numLocalArgsCalls = 0;
+
+//
+// Should this narrowing be reported?  Clones of a function share its
+// locations, so each one in user code is only reported once.
+//
+static bool reportLocality(BaseAST* ast, const char* what) {
+  if (fReportInferredLocality == false ||
+      (developer == false && printsUserLocation(ast) == false)) {
+    return false;
+  }
+
+  const char* key = astr(ast->fname(), istr(ast->linenum()), what);
+
+  return reportedLocality.insert(key).second;
+}
+
+//
+// Is 'sym' stored on the locale running the function that declares it?
+//
+static bool hasLocalStorage(Symbol* sym) {
+  return isVarSymbol(sym)                        &&
+         isFnSymbol(sym->defPoint->parentSymbol) &&
+         sym->hasFlag(FLAG_HEAP)   == false      &&
+         sym->hasFlag(FLAG_EXTERN) == false      &&
+         sym->isRefOrWideRef()     == false;
+}
+
+//
+// Is 'expr' a class instance or a reference known to be on this locale?
+//
+static bool isKnownLocal(Expr* expr, std::set<Symbol*>& local) {
+  SymExpr* se = toSymExpr(expr);
+
+  if (se == NULL) {
+    return false;
+  }
+
+  Symbol* sym = se->symbol();
+
+  if (local.count(sym) != 0 || sym == gNil) {
+    return true;
+  }
+
+  return isFullyWide(sym) == false &&
+         (isClass(sym->type) || sym->isRef());
+}
+
+//
+// Can a wide symbol be narrowed when it is known to be local?
+//
+static bool isLocalityCandidate(Symbol* sym) {
+  if (isFullyWide(sym) == false || sym->hasFlag(FLAG_HEAP)) {
+    return false;
+  }
+
+  return sym->isRefOrWideRef() || isClass(getNarrowType(sym).type());
+}
+
+//
+// Is 'rhs', the source of a definition of a class (or a reference if 'isRef')
+// known to be on this locale?
+//
+static bool isLocalSource(Expr* rhs, bool isRef, std::set<Symbol*>& local) {
+  if (isSymExpr(rhs)) {
+    return rhs->isRefOrWideRef() == isRef && isKnownLocal(rhs, local);
+  }
+
+  CallExpr* call = toCallExpr(rhs);
+
+  if (call == NULL) {
+    return false;
+  }
+
+  if (call->isPrimitive(PRIM_ADDR_OF) ||
+      call->isPrimitive(PRIM_SET_REFERENCE)) {
+    SymExpr* se = toSymExpr(call->get(1));
+
+    return isRef && se != NULL &&
+           (hasLocalStorage(se->symbol()) ||
+            (se->isRefOrWideRef() && isKnownLocal(se, local)));
+
+  } else if (call->isPrimitive(PRIM_GET_MEMBER) ||
+             call->isPrimitive(PRIM_GET_SVEC_MEMBER)) {
+    // A field is local if the instance, or the record, holding it is
+    SymExpr* base = toSymExpr(call->get(1));
+
+    return isRef && base != NULL &&
+           (isKnownLocal(base, local) ||
+            (hasLocalStorage(base->symbol()) &&
+             isClass(base->typeInfo()) == false &&
+             isFullyWide(base) == false));
+
+  } else if (call->isPrimitive(PRIM_CAST) ||
+             call->isPrimitive(PRIM_DYNAMIC_CAST)) {
+    return isRef == false && isLocalSource(call->get(2), false, local);
+
+  } else if (call->resolvedFunction() != NULL) {
+    // The result of a function returning a narrow class or reference
+    return call->isRefOrWideRef() == isRef &&
+           isFullyWide(call)      == false &&
+           (isRef || isClass(call->typeInfo()));
+  }
+
+  return false;
+}
+
+//
+// Is every definition of 'sym' known to be on this locale?
+//
+static bool hasOnlyLocalDefs(Symbol* sym, std::set<Symbol*>& local) {
+  bool isRef = sym->isRefOrWideRef();
+
+  for_SymbolSymExprs(se, sym) {
+    CallExpr* call = toCallExpr(se->parentExpr);
+
+    if (call == NULL) {
+      continue;
+    }
+
+    bool isFirstActual = call->get(1) == se;
+
+    if (isRef) {
+      // Only a move of another reference rebinds a reference, anything else
+      // stores through it
+      if (call->isPrimitive(PRIM_MOVE) && isFirstActual &&
+          call->get(2)->isRefOrWideRef()) {
+        if (isLocalSource(call->get(2), true, local) == false) {
+          return false;
+        }
+      }
+
+    } else if ((call->isPrimitive(PRIM_MOVE) ||
+                call->isPrimitive(PRIM_ASSIGN)) && isFirstActual) {
+      if (isLocalSource(call->get(2), false, local) == false) {
+        return false;
+      }
+
+    } else if (call->isPrimitive(PRIM_ADDR_OF)       ||
+               call->isPrimitive(PRIM_SET_REFERENCE) ||
+               (isDefAndOrUse(se) & 1) != 0) {
+      // Could be defined through a reference we can't follow
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//
+// Find the symbols in 'fn' that are known to be on this locale, assuming that
+// the formals in 'local' are.
+//
+static void inferLocalSymbols(FnSymbol* fn, std::set<Symbol*>& local) {
+  std::vector<DefExpr*> defs;
+
+  collectDefExprs(fn->body, defs);
+
+  for_vector(DefExpr, def, defs) {
+    if (isVarSymbol(def->sym) && isLocalityCandidate(def->sym)) {
+      local.insert(def->sym);
+    }
+  }
+
+  // Start by assuming that all of the candidates are local, and drop the
+  // ones with a definition that isn't until nothing changes. This allows
+  // for symbols that are defined from each other in loops.
+  bool changed = true;
+
+  while (changed) {
+    changed = false;
+
+    std::vector<Symbol*> syms(local.begin(), local.end());
+
+    for_vector(Symbol, sym, syms) {
+      if (hasOnlyLocalDefs(sym, local) == false) {
+        local.erase(sym);
+        changed = true;
+      }
+    }
+  }
+}
+
+//
+// Would this use of a wide symbol communicate?  These are the cases from
+// localizeCall() that narrow the use itself.
+//
+static bool isCommunicatingUse(SymExpr* se) {
+  CallExpr* call = toCallExpr(se->parentExpr);
+
+  if (call == NULL || call->get(1) != se) {
+    return false;
+  }
+
+  if (call->isPrimitive(PRIM_MOVE) || call->isPrimitive(PRIM_ASSIGN)) {
+    // A store through a wide reference
+    return se->isWideRef() && call->get(2)->isRefOrWideRef() == false;
+
+  } else if (call->isPrimitive(PRIM_SET_MEMBER)      ||
+             call->isPrimitive(PRIM_SET_SVEC_MEMBER) ||
+             call->isPrimitive(PRIM_ADD_ASSIGN)      ||
+             call->isPrimitive(PRIM_SUBTRACT_ASSIGN) ||
+             call->isPrimitive(PRIM_MULT_ASSIGN)     ||
+             call->isPrimitive(PRIM_DIV_ASSIGN)) {
+    return true;
+  }
+
+  CallExpr* move = toCallExpr(call->parentExpr);
+
+  if (move == NULL || move->get(2) != call ||
+      (move->isPrimitive(PRIM_MOVE)   == false &&
+       move->isPrimitive(PRIM_ASSIGN) == false)) {
+    return false;
+  }
+
+  if (call->isPrimitive(PRIM_GET_MEMBER)            ||
+      call->isPrimitive(PRIM_GET_SVEC_MEMBER)       ||
+      call->isPrimitive(PRIM_GET_MEMBER_VALUE)      ||
+      call->isPrimitive(PRIM_GET_SVEC_MEMBER_VALUE)) {
+    SymExpr* field = toSymExpr(call->get(2));
+
+    return field != NULL && field->symbol()->hasFlag(FLAG_SUPER_CLASS) == false;
+  }
+
+  return call->isPrimitive(PRIM_DEREF)  ||
+         call->isPrimitive(PRIM_TESTCID) ||
+         call->isPrimitive(PRIM_GETCID);
+}
+
+static void narrowLocalUses(Symbol* sym) {
+  std::vector<SymExpr*> uses;
+
+  for_SymbolSymExprs(se, sym) {
+    if (se->inTree() && isCommunicatingUse(se)) {
+      uses.push_back(se);
+    }
+  }
+
+  for_vector(SymExpr, se, uses) {
+    if (sym->hasFlag(FLAG_TEMP) == false && reportLocality(se, sym->name)) {
+      USR_PRINT(se, "Narrowed wide reference to '%s'", sym->name);
+      numNarrowed++;
+    }
+
+    insertLocalTemp(se, false);
+  }
+}
+
+static bool canCloneForLocalArgs(FnSymbol* fn) {
+  return fn->body                     != NULL  &&
+         fn->hasFlag(FLAG_EXTERN)     == false &&
+         fn->hasFlag(FLAG_EXPORT)     == false &&
+         fn->hasFlag(FLAG_LOCAL_ARGS) == false &&
+         fn->hasFlag(FLAG_ON_BLOCK)   == false &&
+         isTaskFun(fn)                == false;
+}
+
+//
+// Does a formal have a use that would benefit from knowing it is local?
+//
+static bool hasLocalizableUse(ArgSymbol* formal) {
+  for_SymbolSymExprs(se, formal) {
+    if (isCommunicatingUse(se)) {
+      return true;
+    }
+
+    if (CallExpr* call = toCallExpr(se->parentExpr)) {
+      if (call->isResolved() ||
+          (call->isPrimitive(PRIM_MOVE) && call->get(2) == se)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+//
+// Is 'actual' known to be on this locale when passed to 'formal'?
+//
+static bool isLocalActual(Expr* actual, ArgSymbol* formal,
+                          std::set<Symbol*>& local) {
+  if (actual->isRefOrWideRef() == formal->isRefOrWideRef()) {
+    return isKnownLocal(actual, local);
+  }
+
+  // A variable passed by reference
+  SymExpr* se = toSymExpr(actual);
+
+  return formal->isRefOrWideRef() && se != NULL &&
+         hasLocalStorage(se->symbol());
+}
+
+//
+// Call a clone of the callee if some wide formals are passed local actuals
+//
+static void callLocalArgsClone(CallExpr*          call,
+                               std::set<Symbol*>& local,
+                               LocalityQueue&     queue) {
+  FnSymbol*    fn = call->resolvedFunction();
+  LocalFormals localFormals(fn->numFormals(), false);
+  bool         any = false;
+
+  if (canCloneForLocalArgs(fn) == false) {
+    return;
+  }
+
+  int i = 0;
+
+  for_formals_actuals(formal, actual, call) {
+    if (isLocalityCandidate(formal)          &&
+        isLocalActual(actual, formal, local) &&
+        hasLocalizableUse(formal)) {
+      localFormals[i] = true;
+      any = true;
+    }
+
+    i++;
+  }
+
+  if (any == false) {
+    return;
+  }
+
+  std::map<LocalFormals, FnSymbol*>& clones = localArgsClones[fn];
+  FnSymbol* clone = clones[localFormals];
+
+  if (clone == NULL) {
+    SET_LINENO(fn);
+
+    clone = fn->copy();
+    clone->cname = astr("_local_args_", fn->cname);
+    fn->defPoint->insertBefore(new DefExpr(clone));
+
+    clones[localFormals] = clone;
+
+    // Recursive calls in the clone can use it too
+    localArgsClones[clone][localFormals] = clone;
+
+    queue.push(std::make_pair(clone, localFormals));
+  }
+
+  if (reportLocality(call, fn->name)) {
+    i = 0;
+
+    for_formals(formal, fn) {
+      if (localFormals[i++]) {
+        USR_PRINT(call, "Inferred that argument '%s' of %s is local",
+                  formal->name, fn->name);
+      }
+    }
+
+    numLocalArgsCalls++;
+  }
+
+  call->baseExpr->replace(new SymExpr(clone));
+}
+
+static void inferLocality() {
+  LocalityQueue queue;
+
+  forv_Vec(FnSymbol, fn, gFnSymbols) {
+    if (fn->inTree() && fn->body != NULL) {
+      queue.push(std::make_pair(fn, LocalFormals()));
+    }
+  }
+
+  while (queue.empty() == false) {
+    FnSymbol*    fn = queue.front().first;
+    LocalFormals localFormals = queue.front().second;
+    std::set<Symbol*> local;
+
+    queue.pop();
+
+    if (localFormals.size() != 0) {
+      int i = 0;
+
+      for_formals(formal, fn) {
+        if (localFormals[i++]) {
+          local.insert(formal);
+        }
+      }
+    }
+
+    inferLocalSymbols(fn, local);
+
+    for_set(Symbol, sym, local) {
+      narrowLocalUses(sym);
+    }
+
+    std::vector<CallExpr*> calls;
+
+    collectFnCalls(fn->body, calls);
+
+    for_vector(CallExpr, call, calls) {
+      callLocalArgsClone(call, local, queue);
+    }
+  }
+
+  if (fReportInferredLocality) {
+    printf("\tNarrowed %d wide references and redirected %d calls with "
+           "local arguments\n", numNarrowed, numLocalArgsCalls);
+  }
+
+  localArgsClones.clear();
+  reportedLocality.clear();
+}
+
+
 // Add symbols bearing the FLAG_HEAP flag to a list of heapVars.
 static void getHeapVars(std::vector<Symbol*>& heapVars)
 {
@@ -2525,6 +2966,10 @@ insertWideReferences(void) {
   insertWideCastTemps();
   derefWideRefsToWideClasses();
 
+  if (fNoInferLocality == false) {
+    inferLocality();
+  }
+
   handleLocalBlocks();
   heapAllocateGlobalsTail(heapAllocateGlobals, heapVars);
 
@@ -39,11 +39,13 @@
 #include "stlUtil.h"
 #include "stringutil.h"
 #include "tmpdirname.h"
+#include "version.h"
 
 #ifdef HAVE_LLVM
 #include "llvm/Support/FileSystem.h"
 #endif
 
+#include <dirent.h>
 #include <pwd.h>
 #include <unistd.h>
 
@@ -65,6 +67,9 @@ char saveCDir[FILENAME_MAX + 1]           = "";
 std::string ccflags;
 std::string ldflags;
 
+bool fProfileGenerate = false;
+char profileUseFile[FILENAME_MAX + 1] = "";
+
 std::vector<const char*>   incDirs;
 std::vector<const char*>   libDirs;
 std::vector<const char*>   libFiles;
@@ -610,6 +615,102 @@ const char* getIntermediateDirName() {
   return intDirName;
 }
 
+static bool isRawProfile(const char* filename) {
+  size_t len = strlen(filename);
+
+  return len > 8 && strcmp(filename + len - 8, ".profraw") == 0;
+}
+
+// The llvm-profdata that goes with the clang we compile with
+static std::string getLLVMProfdata() {
+  std::string clangDir;
+
+  if (0 == strcmp(CHPL_LLVM, "llvm")) {
+    clangDir  = CHPL_THIRD_PARTY;
+    clangDir += "/llvm/install/";
+    clangDir += CHPL_LLVM_UNIQ_CFG_PATH;
+    clangDir += "/bin";
+
+  } else if (0 == strcmp(CHPL_LLVM, "system")) {
+    std::string clangCC = get_clang_cc();
+
+    if (strchr(clangCC.c_str(), '/') != NULL) {
+      clangDir = getDirectory(clangCC.c_str());
+    }
+  }
+
+  return clangDir.empty() ? "llvm-profdata" : clangDir + "/llvm-profdata";
+}
+
+//
+// The indexed profile to optimize with for --profile-use.  The processes of
+// an instrumented program merge their counts into one raw profile, but there
+// can be several of them when LLVM_PROFILE_FILE contains %p or the locales
+// don't share a working directory.  If we were given a raw profile, or a
+// directory of them, merge them into an indexed profile in the intermediate
+// directory.
+//
+const char* getProfileUseFile() {
+  static const char* profile = NULL;
+
+  if (profile != NULL) {
+    return profile;
+  }
+
+  std::vector<std::string> rawProfiles;
+
+  if (DIR* dir = opendir(profileUseFile)) {
+    while (struct dirent* entry = readdir(dir)) {
+      if (isRawProfile(entry->d_name)) {
+        rawProfiles.push_back(std::string(profileUseFile) + "/" +
+                              entry->d_name);
+      }
+    }
+
+    closedir(dir);
+
+    if (rawProfiles.size() == 0) {
+      USR_FATAL("No raw profiles (*.profraw) found in '%s'", profileUseFile);
+    }
+
+  } else if (isRawProfile(profileUseFile)) {
+    rawProfiles.push_back(profileUseFile);
+  }
+
+  if (rawProfiles.size() == 0) {
+    profile = astr(profileUseFile);
+
+  } else {
+    const char* merged  = genIntermediateFilename("chpl.profdata");
+    std::string command = getLLVMProfdata() + " merge -o " + merged;
+
+    for (size_t i = 0; i < rawProfiles.size(); i++) {
+      command += " ";
+      command += rawProfiles[i];
+    }
+
+    mysystem(command.c_str(), "merging execution profiles");
+
+    profile = merged;
+  }
+
+  return profile;
+}
+
+// Back-end compiler flags for --profile-generate and --profile-use
+std::string getProfileFlags() {
+  std::string flags;
+
+  if (fProfileGenerate) {
+    flags = "-fprofile-generate";
+  } else if (profileUseFile[0] != '\0') {
+    flags  = "-fprofile-use=";
+    flags += getProfileUseFile();
+  }
+
+  return flags;
+}
+
 static void genCFiles(FILE* makefile) {
   int filenum = 0;
   int first = 1;
@@ -807,16 +908,20 @@ void codegen_makefile(fileinfo* mainfile, const char** tmpbinname,
     includedirs += dirName;
   }
 
+  std::string profileFlags = getProfileFlags();
+
   // Compiler flags for each deliverable.
   if (fLibraryCompile && !fMultiLocaleInterop && dyn) {
-    fprintf(makefile.fptr, "COMP_GEN_USER_CFLAGS = %s %s %s\n",
+    fprintf(makefile.fptr, "COMP_GEN_USER_CFLAGS = %s %s %s %s\n",
             "$(SHARED_LIB_CFLAGS)",
             includedirs.c_str(),
-            ccflags.c_str());
+            ccflags.c_str(),
+            profileFlags.c_str());
   } else {
-    fprintf(makefile.fptr, "COMP_GEN_USER_CFLAGS = %s %s\n",
+    fprintf(makefile.fptr, "COMP_GEN_USER_CFLAGS = %s %s %s\n",
             includedirs.c_str(),
-            ccflags.c_str());
+            ccflags.c_str(),
+            profileFlags.c_str());
   }
 
   // Linker flags for each deliverable.
@@ -838,8 +943,9 @@ void codegen_makefile(fileinfo* mainfile, const char** tmpbinname,
 
   fprintf(makefile.fptr, "COMP_GEN_LFLAGS = %s\n",
           lmode);
-  fprintf(makefile.fptr, "COMP_GEN_USER_LDFLAGS = %s\n",
-          ldflags.c_str());
+  fprintf(makefile.fptr, "COMP_GEN_USER_LDFLAGS = %s %s\n",
+          ldflags.c_str(),
+          profileFlags.c_str());
 
   // Block of code for generating TAGS command, developer convenience.
   fprintf(makefile.fptr, "TAGS_COMMAND = ");
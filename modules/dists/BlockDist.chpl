@@ -272,6 +272,27 @@ Parallelism within each locale is guided by the values of
 Updates to these values, if any, take effect only on the locale
 where the updates are made.
 
+**Pinned Remote Elements**
+
+For read-mostly phases that repeatedly read the same remote elements,
+a Block-distributed array can keep read-only copies of selected remote
+elements on the locale that reads them:
+
+  .. code-block:: chapel
+
+    coforall loc in Locales do on loc {
+      A.pinRemote(neighborInds); // a domain, range, array, or single index
+    }
+    forall i in A.domain do ... A[nbr(i)] ...; // served from local copies
+    A.refreshPinned();                         // after updating A
+
+``pinRemote()`` copies the requested elements owned by other locales to
+the calling locale.  Reads of those elements on that locale are then
+served locally, while writes still update the owning locale only.
+``refreshPinned()`` re-fetches all pinned elements on all locales in bulk,
+and ``unpinRemote()`` discards them.  Pinned elements are discarded when
+the array's domain is reassigned.
+
 **Sparse Subdomains**
 
 When a ``sparse subdomain`` is declared as a subdomain to a Block-distributed
@@ -406,6 +427,7 @@ class BlockArr: BaseRectangularArr {
 // stridable: generic array stridable parameter
 // locDom: reference to local domain class
 // myElems: a non-distributed array of local elements
+// pinCache: read-only copies of pinned remote elements (or nil)
 //
 class LocBlockArr {
   type eltType;
@@ -418,6 +440,7 @@ class LocBlockArr {
   // may be initialized separately
   var myElems: [locDom.myBlock] eltType;
   var locRADLock: chpl_LocalSpinlock;
+  var pinCache: unmanaged LocBlockPinCache(eltType, rank, idxType)?; // non-nil once pinRemote() is called here
 
   proc init(type eltType,
             param rank: int,
@@ -445,9 +468,26 @@ class LocBlockArr {
     // Here we need to clean up the rest of the array.
     if locRAD != nil then
       delete locRAD;
+    if pinCache != nil then
+      delete pinCache;
   }
 }
 
+//
+// Local cache of pinned remote elements
+//
+// inds: the pinned remote indices (never owned by this locale)
+// vals: a read-only copy of the elements at those indices as of the last
+//       call to pinRemote() or refreshPinned()
+//
+class LocBlockPinCache {
+  type eltType;
+  param rank: int;
+  type idxType;
+  var inds: domain(rank*idxType, parSafe=false);
+  var vals: [inds] eltType;
+}
+
 
 ////// Block and LocBlock methods ///////////////////////////////////////////
 
@@ -1073,6 +1113,45 @@ inline proc BlockArr.dsiAccess(const in idx: rank*idxType) ref {
   return nonLocalAccess(idx);
 }
 
+//
+// Read accesses additionally consult the pinned-element cache (see
+// pinRemote()) before falling back to the RAD / remote access path.
+// Writes always go through the 'ref' version above and bypass the cache.
+//
+inline proc BlockArr.dsiAccess(const in idx: rank*idxType)
+where shouldReturnRvalueByValue(eltType) {
+  local {
+    if myLocArr != nil {
+      const myLocArr = _to_nonnil(this.myLocArr);
+      if myLocArr.locDom.contains(idx) then
+        return myLocArr.this(idx);
+      if myLocArr.pinCache != nil {
+        const pinCache = _to_nonnil(myLocArr.pinCache);
+        if pinCache.inds.contains(idx) then
+          return pinCache.vals[idx];
+      }
+    }
+  }
+  return nonLocalAccess(idx);
+}
+
+inline proc BlockArr.dsiAccess(const in idx: rank*idxType) const ref
+where shouldReturnRvalueByConstRef(eltType) {
+  local {
+    if myLocArr != nil {
+      const myLocArr = _to_nonnil(this.myLocArr);
+      if myLocArr.locDom.contains(idx) then
+        return myLocArr.this(idx);
+      if myLocArr.pinCache != nil {
+        const pinCache = _to_nonnil(myLocArr.pinCache);
+        if pinCache.inds.contains(idx) then
+          return pinCache.vals[idx];
+      }
+    }
+  }
+  return nonLocalAccess(idx);
+}
+
 inline proc BlockArr.dsiBoundsCheck(i: rank*idxType) {
   return dom.dsiMember(i);
 }
@@ -1117,6 +1196,14 @@ proc BlockArr.nonLocalAccess(i: rank*idxType) ref {
 proc BlockArr.dsiAccess(i: idxType...rank) ref
   return dsiAccess(i);
 
+proc BlockArr.dsiAccess(i: idxType...rank)
+where shouldReturnRvalueByValue(eltType)
+  return dsiAccess(i);
+
+proc BlockArr.dsiAccess(i: idxType...rank) const ref
+where shouldReturnRvalueByConstRef(eltType)
+  return dsiAccess(i);
+
 pragma "order independent yielding loops"
 iter BlockArr.these() ref {
   for i in dom do
@@ -1154,6 +1241,19 @@ proc BlockArr.dsiDynamicFastFollowCheck(lead: domain) {
   return lead.dist.dsiEqualDMaps(this.dom.dist) && lead._value.whole == this.dom.whole;
 }
 
+//
+// When myElems has a single-loop fast follower (see DefaultRectangular),
+// the fast follower below uses it, so that zippered foralls over aligned
+// multidimensional Block arrays can be fused into one loop
+//
+proc BlockArr.flatFastFollower param {
+  // TODO: Remove once 'typeExpr.field' results in a type
+  var x : unmanaged LocBlockArr(eltType, rank, idxType, stridable)?;
+  type myElemsType = x!.myElems._value.type;
+  var y : myElemsType?;
+  return y!.dsiStaticFastFollowCheck(_to_borrowed(y!.dom.type));
+}
+
 pragma "order independent yielding loops"
 iter BlockArr.these(param tag: iterKind, followThis, param fast: bool = false) ref where tag == iterKind.follower {
   proc anyStridable(rangeTuple, param i: int = 0) param
@@ -1182,7 +1282,6 @@ iter BlockArr.these(param tag: iterKind, followThis, param fast: bool = false) r
     lowIdx(i) = myFollowThis(i).low;
   }
 
-  const myFollowThisDom = {(...myFollowThis)};
   if fast {
     //
     // TODO: The following is a buggy hack that will only work when we're
@@ -1199,15 +1298,34 @@ iter BlockArr.these(param tag: iterKind, followThis, param fast: bool = false) r
     if arrSection.locale.id != here.id then
       arrSection = _to_nonnil(myLocArr);
 
-    local {
-      const narrowArrSection = __primitive("_wide_get_addr", arrSection):arrSection.type?;
-      ref myElems = _to_nonnil(narrowArrSection).myElems;
-      for i in myFollowThisDom do yield myElems[i];
+    if flatFastFollower && !anyStridable(followThis) {
+      //
+      // Follow myElems with its single-loop fast follower, which also
+      // handles chunks that are not whole rows of myElems.  It reads the
+      // local data pointer once, so no local block is needed.
+      //
+      ref myElems = arrSection.myElems;
+      var localFollowThis: rank*range(idxType);
+      for param i in 0..rank-1 {
+        const low = myElems._value.dom.dsiDim(i).low;
+        localFollowThis(i) = myFollowThis(i).low-low..myFollowThis(i).high-low;
+      }
+      for e in myElems._value.these(iterKind.follower, localFollowThis,
+                                    fast=true) do
+        yield e;
+    } else {
+      const myFollowThisDom = {(...myFollowThis)};
+      local {
+        const narrowArrSection = __primitive("_wide_get_addr", arrSection):arrSection.type?;
+        ref myElems = _to_nonnil(narrowArrSection).myElems;
+        for i in myFollowThisDom do yield myElems[i];
+      }
     }
   } else {
     //
     // we don't necessarily own all the elements we're following
     //
+    const myFollowThisDom = {(...myFollowThis)};
     for i in myFollowThisDom {
       yield dsiAccess(i);
     }
@@ -1284,6 +1402,8 @@ override proc BlockArr.dsiReallocate(bounds:rank*range(idxType,BoundedRangeType.
 override proc BlockArr.dsiPostReallocate() {
   // Call this *after* the domain has been reallocated
   if doRADOpt then setupRADOpt();
+  // Pinned indices may have moved or disappeared
+  unpinRemote();
 }
 
 proc BlockArr.setRADOpt(val=true) {
@@ -1291,6 +1411,118 @@ proc BlockArr.setRADOpt(val=true) {
   if doRADOpt then setupRADOpt();
 }
 
+//
+// Pinned remote elements
+//
+// pinRemote(inds) copies the elements at the given indices (a domain, a
+// range, an array of indices, or a single index) that are owned by
+// other locales into a read-only cache on the calling locale.  Subsequent
+// reads of those elements on this locale are served from the cache without
+// communication, whereas writes still go to the owning locale and are not
+// reflected in any cache until refreshPinned() is called.
+//
+// refreshPinned() re-fetches every pinned element on every locale using one
+// on-statement per pair of locales, and unpinRemote() drops all caches.
+//
+// These calls must not run concurrently with accesses to the array.
+//
+proc BlockArr.pinRemote(inds) {
+  if this.myLocArr == nil then
+    halt("pinRemote() called on a locale that does not own part of the array");
+  const localArr = _to_nonnil(this.myLocArr);
+
+  if localArr.pinCache == nil then
+    localArr.pinCache = new unmanaged LocBlockPinCache(eltType, rank, idxType);
+  const pinCache = _to_nonnil(localArr.pinCache);
+
+  proc pinOne(i) {
+    const idx = chpl__tuplify(i);
+    if !localArr.locDom.contains(idx) && dom.dsiMember(idx) then
+      pinCache.inds.add(idx);
+  }
+
+  if isDomain(inds) || isArray(inds) || isRange(inds) {
+    for i in inds do pinOne(i);
+  } else {
+    pinOne(inds);
+  }
+
+  refreshPinnedHere();
+}
+
+proc BlockArr.refreshPinned() {
+  const thisPid = pid;
+  coforall locIdx in dom.dist.targetLocDom {
+    on dom.dist.targetLocales(locIdx) {
+      const arr = if _privatization then chpl_getPrivatizedCopy(this.type, thisPid) else this;
+      arr.refreshPinnedHere();
+    }
+  }
+}
+
+proc BlockArr.unpinRemote() {
+  coforall locIdx in dom.dist.targetLocDom {
+    on locArr(locIdx) {
+      const myLocArr = locArr(locIdx);
+      if myLocArr.pinCache != nil {
+        delete myLocArr.pinCache;
+        myLocArr.pinCache = nil;
+      }
+    }
+  }
+}
+
+//
+// Re-fetch the elements pinned on this locale.  The pinned indices are
+// bucketed by owning locale so that each owner is visited by a single
+// on-statement that gathers the requested elements into a contiguous buffer.
+//
+proc BlockArr.refreshPinnedHere() {
+  if myLocArr == nil || _to_nonnil(myLocArr).pinCache == nil then return;
+  const pinCache = _to_nonnil(_to_nonnil(myLocArr).pinCache);
+  const numPinned = pinCache.inds.size;
+  if numPinned == 0 then return;
+
+  const targetLocDom = dom.dist.targetLocDom;
+  var counts: [targetLocDom] int;
+  for idx in pinCache.inds do
+    counts[dom.dist.targetLocsIdx(idx)] += 1;
+
+  var offsets: [targetLocDom] int;
+  var off = 0;
+  for (o, c) in zip(offsets, counts) {
+    o = off;
+    off += c;
+  }
+
+  var pinnedInds: [0..#numPinned] rank*idxType;
+  var next = offsets;
+  for idx in pinCache.inds {
+    ref n = next[dom.dist.targetLocsIdx(idx)];
+    pinnedInds[n] = idx;
+    n += 1;
+  }
+
+  var pinnedVals: [0..#numPinned] eltType;
+  coforall locIdx in targetLocDom with (ref pinnedVals) {
+    const cnt = counts[locIdx];
+    if cnt > 0 {
+      const first = offsets[locIdx];
+      const ownerArr = locArr(locIdx);
+      on ownerArr {
+        const ownerInds: [0..#cnt] rank*idxType = pinnedInds[first..#cnt];
+        var ownerVals: [0..#cnt] eltType;
+        forall (v, i) in zip(ownerVals, ownerInds) do
+          v = ownerArr.myElems[i];
+        pinnedVals[first..#cnt] = ownerVals;
+      }
+    }
+  }
+
+  forall (i, v) in zip(pinnedInds, pinnedVals) do
+    pinCache.vals[i] = v;
+}
+
 //
 // the accessor for the local array -- assumes the index is local
 //
@@ -1545,6 +1777,7 @@ proc BlockArr.doiOptimizedSwap(other) {
       on locarr1 {
         locarr1.myElems <=> locarr2.myElems;
         locarr1.locRAD <=> locarr2.locRAD;
+        locarr1.pinCache <=> locarr2.pinCache;
       }
     }
     return true;
@@ -1668,6 +1901,28 @@ where !disableBlockDistBulkTransfer {
 
 override proc BlockArr.doiCanBulkTransferRankChange() param return true;
 
+//
+// bulkCommDistToDistTransfer() moves each chunk with a DefaultRectangular
+// bulk transfer on 'locArr[i].myElems', so that is what it requires
+//
+override proc BlockArr.doiCanBulkTransferDistToDist() param {
+  // TODO: Remove once 'typeExpr.field' results in a type
+  var x : unmanaged LocBlockArr(eltType, rank, idxType, stridable)?;
+  return chpl__isDROrDRView(x!.myElems);
+}
+
+// For assignments of the form: Block = <other distribution>, e.g. Cyclic.
+// Block = Block is handled by '_doSimpleBlockTransfer' above.
+proc BlockArr.doiBulkTransferFromKnown(destDom, srcClass, srcDom) : bool
+where chpl__canDoDistToDistTransfer(this, srcClass) &&
+      !disableBlockDistBulkTransfer {
+  if debugBlockDistBulkTransfer then
+    writeln("In BlockArr.doiBulkTransferFromKnown(", srcClass.type:string, ")");
+
+  bulkCommDistToDistTransfer(this, destDom, srcClass, srcDom);
+  return true;
+}
+
 config param debugBlockScan = false;
 
 proc BlockArr.doiScan(op, dom) where (rank == 1) &&
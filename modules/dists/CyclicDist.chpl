@@ -1250,6 +1250,19 @@ where useBulkTransferDist {
   return true;
 }
 
+override proc CyclicArr.doiCanBulkTransferDistToDist() param return true;
+
+// For assignments of the form: Cyclic = Cyclic or Cyclic = Block, and any
+// other distribution supported by 'bulkCommDistToDistTransfer'
+proc CyclicArr.doiBulkTransferFromKnown(destDom, srcClass, srcDom) : bool
+where chpl__canDoDistToDistTransfer(this, srcClass) {
+  if debugCyclicDistBulkTransfer then
+    writeln("In CyclicArr.doiBulkTransferFromKnown(", srcClass.type:string, ")");
+
+  bulkCommDistToDistTransfer(this, destDom, srcClass, srcDom);
+  return true;
+}
+
 proc CyclicArr.dsiTargetLocales() {
   return dom.dist.targetLocs;
 }
@@ -96,6 +96,11 @@ proc _computeNumChunks(maxTasks, ignoreRunning, minSize, numElems): int {
 
   type EC = uint; // type for element counts
   const unumElems = numElems:EC;
+
+  // Too few elements for creating tasks to pay off
+  if unumElems < dataParSerialThreshold:EC then
+    return 1;
+
   var numChunks = maxTasks:int;
   if !ignoreRunning {
     const otherTasks = here.runningTasks() - 1; // don't include self
@@ -618,3 +623,92 @@ proc bulkCommConvertCoordinate(ind, bView:domain, aView:domain)
   }
   return result;
 }
+
+//
+// Distribution-to-distribution bulk transfer planner
+//
+// The routines below copy 'Src[srcDom]' into 'Dest[destDom]' for any pair of
+// rectangular distributed arrays that return 'true' from
+// 'doiCanBulkTransferDistToDist()'.  Such arrays must store the elements
+// owned by target locale 'i' in 'locArr[i].myElems', a DefaultRectangular
+// array over 'dom.locDoms[i].myBlock', and their distribution must provide
+// 'targetLocDom' and 'dsiTargetLocales()'.
+//
+// For every destination locale we compute the indices it owns within
+// 'destDom', translate those into the index space of 'srcDom', and intersect
+// the result with the local block of each source locale.  Every non-empty
+// intersection is a single (possibly strided) rectangular chunk that is
+// moved with one DefaultRectangular bulk transfer, i.e. one strided GET per
+// pair of locales, instead of one remote access per element.
+//
+
+config param debugDistToDistBulkTransfer = false;
+config param disableDistToDistBulkTransfer = false;
+
+proc chpl__canDoDistToDistTransfer(Dest, Src) param : bool {
+  if disableDistToDistBulkTransfer || !useBulkTransfer then return false;
+
+  if Dest.doiCanBulkTransferDistToDist() == false ||
+     Src.doiCanBulkTransferDistToDist() == false then return false;
+
+  if Dest.eltType != Src.eltType then return false;
+
+  if Dest.rank != Src.rank &&
+     (Dest.doiCanBulkTransferRankChange() == false ||
+      Src.doiCanBulkTransferRankChange() == false) then return false;
+
+  return true;
+}
+
+//
+// Yields the indices in 'dist.targetLocDom' whose locales may own indices of
+// 'space'.  Distributions that can compute this cheaply (e.g. Block) provide
+// an 'activeTargetLocales' iterator; for the others we conservatively yield
+// every target locale and let the caller skip empty intersections.
+//
+iter bulkCommActiveTargetLocales(dist, space : domain) {
+  use Reflection;
+  if canResolveMethod(dist, "activeTargetLocales", space) {
+    for i in dist.activeTargetLocales(space) do yield i;
+  } else {
+    for i in dist.targetLocDom do yield i;
+  }
+}
+
+proc bulkCommDistToDistTransfer(Dest, destDom : domain, Src, srcDom : domain) {
+  if debugDistToDistBulkTransfer then
+    writeln("In DistToDist Bulk Transfer: Dest[", destDom, "] = Src[", srcDom, "]");
+
+  // Cache to avoid GETs
+  const DestPID = Dest.pid;
+  const SrcPID = Src.pid;
+  const destLocs = Dest.dom.dist.dsiTargetLocales();
+
+  coforall i in bulkCommActiveTargetLocales(Dest.dom.dist, destDom) {
+    on destLocs[i] {
+      // Relies on the fact that we privatize across all locales in the
+      // program, not just the targetLocales of Dest/Src.
+      const dst = if _privatization then chpl_getPrivatizedCopy(Dest.type, DestPID) else Dest;
+      const src = if _privatization then chpl_getPrivatizedCopy(Src.type, SrcPID) else Src;
+
+      const localDestBlock = dst.dom.locDoms[i].myBlock[destDom];
+      if localDestBlock.size > 0 {
+        const corSrcBlock = bulkCommTranslateDomain(localDestBlock, destDom, srcDom);
+        const dstElems = dst.locArr[i].myElems._value;
+
+        for srcLoc in bulkCommActiveTargetLocales(src.dom.dist, corSrcBlock) {
+          const localSrcChunk = corSrcBlock[src.dom.locDoms[srcLoc].myBlock];
+          if localSrcChunk.size == 0 then continue;
+
+          const localDestChunk = bulkCommTranslateDomain(localSrcChunk, corSrcBlock, localDestBlock);
+
+          if debugDistToDistBulkTransfer then
+            writeln("  Dest[", localDestChunk, "] = Src[", localSrcChunk, "]");
+
+          chpl__bulkTransferArray(dstElems, localDestChunk,
+                                  src.locArr[srcLoc].myElems._value, localSrcChunk);
+        }
+      }
+    }
+  }
+}
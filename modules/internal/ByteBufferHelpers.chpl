@@ -53,6 +53,36 @@ module ByteBufferHelpers {
     return CHPL_RT_MD_STR_COPY_REMOTE - chpl_memhook_md_num();
   }
 
+  //
+  // Strings and bytes up to CHPL_SHORT_STRING_SIZE bytes long are
+  // serialized with their data inline, so passing one to an on-statement
+  // does not require the receiving locale to GET the data from its owner.
+  //
+  pragma "no doc"
+  extern const CHPL_SHORT_STRING_SIZE : c_int;
+
+  pragma "no doc"
+  extern record chpl__inPlaceBuffer {};
+
+  pragma "fn synchronization free"
+  pragma "no doc"
+  extern proc chpl__getInPlaceBufferData(const ref data : chpl__inPlaceBuffer) : bufferType;
+
+  // Signal to the Chapel compiler that the actual argument may be modified.
+  pragma "fn synchronization free"
+  pragma "no doc"
+  extern proc chpl__getInPlaceBufferDataForWrite(ref data : chpl__inPlaceBuffer) : bufferType;
+
+  pragma "no doc"
+  record __serializeHelper {
+    var buffLen: int;
+    var buff: bufferType;
+    var size: int;
+    var locale_id: chpl_nodeID.type;
+    var shortData: chpl__inPlaceBuffer;
+    var cachedNumCodepoints: int;
+  }
+
   inline proc chpl_string_comm_get(dest: bufferType, src_loc_id: int(64),
                                    src_addr: bufferType, len: integral) {
     __primitive("chpl_comm_get", dest, src_loc_id, src_addr, len.safeCast(size_t));
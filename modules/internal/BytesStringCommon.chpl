@@ -98,6 +98,28 @@ module BytesStringCommon {
 
     if length == 0 then return "";
 
+    // Fast path: a buffer that is already valid UTF-8 decodes to a copy of
+    // itself under every policy, so validate it in bulk and copy it over
+    // rather than decoding one codepoint at a time.
+    {
+      extern const QIO_GLOCALE_UTF8: c_int;
+      extern var qio_glocale_utf8: c_int;
+      pragma "fn synchronization free"
+      extern proc chpl_enc_validate_buf_esc(buf: bufferType, buflen: ssize_t,
+                                            ref num_cp: int(64),
+                                            allow_escape: c_int): c_int;
+
+      var numCodepoints: int(64);
+      if qio_glocale_utf8 == QIO_GLOCALE_UTF8 &&
+         chpl_enc_validate_buf_esc(buff, length, numCodepoints, 0) == 0 {
+        var (newBuff, allocSize) = bufferCopyLocal(buff, length);
+        return chpl_createStringWithOwnedBufferNV(x=newBuff,
+                                                  length=length,
+                                                  size=allocSize,
+                                                  numCodepoints=numCodepoints);
+      }
+    }
+
     // allocate buffer the same size as this buffer assuming that the string
     // is in fact perfectly decodable. In the worst case, the user wants the
     // replacement policy and we grow the buffer couple of times.
@@ -399,7 +421,6 @@ module BytesStringCommon {
       }
 
       // find the byte range of the given codepoint range
-      var cpCount = 0;
       const cpIdxLow = if intR.hasLowBound() && intR.alignedLow:int >= 0
                           then intR.alignedLow:int
                           else 0;
@@ -411,18 +432,9 @@ module BytesStringCommon {
       var byteHigh = x.buffLen - 1;
 
       if cpIdxHigh >= 0 {
-        for (i, nBytes) in x._indexLen() {
-          if cpCount == cpIdxLow {
-            byteLow = i:int;
-            if !r.hasHighBound() then
-              break;
-          }
-          if cpCount == cpIdxHigh {
-            byteHigh = i:int + nBytes-1;
-            break;
-          }
-          cpCount += 1;
-        }
+        byteLow = x._cpToByteIndex(cpIdxLow);
+        if intR.hasHighBound() then
+          byteHigh = x._cpToByteIndex(cpIdxHigh+1) - 1;
       }
       return (byteLow..byteHigh, cpIdxHigh-cpIdxLow+1);
     }
@@ -913,7 +925,10 @@ module BytesStringCommon {
                    dst_off=lhs.buffLen);
       lhs.buffLen = newLength;
       lhs.buff[newLength] = 0;
-      if t == string then lhs.cachedNumCodepoints += rhs.cachedNumCodepoints;
+      if t == string {
+        lhs.cachedNumCodepoints += rhs.cachedNumCodepoints;
+        lhs._invalidateCpIndex();
+      }
     }
   }
 
@@ -951,7 +966,10 @@ module BytesStringCommon {
       }
 
       lhs.buffLen = buffLen;
-      if t==string then lhs.cachedNumCodepoints = numCodepoints;
+      if t==string {
+        lhs.cachedNumCodepoints = numCodepoints;
+        lhs._invalidateCpIndex();
+      }
   }
 
   proc reinitWithOwnedBuffer(ref lhs: ?t, buff: bufferType, buffLen: int,
@@ -976,7 +994,10 @@ module BytesStringCommon {
 
       lhs.isOwned = true;
       lhs.buffLen = buffLen;
-      if t==string then lhs.cachedNumCodepoints = numCodepoints;
+      if t==string {
+        lhs.cachedNumCodepoints = numCodepoints;
+        lhs._invalidateCpIndex();
+      }
   }
 
   proc doAssign(ref lhs: ?t, rhs: t) {
@@ -1208,15 +1229,10 @@ module BytesStringCommon {
   }
 
   proc countNumCodepoints(buff: bufferType, buffLen: int) {
-    var n = 0;
-    var i = 0;
-    while i < buffLen {
-      i += 1;
-      while i < buffLen && !isInitialByte(buff[i]) do
-        i += 1;
-      n += 1;
-    }
-    return n;
+    pragma "fn synchronization free"
+    extern proc chpl_enc_count_codepoints(buf: bufferType,
+                                          buflen: ssize_t): int(64);
+    return chpl_enc_count_codepoints(buff, buffLen): int;
   }
 
   /*
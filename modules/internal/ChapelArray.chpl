@@ -1642,13 +1642,31 @@ module ChapelArray {
     pragma "no doc"
     proc bulkAdd(inds: [] _value.idxType, dataSorted=false,
         isUnique=false, preserveInds=true, addOn=nilLocale)
-        where isSparseDom(this) && _value.rank==1 {
+        where isSparseDom(this) && rank==1 {
 
       if inds.size == 0 then return 0;
 
       return _value.dsiBulkAdd(inds, dataSorted, isUnique, preserveInds, addOn);
     }
 
+    pragma "no doc"
+    proc bulkAdd(inds: [] _value.idxType, dataSorted=false,
+        isUnique=false, preserveInds=true, addOn=nilLocale)
+        where isAssociativeDom(this) {
+
+      if inds.size == 0 then return 0;
+
+      // the hints only apply to sparse domains
+      if Reflection.canResolveMethod(_value, "dsiBulkAdd", inds) {
+        return _value.dsiBulkAdd(inds);
+      } else {
+        var numAdded = 0;
+        for i in inds do
+          numAdded += _value.dsiAdd(i);
+        return numAdded;
+      }
+    }
+
     /*
      Creates an index buffer which can be used for faster index addition.
 
@@ -1698,9 +1716,17 @@ module ChapelArray {
 
        .. note::
 
-         Right now, this method and the corresponding ``+=`` operator are
-         only available for sparse domains. In the future, we expect that
-         these methods will be available for all irregular domains.
+         Right now, this method is only available for sparse and associative
+         domains, and the corresponding ``+=`` operator only for sparse
+         domains. In the future, we expect that these methods will be
+         available for all irregular domains.
+
+       .. note::
+
+         For associative domains, the indices are added in parallel and the
+         ``dataSorted``, ``isUnique``, ``preserveInds`` and ``addOn``
+         arguments are ignored. Duplicate indices in ``inds`` are only added
+         once.
 
        .. note::
 
@@ -1729,9 +1755,9 @@ module ChapelArray {
        :returns: Number of indices added to the domain
        :rtype: int
     */
-    proc bulkAdd(inds: [] _value.rank*_value.idxType,
+    proc bulkAdd(inds: [] rank*_value.idxType,
         dataSorted=false, isUnique=false, preserveInds=true, addOn=nilLocale)
-        where isSparseDom(this) && _value.rank>1 {
+        where isSparseDom(this) && rank>1 {
 
       if inds.size == 0 then return 0;
 
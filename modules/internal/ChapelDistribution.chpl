@@ -786,6 +786,11 @@ module ChapelDistribution {
 
     proc doiCanBulkTransferRankChange() param return false;
 
+    // Distributions whose arrays store their local pieces as
+    // 'locArr[i].myElems' over 'dom.locDoms[i].myBlock' can opt in to the
+    // generic distribution-to-distribution transfer planner in DSIUtil.
+    proc doiCanBulkTransferDistToDist() param return false;
+
     proc decEltCountsIfNeeded() {
       // degenerate so it can be overridden
     }
@@ -517,6 +517,99 @@ module ChapelHashtable {
       }
     }
 
+    // #### parallel bulk insertion ####
+
+    // Adds 'keys' (and, unless 'vals' is 'none', the corresponding values)
+    // to the table using all available tasks and returns the number of keys
+    // that were not already present.  A key that is already present, or that
+    // occurs more than once in 'keys', keeps the first value stored for it.
+    //
+    // The table is sized for all of the keys up front, so no rehash happens
+    // while keys are inserted.  Tasks claim empty slots along each key's
+    // probe sequence with a compare-and-swap on a temporary per-slot state,
+    // and publish a slot once its key has been written.  A task that runs
+    // into a claimed slot waits for it to be published before comparing
+    // keys, so duplicate keys can never occupy two slots.
+    //
+    // If 'newSlotHandler' is not 'none', its 'bulkAddedSlot(slot)' method is
+    // called, possibly in parallel, for each newly filled slot.
+    //
+    // Assumes the table is locked by the caller.
+    proc bulkAdd(const ref keys: [] keyType, const ref vals,
+                 newSlotHandler): int {
+      const numKeys = keys.size;
+      if numKeys == 0 then return 0;
+
+      if (tableNumFullSlots + tableNumDeletedSlots + numKeys + 1)*2 > tableSize {
+        requestCapacity(tableNumFullSlots + numKeys);
+      }
+
+      param slotEmpty = 0:int(8),
+            slotClaimed = 1:int(8),
+            slotPublished = 2:int(8),
+            slotDeleted = 3:int(8);
+
+      var slotState: [0..#tableSize] chpl__processorAtomicType(int(8));
+      forall slot in 0..#tableSize {
+        select table[slot].status {
+          when chpl__hash_status.full do slotState[slot].write(slotPublished);
+          when chpl__hash_status.deleted do slotState[slot].write(slotDeleted);
+        }
+      }
+
+      // returns 1 if 'key' was added, 0 if it was already present
+      proc insertOne(const ref key: keyType, const ref val): int {
+        for slot in _lookForSlots(key) {
+          var state = slotState[slot].read();
+
+          if state == slotEmpty {
+            if slotState[slot].compareAndSwap(slotEmpty, slotClaimed) {
+              ref entry = table[slot];
+              _moveInit(entry.key, key);
+              if val.type != nothing then
+                _moveInit(entry.val, val);
+              entry.status = chpl__hash_status.full;
+              slotState[slot].write(slotPublished);
+
+              if newSlotHandler.type != nothing then
+                newSlotHandler.bulkAddedSlot(slot);
+              return 1;
+            }
+            state = slotState[slot].read();
+          }
+
+          if state == slotClaimed {
+            while slotState[slot].read() == slotClaimed do
+              chpl_task_yield();
+            state = slotPublished;
+          }
+
+          if state == slotPublished && table[slot].key == key then
+            return 0;
+
+          // a deleted slot or a different key - keep probing
+        }
+
+        halt("couldn't add key during bulk add -- ",
+             tableNumFullSlots, " / ", tableSize, " taken");
+        return 0;
+      }
+
+      var numAdded = 0;
+      if vals.type == nothing {
+        forall key in keys with (+ reduce numAdded) do
+          numAdded += insertOne(key, none);
+      } else {
+        if vals.size != numKeys then
+          halt("bulk add given ", numKeys, " keys but ", vals.size, " values");
+        forall (key, val) in zip(keys, vals) with (+ reduce numAdded) do
+          numAdded += insertOne(key, val);
+      }
+
+      tableNumFullSlots += numAdded;
+      return numAdded;
+    }
+
     // #### rehash / resize helpers ####
 
     proc _findPrimeSizeIndex(numKeys:int) {
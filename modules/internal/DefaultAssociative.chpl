@@ -356,6 +356,24 @@ module DefaultAssociative {
       }
     }
 
+    // adds the indices in 'inds' in parallel;
+    // returns the number of indices added
+    proc dsiBulkAdd(const ref inds: [] idxType): int {
+      var retVal = 0;
+
+      on this {
+        lockTable();
+        defer {
+          unlockTable();
+        }
+
+        retVal = table.bulkAdd(inds, none, new _bulkAddInitSlots(_to_unmanaged(this)));
+        numEntries.add(retVal);
+      }
+
+      return retVal;
+    }
+
     // returns the number of indices removed
     proc dsiRemove(idx: idxType) {
       var retval: int;
@@ -440,6 +458,18 @@ module DefaultAssociative {
 
   }
 
+  // Default initializes the elements of a domain's arrays as
+  // chpl__hashtable.bulkAdd fills new slots.
+  record _bulkAddInitSlots {
+    var dom;
+
+    proc bulkAddedSlot(slot: int) {
+      for arr in dom._arrs {
+        arr._defaultInitSlot(slot);
+      }
+    }
+  }
+
   class DefaultAssociativeArr: AbsBaseArr {
     type idxType;
     param parSafeDom: bool;
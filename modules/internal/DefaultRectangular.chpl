@@ -24,9 +24,11 @@ module DefaultRectangular {
   config const dataParTasksPerLocale = 0;
   config const dataParIgnoreRunningTasks = false;
   config const dataParMinGranularity: int = 1;
+  config const dataParSerialThreshold: int = 0;
 
   if dataParTasksPerLocale<0 then halt("dataParTasksPerLocale must be >= 0");
   if dataParMinGranularity<=0 then halt("dataParMinGranularity must be > 0");
+  if dataParSerialThreshold<0 then halt("dataParSerialThreshold must be >= 0");
 
   use DSIUtil;
   public use ChapelArray;
@@ -1181,22 +1183,98 @@ module DefaultRectangular {
         yield followThis;
     }
 
+    //
+    // The regular follower of a multidimensional array is a loop nest,
+    // which keeps a zippered forall (including one over a promoted
+    // expression) from being fused into a single loop.  When the arrays
+    // are aligned with the leader and each chunk it yields is a run of
+    // whole rows, the elements a follower visits are contiguous in
+    // memory, so the fast follower below walks them with a single loop.
+    //
+    override proc dsiStaticFastFollowCheck(type leadType) param {
+      if rank == 1 || stridable || localeModelHasSublocales ||
+         storageOrder != ArrayStorageOrder.RMO {
+        return false;
+      } else if isSubtype(leadType, DefaultRectangularArr) {
+        // TODO: Remove once 'typeExpr.field' results in a type
+        var x : leadType?;
+        return _to_borrowed(x!.dom.type) == _to_borrowed(this.dom.type);
+      } else {
+        return _to_borrowed(leadType) == _to_borrowed(this.dom.type);
+      }
+    }
+
+    proc dsiDynamicFastFollowCheck(lead: [])
+      return this.dsiDynamicFastFollowCheck(lead.domain);
+
+    proc dsiDynamicFastFollowCheck(lead: domain) {
+      const leadRanges = lead._value.ranges;
+      for param i in 0..rank-1 do
+        if leadRanges(i).size != dom.ranges(i).size then return false;
+
+      // The leader only splits the first dimension when it has at least
+      // as many indices as the leader can create tasks
+      const numTasks = if dataParTasksPerLocale == 0 then here.maxTaskPar
+                       else dataParTasksPerLocale;
+      return leadRanges(0).size >= numTasks;
+    }
+
     pragma "order independent yielding loops"
     iter these(param tag: iterKind, followThis,
                tasksPerLocale = dataParTasksPerLocale,
                ignoreRunning = dataParIgnoreRunningTasks,
-               minIndicesPerTask = dataParMinGranularity)
+               minIndicesPerTask = dataParMinGranularity,
+               param fast: bool = false)
       ref where tag == iterKind.follower {
       if debugDefaultDist {
         chpl_debug_writeln("*** In defRectArr simple-dd follower iterator: ",
                            followThis);
       }
 
-      for i in dom.these(tag=iterKind.follower, followThis,
-                         tasksPerLocale,
-                         ignoreRunning,
-                         minIndicesPerTask) do
-        yield dsiAccess(i);
+      if fast {
+        if chpl__testParFlag then
+          chpl__testPar("default rectangular array fast follower invoked on ",
+                        followThis);
+
+        // Visit followThis with a single loop so that zippered foralls can
+        // be fused.  When it is whole rows, which the dynamic fast-follow
+        // check ensures for a DefaultRectangular leader, its elements are
+        // contiguous; otherwise (e.g. a chunk of a Block array's local
+        // block) each index of the loop is spread over its shape.
+        var first: rank*idxType;
+        var numElems = 1:intIdxType;
+        var wholeRows = true;
+        for param i in 0..rank-1 {
+          first(i) = chpl__intToIdx(idxType,
+                                    dom.ranges(i)._low +
+                                    followThis(i).low:intIdxType);
+          numElems *= followThis(i).size:intIdxType;
+          if i > 0 && followThis(i).size != dom.ranges(i).size then
+            wholeRows = false;
+        }
+
+        const start = getDataIndex(first);
+        for k in 0..#numElems {
+          var i = start + k;
+          if !wholeRows {
+            var rem = k;
+            i = start;
+            for param d in 1..rank-1 by -1 {
+              const size = followThis(d).size:intIdxType;
+              i += (rem % size) * blk(d);
+              rem /= size;
+            }
+            i += rem * blk(0);
+          }
+          yield theData(i);
+        }
+      } else {
+        for i in dom.these(tag=iterKind.follower, followThis,
+                           tasksPerLocale,
+                           ignoreRunning,
+                           minIndicesPerTask) do
+          yield dsiAccess(i);
+      }
     }
 
     proc computeFactoredOffs() {
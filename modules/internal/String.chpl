@@ -198,32 +198,15 @@ module String {
   pragma "fn synchronization free"
   private extern proc qio_nbytes_char(chr:int(32)):c_int;
 
-  pragma "no doc"
-  extern const CHPL_SHORT_STRING_SIZE : c_int;
-
-  pragma "no doc"
-  extern record chpl__inPlaceBuffer {};
+  private config param debugStrings = false;
 
-  pragma "fn synchronization free"
+  // Non-ASCII strings with at least this many codepoints get a breadcrumb
+  // index for codepoint indexing and slicing.  0 disables the index.
   pragma "no doc"
-  extern proc chpl__getInPlaceBufferData(const ref data : chpl__inPlaceBuffer) : bufferType;
+  config param stringCodepointIndexThreshold = 256;
 
-  // Signal to the Chapel compiler that the actual argument may be modified.
   pragma "fn synchronization free"
-  pragma "no doc"
-  extern proc chpl__getInPlaceBufferDataForWrite(ref data : chpl__inPlaceBuffer) : bufferType;
-
-  private config param debugStrings = false;
-
-  pragma "no doc"
-  record __serializeHelper {
-    var buffLen: int;
-    var buff: bufferType;
-    var size: int;
-    var locale_id: chpl_nodeID.type;
-    var shortData: chpl__inPlaceBuffer;
-    var cachedNumCodepoints: int;
-  }
+  private extern proc chpl_string_free_cp_index(cpIndex: c_void_ptr);
 
   /*
      A value of type :record:`byteIndex` can be passed to certain
@@ -801,6 +784,9 @@ module String {
     var buff: bufferType = nil;
     var isOwned: bool = true;
     var hasEscapes: bool = false;
+    // Lazily built codepoint breadcrumbs for long non-ASCII strings; see
+    // _cpToByteIndex.  Owned by this record, not by the buffer.
+    var cpIndex: c_void_ptr = nil;
     // We use chpl_nodeID as a shortcut to get at here.id without actually constructing
     // a locale object. Used when determining if we should make a remote transfer.
     var locale_id = chpl_nodeID; // : chpl_nodeID_t
@@ -823,13 +809,62 @@ module String {
       // Checking for size here isn't sufficient. A string may have been
       // initialized from a c_string allocated from memory but beginning with
       // a null-terminator.
-      if isOwned && this.buff != nil {
+      if (isOwned && this.buff != nil) || this.cpIndex != nil {
         on __primitive("chpl_on_locale_num",
                        chpl_buildLocaleID(this.locale_id, c_sublocid_any)) {
-          chpl_here_free(this.buff);
+          if isOwned && this.buff != nil then
+            chpl_here_free(this.buff);
+          if this.cpIndex != nil then
+            chpl_string_free_cp_index(this.cpIndex);
         }
       }
     }
+
+    // Must be called whenever the contents of the string change.
+    inline proc ref _invalidateCpIndex() {
+      if this.cpIndex != nil {
+        chpl_string_free_cp_index(this.cpIndex);
+        this.cpIndex = nil;
+      }
+    }
+
+    /*
+      Returns the byte index of the `i` th codepoint, or the number of bytes
+      in the string if it has `i` or fewer codepoints.
+
+      Long non-ASCII strings build a breadcrumb index the first time they are
+      indexed by codepoint, so that this costs at most
+      ``CHPL_STRING_CP_INDEX_STRIDE`` steps rather than a walk from the start.
+    */
+    proc _cpToByteIndex(i: int): int {
+      // The index is built lazily, so it is stored through a const ref.
+      pragma "fn synchronization free"
+      extern proc chpl_string_cp_to_byte_offset(const ref cpIndex: c_void_ptr,
+                                                buf: bufferType, buflen: int,
+                                                numCp: int, cpIdx: int): int;
+
+      if this.isASCII() then
+        return min(i, this.buffLen);
+
+      // Only keep an index for strings whose record and buffer are both
+      // here, so that it is always freed on the locale it was built on.
+      if stringCodepointIndexThreshold > 0 &&
+         this.cachedNumCodepoints >= stringCodepointIndexThreshold &&
+         (_local || (this.locale_id == chpl_nodeID &&
+                     __primitive("_wide_get_node", this) == chpl_nodeID)) {
+        return chpl_string_cp_to_byte_offset(this.cpIndex, this.buff,
+                                             this.buffLen,
+                                             this.cachedNumCodepoints, i);
+      }
+
+      var cpCount = 0;
+      for (byteIdx, nBytes) in this._indexLen() {
+        if cpCount == i then
+          return byteIdx:int;
+        cpCount += 1;
+      }
+      return this.buffLen;
+    }
     
     proc chpl__serialize() {
       var data : chpl__inPlaceBuffer;
@@ -863,8 +898,11 @@ module String {
       }
     }
 
+    // The cached codepoint count doubles as an "is ASCII" flag. Read it
+    // directly rather than through numCodepoints, which recounts the
+    // codepoints when bounds checks are enabled.
     inline proc isASCII() {
-      return this.numCodepoints==this.numBytes;
+      return this.cachedNumCodepoints == this.buffLen;
     }
 
     inline proc byteIndices return 0..<this.numBytes;
@@ -874,25 +912,6 @@ module String {
     }
 
 
-    proc _cpIndexLenHelpNoAdjustment(ref start: int) {
-      const localThis: string = this.localize();
-      const i = start;
-
-      if localThis.isASCII() {
-        start += 1;
-        return (this.buff[i]:int(32), i:byteIndex, 1:int);
-
-      }
-      else {
-        const (decodeRet, cp, nBytes) = decodeHelp(buff=localThis.buff,
-                                                   buffLen=localThis.buffLen,
-                                                   offset=i,
-                                                   allowEsc=true);
-        start += nBytes;
-        return (cp:int(32), i:byteIndex, nBytes:int);
-      }
-    }
-
     /*
       Iterates over the string Unicode character by Unicode character,
       and includes the byte index and byte length of each character.
@@ -904,8 +923,20 @@ module String {
     iter _cpIndexLen(start = 0:byteIndex) {
       const localThis = this.localize();
       var i = _findStartOfNextCodepointFromByte(this, start);
-      while i < localThis.buffLen {
-        yield _cpIndexLenHelpNoAdjustment(i);  // this increments i
+      if localThis.isASCII() {
+        while i < localThis.buffLen {
+          yield (localThis.buff[i]:int(32), i:byteIndex, 1:int);
+          i += 1;
+        }
+      } else {
+        while i < localThis.buffLen {
+          const (decodeRet, cp, nBytes) = decodeHelp(buff=localThis.buff,
+                                                     buffLen=localThis.buffLen,
+                                                     offset=i,
+                                                     allowEsc=true);
+          yield (cp:int(32), i:byteIndex, nBytes:int);
+          i += nBytes;
+        }
       }
     }
 
@@ -1400,11 +1431,8 @@ module String {
   */
   pragma "not order independent yielding loops"
   iter string.codepoints(): int(32) {
-    const localThis = this.localize();
-    var i = 0;
-    while i < localThis.buffLen {
-      yield _cpIndexLenHelpNoAdjustment(i)[0];  // this increments i
-    }
+    for (cp, _, _) in this._cpIndexLen() do
+      yield cp;
   }
 
   /*
@@ -1470,12 +1498,9 @@ module String {
       return this.byte(i);
     }
     else {
-      var j = 0;
-      for cp in this.codepoints() {
-        if j == idx then
-          return cp;
-        j += 1;
-      }
+      const byteIdx = this._cpToByteIndex(idx);
+      for (cp, _, _) in this._cpIndexLen(byteIdx:byteIndex) do
+        return cp;
       // We have reached the end of the string without finding our index.
       if boundsChecking then
         halt("index ", idx, " out of bounds for string with length ", this.size);
@@ -1553,14 +1578,11 @@ module String {
       return chpl_createStringWithOwnedBufferNV(newBuff, 1, allocSize, 1);
     }
     else {
-      var charCount = 0;
-      for (cp, byteIdx, nBytes) in _cpIndexLen() {
-        if charCount == i {
-          var (newBuff, allocSize) = bufferCopy(buf=this.buff, off=byteIdx:int,
-                                                len=nBytes, loc=this.locale_id);
-          return chpl_createStringWithOwnedBufferNV(newBuff, nBytes, allocSize, 1);
-        }
-        charCount += 1;
+      const byteIdx = this._cpToByteIndex(i:int);
+      for (cp, _, nBytes) in _cpIndexLen(byteIdx:byteIndex) {
+        var (newBuff, allocSize) = bufferCopy(buf=this.buff, off=byteIdx,
+                                              len=nBytes, loc=this.locale_id);
+        return chpl_createStringWithOwnedBufferNV(newBuff, nBytes, allocSize, 1);
       }
       if boundsChecking then
         halt("index ", i:int, " out of bounds for string with length ", this.size);
@@ -18,8 +18,6 @@
  * limitations under the License.
  */
 
-import RangeChunk;
-
 pragma "no doc"
 /* Debug flag */
 config param debugCS = false;
@@ -215,21 +213,97 @@ class CSDom: BaseSparseDomImpl {
 
   iter these(param tag: iterKind) where tag == iterKind.leader {
     use DSIUtil;
-    // same as DefaultSparseDom's leader
     const numElems = _nnz;
     const numChunks = _computeNumChunks(numElems);
     if debugCS then
       writeln("CSDom leader: ", numChunks, " chunks, ", numElems, " elems");
 
-    // split our numElems elements over numChunks tasks
+    // split our numElems elements over numChunks tasks, keeping each row
+    // (or column) within a single chunk
     if numChunks == 1 then
       yield (this, 1, numElems);
     else
-      coforall chunk in RangeChunk.chunks(1..numElems, numChunks) do
-        yield (this, chunk.first, chunk.last);
-    // TODO: to handle large numElems and numChunks faster, it would be great
-    // to run the binary search in _private_findStart smarter, e.g.
-    // pass to the tasks created in 'coforall' smaller ranges to search over.
+      coforall majorChunk in nnzBalancedRanges(numChunks) {
+        const startIx = startIdx(majorChunk.low),
+              endIx = startIdx(majorChunk.high+1) - 1;
+        if startIx <= endIx then
+          yield (this, startIx, endIx);
+      }
+  }
+
+  /*
+    Split the compressed dimension (rows for CSR, columns for CSC) into at
+    most ``numChunks`` contiguous ranges that hold roughly the same number of
+    nonzeros.  A row (or column) is never split across two ranges.
+  */
+  proc nnzBalancedRanges(numChunks: int) {
+    const low = startIdxDom.low,
+          high = startIdxDom.high - 1;
+    const nChunks = max(1, min(numChunks, _nnz));
+
+    var bounds: [0..nChunks] idxType;
+    bounds[0] = low;
+    bounds[nChunks] = high + 1;
+    for c in 1..nChunks-1 {
+      // the row containing the first nonzero of chunk 'c'
+      const target = 1 + (_nnz * c) / nChunks;
+      var r = _private_findStart(target);
+      while startIdx(r+1) <= target do r += 1;
+      bounds[c] = max(bounds[c-1], r);
+    }
+
+    var ranges: [0..#nChunks] range(idxType);
+    for c in 0..#nChunks do
+      ranges[c] = bounds[c]..bounds[c+1]-1;
+    return ranges;
+  }
+
+  /* As above, using the default number of data-parallel tasks */
+  proc nnzBalancedRanges() {
+    use DSIUtil;
+    return nnzBalancedRanges(_computeNumChunks(_nnz));
+  }
+
+  /*
+    Replace the indices of this domain with a compressed representation that
+    has already been built, without sorting or deduplicating it.
+
+    ``startIdx`` must have one more element than the compressed dimension
+    and hold 1-based positions into ``idx`` in nondecreasing order.  ``idx``
+    holds the uncompressed index of each nonzero.  If the domain keeps its
+    indices sorted, the indices within each row (or column) must already be
+    in increasing order.
+  */
+  proc bulkLoad(const ref startIdx: [] idxType, const ref idx: [] idxType) {
+    if startIdx.size != startIdxDom.size then
+      halt("CSDom.bulkLoad: expected ", startIdxDom.size,
+           " start positions, got ", startIdx.size);
+
+    const nnz = startIdx[startIdx.domain.high] - 1;
+    if idx.size != nnz then
+      halt("CSDom.bulkLoad: expected ", nnz, " indices, got ", idx.size);
+
+    if boundsChecking {
+      const minorRange = if compressRows then colRange else rowRange;
+      for (lo, hi) in zip(startIdx[startIdx.domain.low..startIdx.domain.high-1],
+                          startIdx[startIdx.domain.low+1..]) {
+        if lo > hi then
+          halt("CSDom.bulkLoad: start positions are not nondecreasing");
+        for i in lo..hi-1 {
+          const ind = idx[idx.domain.low + i - 1];
+          if !minorRange.contains(ind) then
+            halt("CSDom.bulkLoad: index ", ind, " is out of bounds");
+          if sortedIndices && i > lo &&
+             idx[idx.domain.low + i - 2] >= ind then
+            halt("CSDom.bulkLoad: indices are not sorted and unique");
+        }
+      }
+    }
+
+    _nnz = nnz;
+    nnzDom = {1..nnz};
+    this.startIdx = startIdx;
+    this.idx = idx;
   }
 
   pragma "not order independent yielding loops"
@@ -0,0 +1,534 @@
+/*
+ * Copyright 2020 Hewlett Packard Enterprise Development LP
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+  This module contains the implementation of the concurrentMap type, a
+  map from keys to values that is designed to be used by many tasks at once.
+
+  A :record:`~Map.map` created with ``parSafe=true`` protects all of its
+  operations with a single lock, so tasks that use it from within a
+  ``forall`` loop take turns. A concurrentMap instead splits its keys across
+  ``numShards`` independent hash tables, each with its own lock. Operations on
+  keys that fall in different shards proceed in parallel, so the map scales
+  with the number of tasks as long as there are considerably more shards than
+  tasks.
+
+  .. code-block:: chapel
+
+    use ConcurrentMap;
+
+    var counts = new concurrentMap(string, int);
+    forall word in words do
+      counts.getAndAdd(word, 1);
+
+  Because another task may change or remove a value at any time, a
+  concurrentMap never returns references to its values. Values are returned
+  by copy, and read-modify-write operations that need to be atomic should use
+  :proc:`concurrentMap.update` or :proc:`concurrentMap.getAndAdd`.
+
+  The iterators and :proc:`concurrentMap.clear` visit one shard at a time
+  and are not atomic with respect to the map as a whole.  The iterators must
+  not be used while other tasks modify the map.
+*/
+module ConcurrentMap {
+  import ChapelLocks;
+  private use ChapelHashtable;
+  private use HaltWrappers;
+  private use IO;
+
+  /*
+    The number of shards used by a concurrentMap when none is specified.
+  */
+  config param concurrentMapDefaultShards = 128;
+
+  pragma "no doc"
+  type _lockType = ChapelLocks.chpl_LocalSpinlock;
+
+  // Each shard is its own class instance so that shard locks, which are
+  // constantly written, do not share cache lines with each other.
+  pragma "no doc"
+  class _MapShard {
+    type keyType;
+    type valType;
+
+    var lock$ = new _lockType();
+    var table: chpl__hashtable(keyType, valType);
+
+    inline proc lock() {
+      lock$.lock();
+    }
+
+    inline proc unlock() {
+      lock$.unlock();
+    }
+
+    // Removes every entry.  The caller must hold this shard's lock.
+    proc clearEntries() {
+      for slot in table.allSlots() {
+        if table.isSlotFull(slot) {
+          var key: keyType;
+          var val: valType;
+          table.clearSlot(slot, key, val);
+        }
+      }
+      table.maybeShrinkAfterRemove();
+    }
+
+    // Adds copies of the entries in 'other', which must hold different keys
+    // than this shard.  The caller must hold both shards' locks.
+    proc addEntriesFrom(other: borrowed _MapShard(keyType, valType)) {
+      for slot in other.table.allSlots() {
+        if other.table.isSlotFull(slot) {
+          ref entry = other.table.table[slot];
+          const (_, dstSlot) = table.findAvailableSlot(entry.key);
+          table.fillSlot(dstSlot, entry.key, entry.val);
+        }
+      }
+    }
+  }
+
+  record concurrentMap {
+    /* Type of map keys. */
+    type keyType;
+    /* Type of map values. */
+    type valType;
+
+    /* The number of independently locked shards the keys are divided
+       among. */
+    param numShards: int = concurrentMapDefaultShards;
+
+    pragma "no doc"
+    var _shards: [0..#numShards] unmanaged _MapShard(keyType, valType)?;
+
+    /*
+      Initializes an empty concurrentMap containing keys and values of given
+      types.
+
+      :arg keyType: The type of the keys of this map.
+      :arg valType: The type of the values of this map.
+      :arg numShards: The number of shards the keys are divided among.
+    */
+    proc init(type keyType, type valType,
+              param numShards: int = concurrentMapDefaultShards) {
+      if isGenericType(keyType) then
+        compilerError("concurrentMap key type cannot currently be generic");
+      if isGenericType(valType) then
+        compilerError("concurrentMap value type cannot currently be generic");
+      if numShards <= 0 then
+        compilerError("concurrentMap must have at least one shard");
+
+      this.keyType = keyType;
+      this.valType = valType;
+      this.numShards = numShards;
+
+      this.complete();
+
+      for shard in _shards do
+        shard = new unmanaged _MapShard(keyType, valType);
+    }
+
+    /*
+      Initializes a concurrentMap containing copies of the keys and values in
+      another concurrentMap.
+
+      :arg other: The map to initialize from.
+      :type other: concurrentMap
+    */
+    proc init=(const ref other: concurrentMap(?kt, ?vt, ?ns)) {
+      if !isCopyableType(kt) || !isCopyableType(vt) then
+        compilerError("initializing concurrentMap with non-copyable type");
+
+      this.keyType = kt;
+      this.valType = vt;
+      this.numShards = ns;
+
+      this.complete();
+
+      forall (shard, otherShard) in zip(_shards, other._shards) {
+        const src = otherShard!;
+        const dst = new unmanaged _MapShard(keyType, valType);
+        src.lock(); defer src.unlock();
+        dst.addEntriesFrom(src);
+        shard = dst;
+      }
+    }
+
+    pragma "no doc"
+    proc deinit() {
+      for shard in _shards do
+        delete shard;
+    }
+
+    pragma "no doc"
+    inline proc _shardFor(const ref k: keyType) {
+      // mix the high bits in so that shard selection does not only depend
+      // on the bits the hash table uses to pick a slot
+      const h = chpl__defaultHashWrapper(k):uint;
+      return _shards[((h ^ (h >> 32)) % numShards:uint):int]!;
+    }
+
+    /*
+      Removes all keys and values from this map.
+
+      Shards are cleared one at a time, so keys added concurrently may or may
+      not be removed.
+    */
+    proc clear() {
+      forall shard in _shards {
+        const s = shard!;
+        s.lock(); defer s.unlock();
+        s.clearEntries();
+      }
+    }
+
+    /*
+      The current number of keys contained in this map.
+
+      The shards are counted one at a time, so the result may not reflect
+      operations that happen while it is computed.
+    */
+    proc const size {
+      var result = 0;
+      for shard in _shards {
+        const s = shard!;
+        s.lock();
+        result += s.table.tableNumFullSlots;
+        s.unlock();
+      }
+      return result;
+    }
+
+    /*
+      Returns `true` if this map contains zero keys.
+    */
+    proc const isEmpty(): bool {
+      return size == 0;
+    }
+
+    /*
+      Returns `true` if the given key is a member of this map, and `false`
+      otherwise.
+
+      :arg k: The key to test for membership.
+      :type k: keyType
+    */
+    proc const contains(const k: keyType): bool {
+      const s = _shardFor(k);
+      s.lock(); defer s.unlock();
+      const (found, _) = s.table.findFullSlot(k);
+      return found;
+    }
+
+    /*
+      Returns a copy of the value mapped to the given key. Halts if the key
+      is not in the map.
+
+      :arg k: The key to look up.
+      :type k: keyType
+    */
+    proc const this(k: keyType): valType {
+      const s = _shardFor(k);
+      s.lock(); defer s.unlock();
+      const (found, slot) = s.table.findFullSlot(k);
+      if !found then
+        boundsCheckHalt("concurrentMap index " + k:string + " out of bounds");
+      const result = s.table.table[slot].val;
+      return result;
+    }
+
+    /*
+      Returns a copy of the value mapped to the given key, or `sentinel` if
+      the key is not in the map.
+
+      :arg k: The key to look up.
+      :type k: keyType
+
+      :arg sentinel: The value to return if `k` is not in the map.
+      :type sentinel: valType
+    */
+    proc const get(k: keyType, const sentinel: valType): valType {
+      const s = _shardFor(k);
+      s.lock(); defer s.unlock();
+      const (found, slot) = s.table.findFullSlot(k);
+      if !found then
+        return sentinel;
+      const result = s.table.table[slot].val;
+      return result;
+    }
+
+    /*
+      Adds a key-value pair to the map. Method returns `false` if the key
+      already exists in the map.
+
+      :returns: `true` if `k` was not in the map and added with value `v`.
+                `false` otherwise.
+      :rtype: bool
+    */
+    proc add(in k: keyType, in v: valType): bool {
+      const s = _shardFor(k);
+      s.lock(); defer s.unlock();
+      const (found, slot) = s.table.findAvailableSlot(k);
+      if found then
+        return false;
+      s.table.fillSlot(slot, k, v);
+      return true;
+    }
+
+    /*
+      Sets the value associated with a key. Method returns `false` if the key
+      does not exist in the map.
+
+      :returns: `true` if `k` was in the map and its value is updated with `v`.
+                `false` otherwise.
+      :rtype: bool
+    */
+    proc set(in k: keyType, in v: valType): bool {
+      const s = _shardFor(k);
+      s.lock(); defer s.unlock();
+      const (found, slot) = s.table.findFullSlot(k);
+      if !found then
+        return false;
+      s.table.fillSlot(slot, k, v);
+      return true;
+    }
+
+    /*
+      If the map doesn't contain a value at position `k` add one and
+      set it to `v`. If the map already contains a value at position
+      `k`, update it to the value `v`.
+    */
+    proc addOrSet(in k: keyType, in v: valType) {
+      const s = _shardFor(k);
+      s.lock(); defer s.unlock();
+      const (_, slot) = s.table.findAvailableSlot(k);
+      s.table.fillSlot(slot, k, v);
+    }
+
+    /*
+      Calls ``updater(k, v)``, where ``v`` is a reference to the value mapped
+      to `k`, while no other task can access `k`. If `k` is not in the map, a
+      default-initialized value is added for it first.
+
+      ``updater`` runs while the shard holding `k` is locked, so it must not
+      call methods on this map: doing so can deadlock.
+
+      :arg k: The key whose value should be updated.
+      :type k: keyType
+
+      :arg updater: A function object accepting the key and a ``ref`` to the
+                    value.
+
+      :returns: What ``updater`` returns.
+    */
+    proc update(in k: keyType, updater) {
+      if !isDefaultInitializable(valType) then
+        compilerError("concurrentMap.update requires a default ",
+                      "initializable value type");
+
+      const s = _shardFor(k);
+      s.lock(); defer s.unlock();
+      var (found, slot) = s.table.findAvailableSlot(k);
+      if !found {
+        var val: valType;
+        s.table.fillSlot(slot, k, val);
+      }
+      return updater(s.table.table[slot].key, s.table.table[slot].val);
+    }
+
+    /*
+      Atomically adds `x` to the value mapped to `k` and returns the value
+      it had before. If `k` is not in the map it is added with the value `x`,
+      and the default value of `valType` is returned.
+
+      :arg k: The key whose value should be incremented.
+      :type k: keyType
+
+      :arg x: The amount to add.
+      :type x: valType
+
+      :returns: The value mapped to `k` before `x` was added.
+      :rtype: valType
+    */
+    proc getAndAdd(in k: keyType, x: valType): valType {
+      const s = _shardFor(k);
+      s.lock(); defer s.unlock();
+      var (found, slot) = s.table.findAvailableSlot(k);
+      if !found {
+        var zero: valType;
+        s.table.fillSlot(slot, k, zero + x);
+        return zero;
+      }
+      ref val = s.table.table[slot].val;
+      const old = val;
+      val += x;
+      return old;
+    }
+
+    /*
+      Removes a key-value pair from the map, with the given key.
+
+      :arg k: The key to remove from the map
+
+      :returns: `false` if `k` was not in the map.  `true` if it was and
+                removed.
+      :rtype: bool
+    */
+    proc remove(k: keyType): bool {
+      const s = _shardFor(k);
+      s.lock(); defer s.unlock();
+      const (found, slot) = s.table.findFullSlot(k);
+      if !found then
+        return false;
+      var outKey: keyType, outVal: valType;
+      s.table.clearSlot(slot, outKey, outVal);
+      s.table.maybeShrinkAfterRemove();
+      return true;
+    }
+
+    /*
+      Iterates over the keys of this map. This is a shortcut for :iter:`keys`.
+    */
+    iter these() const ref {
+      for key in keys() do
+        yield key;
+    }
+
+    pragma "no doc"
+    iter these(param tag: iterKind) const ref
+      where tag == iterKind.standalone {
+      for key in keys(tag=tag) do
+        yield key;
+    }
+
+    /*
+      Iterates over the keys of this map.
+
+      :yields: A reference to one of the keys contained in this map.
+    */
+    iter keys() const ref {
+      for shard in _shards {
+        const s = shard!;
+        for slot in s.table.allSlots() do
+          if s.table.isSlotFull(slot) then
+            yield s.table.table[slot].key;
+      }
+    }
+
+    pragma "no doc"
+    iter keys(param tag: iterKind) const ref
+      where tag == iterKind.standalone {
+      forall shard in _shards {
+        const s = shard!;
+        for slot in s.table.allSlots() do
+          if s.table.isSlotFull(slot) then
+            yield s.table.table[slot].key;
+      }
+    }
+
+    /*
+      Iterates over the key-value pairs of this map.
+
+      :yields: A tuple of references to one of the key-value pairs contained
+               in this map.
+    */
+    iter items() const ref {
+      for shard in _shards {
+        const s = shard!;
+        for slot in s.table.allSlots() {
+          if s.table.isSlotFull(slot) {
+            ref entry = s.table.table[slot];
+            yield (entry.key, entry.val);
+          }
+        }
+      }
+    }
+
+    pragma "no doc"
+    iter items(param tag: iterKind) const ref
+      where tag == iterKind.standalone {
+      forall shard in _shards {
+        const s = shard!;
+        for slot in s.table.allSlots() {
+          if s.table.isSlotFull(slot) {
+            ref entry = s.table.table[slot];
+            yield (entry.key, entry.val);
+          }
+        }
+      }
+    }
+
+    /*
+      Writes the contents of this map to a channel. The format looks like:
+
+        .. code-block:: chapel
+
+           {k1: v1, k2: v2, .... , kn: vn}
+
+      :arg ch: A channel to write to.
+    */
+    proc writeThis(ch: channel) throws {
+      var first = true;
+      ch <~> "{";
+      for shard in _shards {
+        const s = shard!;
+        s.lock(); defer s.unlock();
+        for slot in s.table.allSlots() {
+          if s.table.isSlotFull(slot) {
+            if first then first = false;
+                     else ch <~> ", ";
+            ref entry = s.table.table[slot];
+            ch <~> entry.key <~> ": " <~> entry.val;
+          }
+        }
+      }
+      ch <~> "}";
+    }
+  }
+
+  /*
+    Replace the content of this map with the other's.
+
+    Shards are copied one at a time, so the assignment is not atomic with
+    respect to either map.
+
+    :arg lhs: The concurrentMap to assign to.
+    :arg rhs: The concurrentMap to assign from.
+  */
+  proc =(ref lhs: concurrentMap(?kt, ?vt, ?ns),
+         const ref rhs: concurrentMap(kt, vt, ns)) {
+    if !isCopyableType(kt) || !isCopyableType(vt) then
+      compilerError("assigning concurrentMap with non-copyable type");
+
+    // the shards already hold the same entries, and clearing them first
+    // would empty the map
+    if lhs._shards[0] == rhs._shards[0] then
+      return;
+
+    // Both maps have the same number of shards, so each key belongs to the
+    // same shard index in both
+    forall (shard, otherShard) in zip(lhs._shards, rhs._shards) {
+      const dst = shard!, src = otherShard!;
+      dst.lock(); defer dst.unlock();
+      src.lock(); defer src.unlock();
+      dst.clearEntries();
+      dst.addEntriesFrom(src);
+    }
+  }
+}
@@ -2208,6 +2208,41 @@ module Sparse {
     return ADom;
   }
 
+  /* Return a CSR domain over parent domain ``{rowSpace, colSpace}`` built
+     directly from its compressed representation, without sorting:
+
+    - ``indptr``: ``rowSpace.size+1`` 1-based positions into ``indices``,
+      where row ``i`` owns positions ``indptr[i]..indptr[i+1]-1``
+      (counting rows from the start of ``indptr``)
+    - ``indices``: column index of each non-zero
+
+    If ``sortedIndices`` is ``true``, the column indices of each row must
+    already be in increasing order.
+  */
+  proc CSRDomain(rowSpace: range, colSpace: range,
+                 indptr: [?indDom], indices: [?nnzDom],
+                 param sortedIndices = false)
+    where indDom.rank == 1 && nnzDom.rank == 1 {
+    const D = {rowSpace, colSpace};
+    var ADom: sparse subdomain(D) dmapped CS(sortedIndices=sortedIndices);
+    ADom._value.bulkLoad(indptr, indices);
+    return ADom;
+  }
+
+  /* Return a CSR matrix over parent domain ``{rowSpace, colSpace}`` built
+     directly from its compressed representation (see the ``CSRDomain``
+     overload above) and the value of each non-zero, ``data``.
+  */
+  proc CSRMatrix(rowSpace: range, colSpace: range,
+                 indptr: [?indDom], indices: [?nnzDom], data: [nnzDom] ?eltType,
+                 param sortedIndices = false)
+    where indDom.rank == 1 && nnzDom.rank == 1 {
+    var ADom = CSRDomain(rowSpace, colSpace, indptr, indices, sortedIndices);
+    var A: [ADom] eltType;
+    A.data = data;
+    return A;
+  }
+
   /*
       Generic matrix multiplication, ``A`` and ``B`` can be a scalar, dense
       vector, or sparse matrix.
@@ -2262,7 +2297,7 @@ module Sparse {
   }
 
 
-  /* CSR Matrix-vector multiplication */
+  /* CSR or CSC Matrix-vector multiplication */
   private proc _csrmatvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType,
                               trans=false) where isCSArr(A)
   {
@@ -2274,31 +2309,116 @@ module Sparse {
                     else {Adom.dim(0)};
     var Y: [Ydom] eltType;
 
-    if !trans {
-      if Adom.shape(1) != Xdom.shape(0) then
-        halt("Mismatched shape in matrix-vector multiplication");
-        // TODO: Loop over non-zero rows only
-        forall i in Adom.dim(0) {
-          for j in Adom.dimIter(1, i) {
-            Y[i] += A[i, j] * X[j];
-          }
+    param csr = Adom._value.compressRows;
+
+    if Adom.shape(if trans then 0 else 1) != Xdom.shape(0) then
+      halt("Mismatched shape in matrix-vector multiplication");
+
+    if trans == csr {
+      // X is indexed by the compressed dimension, so each of its elements
+      // scales one compressed row (or column) into Y
+      param c = if csr then 0 else 1;
+      ref X2 = X.reindex(Adom.dim(c));
+      const ref indPtr = Adom._value.startIdx,
+                indices = Adom._value.idx,
+                data = A._value.data;
+
+      forall rows in Adom._value.nnzBalancedRanges() with (+ reduce Y) {
+        for i in rows {
+          const xi = X2[i];
+          for k in indPtr[i]..indPtr[i+1]-1 do
+            Y[indices[k]] += data[k] * xi;
         }
+      }
+    } else if csr {
+      SpMV(A, X, Y);
     } else {
-      if Adom.shape(0) != Xdom.shape(0) then
-        halt("Mismatched shape in matrix-vector multiplication");
-
-      // Ensure same domain indices
+      // Y is indexed by the compressed dimension of a CSC matrix
       ref X2 = X.reindex(Adom.dim(0));
-
-      forall i in Adom.dim(0) with (+ reduce Y) {
-        for j in Adom.dimIter(1, i) {
-          Y[j] += A[i, j] * X2[i];
+      const ref indPtr = Adom._value.startIdx,
+                indices = Adom._value.idx,
+                data = A._value.data;
+
+      forall cols in Adom._value.nnzBalancedRanges() {
+        for j in cols {
+          var sum: eltType = 0;
+          for k in indPtr[j]..indPtr[j+1]-1 do
+            sum += data[k] * X2[indices[k]];
+          Y[j] = sum;
         }
       }
     }
     return Y;
   }
 
+  /* Sparse matrix-vector multiplication: ``Y = A * X``, where ``A`` is a CSR
+     matrix, ``X`` is indexed by the column indices of ``A``, and ``Y`` is
+     indexed by its row indices.
+
+     Rows are divided among tasks so that each task handles roughly the same
+     number of non-zeros, and each row is accumulated in a local variable.
+  */
+  proc SpMV(A: [?Adom] ?eltType, X: [?Xdom] eltType, ref Y: [?Ydom] eltType)
+    where isCSArr(A) {
+    if Adom.rank != 2 || Xdom.rank != 1 || Ydom.rank != 1 then
+      compilerError("Ranks are not 2, 1, and 1");
+    if !Adom._value.compressRows then
+      compilerError("SpMV requires a CSR (compressRows=true) matrix");
+    if Adom.shape(1) != Xdom.shape(0) || Adom.shape(0) != Ydom.shape(0) then
+      halt("Mismatched shape in matrix-vector multiplication");
+
+    const ref indPtr = Adom._value.startIdx,
+              indices = Adom._value.idx,
+              data = A._value.data;
+
+    forall rows in Adom._value.nnzBalancedRanges() {
+      for i in rows {
+        var sum: eltType = 0;
+        for k in indPtr[i]..indPtr[i+1]-1 do
+          sum += data[k] * X[indices[k]];
+        Y[i] = sum;
+      }
+    }
+  }
+
+  /* Sparse-dense matrix multiplication: ``C = A * B``, where ``A`` is a CSR
+     matrix and ``B`` and ``C`` are dense, row-major matrices.  The rows of
+     ``B`` are indexed by the column indices of ``A``, and the rows of ``C``
+     by the row indices of ``A``.
+
+     Each non-zero of ``A`` scales one contiguous row of ``B`` into the
+     matching row of ``C``, which keeps the innermost loop unit-stride.
+  */
+  proc SpMM(A: [?Adom] ?eltType, B: [?Bdom] eltType, ref C: [?Cdom] eltType)
+    where isCSArr(A) {
+    if Adom.rank != 2 || Bdom.rank != 2 || Cdom.rank != 2 then
+      compilerError("Ranks are not 2");
+    if !Adom._value.compressRows then
+      compilerError("SpMM requires a CSR (compressRows=true) matrix");
+    if Adom.shape(1) != Bdom.shape(0) || Adom.shape(0) != Cdom.shape(0) ||
+       Bdom.shape(1) != Cdom.shape(1) then
+      halt("Mismatched shape in matrix-matrix multiplication");
+
+    const ref indPtr = Adom._value.startIdx,
+              indices = Adom._value.idx,
+              data = A._value.data;
+    const cols = 0..#Bdom.shape(1),
+          bColLow = Bdom.dim(1).low,
+          cColLow = Cdom.dim(1).low;
+
+    forall rows in Adom._value.nnzBalancedRanges() {
+      for i in rows {
+        for j in cols do C[i, cColLow+j] = 0;
+        for k in indPtr[i]..indPtr[i+1]-1 {
+          const a = data[k],
+                row = indices[k];
+          for j in cols do
+            C[i, cColLow+j] += a * B[row, bColLow+j];
+        }
+      }
+    }
+  }
+
   pragma "no doc"
   /* Sparse matrix-matrix multiplication.
 
@@ -0,0 +1,211 @@
+/*
+ * Copyright 2020 Hewlett Packard Enterprise Development LP
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+  Arrays of records stored with each field in an array of its own.
+
+  A Chapel array of records stores each record contiguously. A loop that
+  only uses one field of a large record still moves the other fields
+  through the memory system, and it can't be vectorized because the values
+  it uses are not adjacent. A :class:`SoAArray` holds the same elements as
+  a struct of arrays. There is one array per field, and they are all
+  declared over the same domain. Since the field arrays are ordinary Chapel
+  arrays, the domain can be a default rectangular domain or a distributed
+  one, such as a ``Block`` domain.
+
+  .. code-block:: chapel
+
+    use StructOfArrays;
+
+    record Particle {
+      var x, vx: real;
+      var mass: real;
+    }
+
+    var P = new SoAArray(Particle, {1..n});
+
+    // Loops over field arrays reach the fields directly
+    forall (x, vx) in zip(P.field("x"), P.field("vx")) do
+      x += vx * dt;
+
+    // Indexing returns a reference to one element
+    P[1].field("mass") = 2.0;
+
+    var p = P[1].read();
+    P[2].write(p);
+
+  Indexing and iterating over an :class:`SoAArray` produce
+  :record:`soaRef` values. These stand in for references to the records.
+  They are a convenience; the field arrays are the fast path, especially
+  for distributed domains.
+
+  The element type must be a record with only ``var`` and ``const`` fields
+  whose type has a default value.
+*/
+module StructOfArrays {
+  use Reflection;
+
+  private proc fieldType(type eltType, param i: int) type {
+    var x: eltType;
+    return getField(x, i).type;
+  }
+
+  private proc makeFieldArrays(type eltType, dom: domain, param i = 0) {
+    var A: [dom] fieldType(eltType, i);
+
+    if i == numFields(eltType) - 1 then
+      return (A,);
+    else
+      return (A, (...makeFieldArrays(eltType, dom, i+1)));
+  }
+
+  /*
+    An array of records of type `eltType` over a rectangular domain, stored
+    with each field in an array of its own.
+  */
+  class SoAArray {
+    /* The type of the elements, a record */
+    type eltType;
+
+    pragma "no doc"
+    var fields;
+
+    /*
+      Create an array over `dom` with default initialized elements.
+
+      :arg eltType: the type of the elements
+      :arg dom: a rectangular domain
+    */
+    proc init(type eltType, dom: domain) {
+      if !isRecordType(eltType) then
+        compilerError("SoAArray requires a record element type, not ",
+                      eltType:string);
+      if numFields(eltType) == 0 then
+        compilerError("SoAArray requires a record with at least one field");
+      if !isRectangularDom(dom) then
+        compilerError("SoAArray requires a rectangular domain");
+
+      this.eltType = eltType;
+      this.fields = makeFieldArrays(eltType, dom);
+    }
+
+    /* The domain of the array */
+    proc indices return fields(0).domain;
+
+    /* The number of elements */
+    proc size return fields(0).size;
+
+    /*
+      The array holding the field named `name` of every element. Loops over
+      it access the field directly.
+    */
+    proc field(param name: string) ref {
+      if getFieldIndex(eltType, name) == -1 then
+        compilerError("SoAArray element type has no field named ", name);
+      return fields(getFieldIndex(eltType, name));
+    }
+
+    /* Return a reference to the element at `idx` */
+    proc this(idx...) {
+      if idx.size == 1 then
+        return new soaRef(_to_borrowed(this), idx(0));
+      else
+        return new soaRef(_to_borrowed(this), idx);
+    }
+
+    /* Yield a reference to each element */
+    iter these() {
+      for i in indices do
+        yield this(i);
+    }
+
+    pragma "no doc"
+    iter these(param tag: iterKind) where tag == iterKind.standalone {
+      forall i in indices do
+        yield this(i);
+    }
+
+    pragma "no doc"
+    iter these(param tag: iterKind) where tag == iterKind.leader {
+      for followThis in indices.these(tag) do
+        yield followThis;
+    }
+
+    pragma "no doc"
+    iter these(param tag: iterKind, followThis)
+      where tag == iterKind.follower {
+      for i in indices.these(tag, followThis) do
+        yield this(i);
+    }
+
+    pragma "no doc"
+    override proc writeThis(f) throws {
+      var first = true;
+
+      for e in these() {
+        if !first then
+          f <~> " ";
+        f <~> e.read();
+        first = false;
+      }
+    }
+  }
+
+  /*
+    A reference to one element of an :class:`SoAArray`. Its fields are
+    accessed with :proc:`field`, and the whole record is copied out or in
+    with :proc:`read` and :proc:`write`.
+  */
+  record soaRef {
+    pragma "no doc"
+    var arr;
+
+    pragma "no doc"
+    var idx;
+
+    /* A reference to the field named `name` of the element */
+    proc field(param name: string) ref {
+      if getFieldIndex(arr.eltType, name) == -1 then
+        compilerError("SoAArray element type has no field named ", name);
+      return arr.fields(getFieldIndex(arr.eltType, name))[idx];
+    }
+
+    /* Return a copy of the element */
+    proc read() {
+      var r: arr.eltType;
+
+      for param i in 0..<numFields(arr.eltType) do
+        getFieldRef(r, i) = arr.fields(i)[idx];
+
+      return r;
+    }
+
+    /* Replace the element with `r` */
+    proc write(r: arr.eltType) {
+      for param i in 0..<numFields(arr.eltType) do
+        arr.fields(i)[idx] = getField(r, i);
+    }
+
+    pragma "no doc"
+    proc writeThis(f) throws {
+      f <~> this.read();
+    }
+  }
+}
@@ -138,6 +138,27 @@
   was executed on locale 0, and a remote get and a remote put were
   executed on locale 1.
 
+  **Finding the Sources of Communication**
+
+  While counting is on, the operations initiated on each locale are
+  also tallied by the place in the program that triggered them.  For
+  every combination of operation kind (GET, PUT, or remote execution)
+  and source file and line, this records the number of operations,
+  the number of bytes moved, and the cumulative time spent in them::
+
+    startCommDiagnostics();
+    // ... code to study ...
+    stopCommDiagnostics();
+    // report the 10 places that moved the most data
+    printCommDiagnosticsBySite(10);
+
+  :proc:`getCommDiagnosticsBySite` and
+  :proc:`getCommDiagnosticsBySiteHere` return the same information as
+  arrays of :record:`commSiteDiagnostics`.  Non-blocking operations are
+  timed only until they have been initiated.  As with the counts
+  above, the per-site figures are reset by
+  :proc:`resetCommDiagnostics`.
+
   **Studying Communication During Module Initialization**
 
   It is hard for a programmer to determine exactly what happens during
@@ -185,6 +206,8 @@ module CommDiagnostics
    */
   config param commDiagsPrintUnstable = false;
 
+  private use SysCTypes;
+
   /* Aggregated communication operation counts.  This record type is
      defined in the same way by both the underlying comm layer(s) and
      this module, because we don't have a good way to inherit types back
@@ -285,6 +308,68 @@ module CommDiagnostics
 
   private extern proc chpl_comm_getDiagnosticsHere(out cd: commDiagnostics);
 
+  pragma "no doc"
+  extern record chpl_commSiteDiagnostics {
+    var kind: int(32);
+    var commID: int(32);
+    var lineno: int(32);
+    var filename: int(32);
+    var count: uint(64);
+    var numBytes: uint(64);
+    var time: uint(64);
+  };
+
+  private extern proc chpl_comm_getSiteDiagnosticsHere(
+                        sd: c_ptr(chpl_commSiteDiagnostics),
+                        max: size_t): size_t;
+
+  private extern proc chpl_lookupFilename(idx: int(32)): c_string;
+
+  /*
+    Communication operations of one kind initiated by one locale from
+    one place in the program, as returned by
+    :proc:`getCommDiagnosticsBySite`.
+   */
+  record commSiteDiagnostics {
+    /*
+      ID of the locale that initiated the operations
+     */
+    var localeId: int;
+    /*
+      ``"get"``, ``"put"``, or ``"execute_on"``.  Operations at call
+      sites that did not fit in the runtime's tables are reported
+      together with ``"other"``.
+     */
+    var op: string;
+    /*
+      source file that triggered the operations
+     */
+    var filename: string;
+    /*
+      source line that triggered the operations
+     */
+    var line: int;
+    /*
+      the compiler's ID for the communication point, or -1 for remote
+      executions
+     */
+    var commID: int;
+    /*
+      number of operations
+     */
+    var count: uint(64);
+    /*
+      number of bytes moved.  For remote executions, this is the size
+      of the arguments sent.
+     */
+    var numBytes: uint(64);
+    /*
+      cumulative time, in seconds, spent in the operations.  This is
+      unstable in the sense described for :param:`commDiagsPrintUnstable`.
+     */
+    var time: real;
+  }
+
   /*
     Start on-the-fly reporting of communication initiated on any locale.
    */
@@ -454,6 +539,136 @@ module CommDiagnostics
     }
   }
 
+  /*
+    Retrieve the per-site communication profile for this locale.
+
+    :returns: an entry for each kind of operation initiated from each
+              place in the program since counting was last reset
+    :rtype: `[] commSiteDiagnostics`
+   */
+  proc getCommDiagnosticsBySiteHere() {
+    // More sites may be seen while we are gathering them, so retry
+    // until the buffer is big enough.
+    var n = chpl_comm_getSiteDiagnosticsHere(nil, 0);
+    var rawD = {0..<n:int};
+    var raw: [rawD] chpl_commSiteDiagnostics;
+    var m = n;
+    while n > 0 {
+      m = chpl_comm_getSiteDiagnosticsHere(c_ptrTo(raw[0]), n);
+      if m <= n then break;
+      n = m;
+      rawD = {0..<n:int};
+    }
+
+    var sites: [0..<m:int] commSiteDiagnostics;
+    for (site, r) in zip(sites, raw[0..<m:int]) {
+      site.localeId = here.id;
+      select r.kind {
+        when 0 do site.op = "get";
+        when 1 do site.op = "put";
+        when 2 do site.op = "execute_on";
+        otherwise site.op = "other";
+      }
+      const filename = chpl_lookupFilename(r.filename);
+      site.filename = try! createStringWithNewBuffer(filename,
+                                                     filename.size);
+      site.line = r.lineno;
+      site.commID = r.commID;
+      site.count = r.count;
+      site.numBytes = r.numBytes;
+      site.time = r.time / 1e9;
+    }
+    return sites;
+  }
+
+  /*
+    Retrieve the per-site communication profile for the whole program.
+
+    :returns: the entries of :proc:`getCommDiagnosticsBySiteHere` for
+              every locale, sorted by decreasing number of bytes moved
+    :rtype: `[] commSiteDiagnostics`
+   */
+  proc getCommDiagnosticsBySite() {
+    // Each locale's entries are already in order, so merge them in.
+    // This module is used by the internal modules, so it must not
+    // depend on List or Sort.
+    var sitesD = {0..<0};
+    var sites: [sitesD] commSiteDiagnostics;
+    for loc in Locales {
+      var locD = {0..<0};
+      var locSites: [locD] commSiteDiagnostics;
+      on loc {
+        const hereSites = getCommDiagnosticsBySiteHere();
+        locD = hereSites.domain;
+        locSites = hereSites;
+      }
+      if locSites.size == 0 then continue;
+      const prev = sites;
+      sitesD = {0..<prev.size + locSites.size};
+      var i = 0, j = 0;
+      for s in sites {
+        if j == locSites.size ||
+           (i < prev.size && !before(locSites[j], prev[i])) {
+          s = prev[i];
+          i += 1;
+        } else {
+          s = locSites[j];
+          j += 1;
+        }
+      }
+    }
+    return sites;
+
+    proc before(a: commSiteDiagnostics, b: commSiteDiagnostics) {
+      return a.numBytes > b.numBytes ||
+             (a.numBytes == b.numBytes && a.count > b.count);
+    }
+  }
+
+  /*
+    Print the per-site communication profile in a markdown table, one
+    row for each kind of operation initiated by each locale from each
+    place in the program, in decreasing order of bytes moved.
+
+    :arg top: print only this many rows, or all of them if it is
+              negative (defaults to 10)
+    :type top: `int`
+  */
+  proc printCommDiagnosticsBySite(top=10) {
+    param unstable = "unstable";
+
+    const sites = getCommDiagnosticsBySite();
+    const n = if top < 0 then sites.size else min(top, sites.size);
+
+    proc location(s) return s.filename + ":" + s.line:string;
+    proc timeStr(s) return if commDiagsPrintUnstable
+                           then "%.6dr".format(s.time) else unstable;
+
+    var opWidth = "op".size, locWidth = "location".size,
+        countWidth = "count".size, bytesWidth = "bytes".size,
+        timeWidth = "time (s)".size;
+    for s in sites[0..<n] {
+      opWidth = max(opWidth, s.op.size);
+      locWidth = max(locWidth, location(s).size);
+      countWidth = max(countWidth, (s.count:string).size);
+      bytesWidth = max(bytesWidth, (s.numBytes:string).size);
+      timeWidth = max(timeWidth, timeStr(s).size);
+    }
+
+    writef("| %6s | %-*s | %-*s | %*s | %*s | %*s |\n", "locale",
+           opWidth, "op", locWidth, "location", countWidth, "count",
+           bytesWidth, "bytes", timeWidth, "time (s)");
+    writef("| -----: | :%.*s | :%.*s | %.*s: | %.*s: | %.*s: |\n",
+           opWidth-1, "-"*opWidth, locWidth-1, "-"*locWidth,
+           countWidth-1, "-"*countWidth, bytesWidth-1, "-"*bytesWidth,
+           timeWidth-1, "-"*timeWidth);
+    for s in sites[0..<n] {
+      writef("| %6i | %-*s | %-*s | %*u | %*u | %*s |\n", s.localeId,
+             opWidth, s.op, locWidth, location(s), countWidth, s.count,
+             bytesWidth, s.numBytes, timeWidth, timeStr(s));
+    }
+  }
+
   /*
     If this is set, on-the-fly reporting of communication operations
     will be turned on before any module initialization begins and
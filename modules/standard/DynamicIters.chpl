@@ -50,7 +50,8 @@ config param debugDynamicIters:bool=false;
 
   :arg numTasks: The number of tasks to use. Must be >= zero. If this argument
                  has the value 0, it will use the value indicated by
-                 ``dataParTasksPerLocale``.
+                 ``dataParTasksPerLocale``, or a single task if ``c`` has
+                 fewer indices than ``dataParSerialThreshold``.
   :type numTasks: `int`
 
   :yields: Indices in the range ``c``.
@@ -103,7 +104,7 @@ where tag == iterKind.leader
     numChunks = divceilpos(c.size:int(64), chunkSize): int;
 
   // Check if the number of tasks is 0, in that case it returns a default value
-  const nTasks = min(numChunks, defaultNumTasks(numTasks));
+  const nTasks = min(numChunks, defaultNumTasks(numTasks, c.size));
 
   type rType=c.type;
 
@@ -181,7 +182,8 @@ where tag == iterKind.follower
 
   :arg numTasks: The number of tasks to use. Must be >= zero. If this argument
                  has the value 0, it will use the value indicated by
-                 ``dataParTasksPerLocale``.
+                 ``dataParTasksPerLocale``, or a single task if ``c`` has
+                 fewer indices than ``dataParSerialThreshold``.
   :type numTasks: `int`
 
   :arg parDim: The index of the dimension to parallelize across. Must be >= 0.
@@ -224,7 +226,8 @@ iter dynamic(param tag:iterKind, c:domain, chunkSize:int=1, numTasks:int=0, parD
     var parDimDim = c.dim(parDim);
     var parDimOffset = c.dim(parDim).low;
 
-    for i in dynamic(tag=iterKind.leader, parDimDim, chunkSize, numTasks) {
+    for i in dynamic(tag=iterKind.leader, parDimDim, chunkSize,
+                     defaultNumTasks(numTasks, c.size)) {
       //Set the new range based on the tuple the dynamic 1d iterator yields
       var newRange = i(0);
 
@@ -261,7 +264,8 @@ where tag == iterKind.follower
 
   :arg numTasks: The number of tasks to use. Must be >= zero. If this argument
                  has the value 0, it will use the value indicated by
-                 ``dataParTasksPerLocale``.
+                 ``dataParTasksPerLocale``, or a single task if ``c`` has
+                 fewer indices than ``dataParSerialThreshold``.
   :type numTasks: `int`
 
   :yields: Indices in the range ``c``.
@@ -289,7 +293,7 @@ iter guided(param tag:iterKind, c:range(?), numTasks:int=0)
 where tag == iterKind.leader
 {
   // Check if the number of tasks is 0, in that case it returns a default value
-  const nTasks=min(c.size, defaultNumTasks(numTasks));
+  const nTasks=min(c.size, defaultNumTasks(numTasks, c.size));
   type rType=c.type;
   var remain:rType = densify(c,c);
   // If the number of tasks is insufficient, yield in serial
@@ -343,7 +347,8 @@ where tag == iterKind.follower
 
   :arg numTasks: The number of tasks to use. Must be >= zero. If this argument
                  has the value 0, it will use the value indicated by
-                 ``dataParTasksPerLocale``.
+                 ``dataParTasksPerLocale``, or a single task if ``c`` has
+                 fewer indices than ``dataParSerialThreshold``.
   :type numTasks: `int`
 
   :arg parDim: The index of the dimension to parallelize across. Must be >= 0.
@@ -386,7 +391,8 @@ where tag == iterKind.leader
 
   var parDimDim = c.dim(parDim);
 
-  for i in guided(tag=iterKind.leader, parDimDim, numTasks) {
+  for i in guided(tag=iterKind.leader, parDimDim,
+                  defaultNumTasks(numTasks, c.size)) {
     // Set the new range based on the tuple the guided 1-D iterator yields.
     var newRange = i(0);
 
@@ -423,7 +429,8 @@ where tag == iterKind.follower
 
   :arg numTasks: The number of tasks to use. Must be >= zero. If this argument
                  has the value 0, it will use the value indicated by
-                 ``dataParTasksPerLocale``.
+                 ``dataParTasksPerLocale``, or a single task if ``c`` has
+                 fewer indices than ``dataParSerialThreshold``.
   :type numTasks: `int`
 
   :yields: Indices in the range ``c``.
@@ -492,7 +499,7 @@ where tag == iterKind.leader
     compilerError("methodStealing value must be between 0 and 2");*/
 
   // Check if the number of tasks is 0, in that case it returns a default value
-  const nTasks=min(c.size, defaultNumTasks(numTasks));
+  const nTasks=min(c.size, defaultNumTasks(numTasks, c.size));
   type rType=c.type;
 
   // If the number of tasks is insufficient, yield in serial
@@ -632,7 +639,8 @@ where tag == iterKind.follower
 
   :arg numTasks: The number of tasks to use. Must be >= zero. If this argument
                  has the value 0, it will use the value indicated by
-                 ``dataParTasksPerLocale``.
+                 ``dataParTasksPerLocale``, or a single task if ``c`` has
+                 fewer indices than ``dataParSerialThreshold``.
   :type numTasks: `int`
 
   :arg parDim: The index of the dimension to parallelize across. Must be >= 0.
@@ -677,7 +685,8 @@ where tag == iterKind.leader
 
   var parDimDim = c.dim(parDim);
 
-  for i in adaptive(tag=iterKind.leader, parDimDim, numTasks) {
+  for i in adaptive(tag=iterKind.leader, parDimDim,
+                    defaultNumTasks(numTasks, c.size)) {
     // Set the new range based on the tuple the guided 1-D iterator yields.
     var newRange = i(0);
 
@@ -707,11 +716,13 @@ where tag == iterKind.follower
 }
 
 //************************* Helper functions
-private proc defaultNumTasks(nTasks:int)
+private proc defaultNumTasks(nTasks:int, numElems)
 {
   var dnTasks = nTasks;
   if nTasks <= 0  {
-    if dataParTasksPerLocale == 0 then
+    if numElems:uint < dataParSerialThreshold:uint then
+      dnTasks = 1;
+    else if dataParTasksPerLocale == 0 then
       dnTasks = here.maxTaskPar;
     else
       dnTasks = dataParTasksPerLocale;
@@ -35,6 +35,13 @@
   If a ``reverseComparator`` is passed to ``init``, 
   ``top`` will return the minimal element.
 
+  This module also provides :record:`arrayHeap`, which stores its elements
+  in a single contiguous buffer and has a configurable arity (4 by
+  default). Wider nodes make the tree shallower, so ``pop`` does fewer
+  levels of (cache-friendly) comparisons and ``push`` does fewer moves.
+  It also supports pushing and popping many elements while acquiring the
+  lock only once with ``pushMany`` and ``popMany``.
+
 */
 module Heap {
   import ChapelLocks;
@@ -427,4 +434,479 @@ module Heap {
     h._commonInitFromIterable(x);
     return h;
   }
+
+  /*
+    A heap that stores its elements in a single contiguous buffer, as an
+    implicit `arity`-ary tree. Node `i` has children ``arity*i+1`` through
+    ``arity*i+arity``.
+
+    It supports the same operations as :record:`heap` as well as
+    :proc:`arrayHeap.pushMany` and :proc:`arrayHeap.popMany`.
+  */
+  record arrayHeap {
+
+    /* The type of the elements contained in this heap. */
+    type eltType;
+
+    /* If `true`, this heap will perform parallel safe operations. */
+    param parSafe = false;
+
+    /* The number of children of each node in the heap. */
+    param arity = 4;
+
+    /*
+      Comparator record that defines how the
+      data is compared. The greatest element will be on the top.
+    */
+    var comparator: record;
+
+    pragma "no doc"
+    var _lock$ = if parSafe then new _LockWrapper() else none;
+
+    pragma "no doc"
+    var _data: _ddata(eltType) = nil;
+
+    pragma "no doc"
+    var _size = 0;
+
+    pragma "no doc"
+    var _capacity = 0;
+
+    pragma "no doc"
+    proc _checkArity() {
+      if arity < 2 then
+        compilerError("arrayHeap arity must be at least 2");
+    }
+
+    /*
+      Initializes an empty heap.
+
+      :arg eltType: The type of the elements
+
+      :arg parSafe: If `true`, this heap will use parallel safe operations.
+      :type parSafe: `param bool`
+
+      :arg arity: The number of children of each node
+      :type arity: `param int`
+
+      :arg comparator: The comparator to use
+    */
+    proc init(type eltType, param parSafe = false, param arity = 4,
+              comparator: record = defaultComparator) {
+      _checkType(eltType);
+      this.eltType = eltType;
+      this.parSafe = parSafe;
+      this.arity = arity;
+      this.comparator = comparator;
+      this.complete();
+      _checkArity();
+    }
+
+    /*
+      Initializes a heap containing elements that are copy initialized from
+      the elements contained in another heap.
+
+      :arg other: The heap to initialize from.
+    */
+    proc init=(other: arrayHeap(this.type.eltType, ?)) {
+      _checkType(this.type.eltType);
+      if !isCopyableType(this.type.eltType) then
+        compilerError("Cannot copy heap with element type that cannot be copied");
+
+      this.eltType = this.type.eltType;
+      this.parSafe = this.type.parSafe;
+      this.arity = this.type.arity;
+      this.comparator = other.comparator;
+      this.complete();
+      _checkArity();
+      _appendCopies(other, other._size);
+      _heapifyAll();
+    }
+
+    pragma "no doc"
+    proc deinit() {
+      _clear();
+      if _data != nil then
+        _ddata_free(_data, _capacity);
+    }
+
+    /*
+      Locks operations
+    */
+    pragma "no doc"
+    inline proc _enter() {
+      if parSafe then
+        _lock$.lock();
+    }
+
+    pragma "no doc"
+    inline proc _leave() {
+      if parSafe then
+        _lock$.unlock();
+    }
+
+    pragma "no doc"
+    pragma "unsafe"
+    inline proc _move(ref src: ?t, ref dst: t) lifetime src == dst {
+      __primitive("=", dst, src);
+    }
+
+    //
+    // Make room for at least n elements, moving the current elements
+    // into a new buffer if needed.
+    //
+    pragma "no doc"
+    proc _reserve(n: int) {
+      if n <= _capacity then return;
+      const newCapacity = max(n, 2 * _capacity, 16);
+      var newData = _ddata_allocate(eltType, newCapacity, initElts=false);
+      for i in 0..#_size do
+        _move(_data[i], newData[i]);
+      if _data != nil then
+        _ddata_free(_data, _capacity);
+      _data = newData;
+      _capacity = newCapacity;
+    }
+
+    pragma "no doc"
+    proc _clear() {
+      for i in 0..#_size do
+        chpl__autoDestroy(_data[i]);
+      _size = 0;
+    }
+
+    // Append copies of the n elements of iterable without restoring the
+    // heap property
+    pragma "no doc"
+    proc _appendCopies(iterable, n: int) {
+      _reserve(_size + n);
+      for e in iterable {
+        pragma "no auto destroy"
+        var cpy: eltType = e;
+        _move(cpy, _data[_size]);
+        _size += 1;
+      }
+    }
+
+    pragma "no doc"
+    inline proc _greater(const ref x: eltType, const ref y: eltType) {
+      return chpl_compare(x, y, comparator) > 0;
+    }
+
+    /*
+      Helper procedures to maintain the heap. Rather than swapping at each
+      level, they move the element being placed out of the buffer, shift
+      the elements it passes over into the hole, and move it into the hole
+      at the end.
+    */
+    pragma "no doc"
+    proc _siftUp(in pos: int) {
+      if pos == 0 then return;
+      pragma "no init"
+      pragma "no auto destroy"
+      var x: eltType;
+      _move(_data[pos], x);
+      while pos > 0 {
+        const parent = (pos - 1) / arity;
+        if !_greater(x, _data[parent]) then break;
+        _move(_data[parent], _data[pos]);
+        pos = parent;
+      }
+      _move(x, _data[pos]);
+    }
+
+    pragma "no doc"
+    proc _siftDown(in pos: int) {
+      pragma "no init"
+      pragma "no auto destroy"
+      var x: eltType;
+      _move(_data[pos], x);
+      while true {
+        const first = arity * pos + 1;
+        if first >= _size then break;
+        // find the greatest child
+        var best = first;
+        for c in first+1..min(first+arity, _size)-1 do
+          if _greater(_data[c], _data[best]) then best = c;
+        if !_greater(_data[best], x) then break;
+        _move(_data[best], _data[pos]);
+        pos = best;
+      }
+      _move(x, _data[pos]);
+    }
+
+    // Build the heap bottom-up in O(N)
+    pragma "no doc"
+    proc _heapifyAll() {
+      if _size < 2 then return;
+      for i in 0..(_size - 2) / arity by -1 do
+        _siftDown(i);
+    }
+
+    pragma "no doc"
+    proc _pushByRef(ref element: eltType) {
+      _reserve(_size + 1);
+      _move(element, _data[_size]);
+      _size += 1;
+      _siftUp(_size - 1);
+    }
+
+    pragma "no doc"
+    proc _pop(): eltType {
+      pragma "no init"
+      var result: eltType;
+      _move(_data[0], result);
+      _size -= 1;
+      if _size > 0 {
+        _move(_data[_size], _data[0]);
+        _siftDown(0);
+      }
+      return result;
+    }
+
+    //
+    // Push copies of the n elements of iterable. A batch that is large compared to the
+    // heap is appended and the whole heap is rebuilt in O(N) rather than
+    // pushing the elements one at a time in O(n lg N).
+    //
+    pragma "no doc"
+    proc _pushMany(iterable, n: int) {
+      if n > _size {
+        _appendCopies(iterable, n);
+        _heapifyAll();
+      } else {
+        _reserve(_size + n);
+        for e in iterable {
+          pragma "no auto destroy"
+          var cpy: eltType = e;
+          _pushByRef(cpy);
+        }
+      }
+    }
+
+    /*
+      Return the size of the heap.
+
+      :return: The size of the heap
+      :rtype: int
+    */
+    proc size: int {
+      _enter();
+      var result = _size;
+      _leave();
+      return result;
+    }
+
+    /*
+      Returns `true` if the heap is empty (has size == 0), `false` otherwise
+
+      :return: `true` if this heap is empty.
+      :rtype: `bool`
+    */
+    proc isEmpty(): bool {
+      _enter();
+      var result = _size == 0;
+      _leave();
+      return result;
+    }
+
+    /*
+      Return the top element in the heap.
+
+      :return: The top element in the heap
+      :rtype: `eltType`
+
+    */
+    proc top() {
+      if (isOwnedClass(eltType)) {
+        compilerError("top() method is not available on an 'arrayHeap'",
+                      " with elements of an owned type, here: ",
+                      eltType: string);
+      }
+      _enter();
+      if (boundsChecking && _size == 0) {
+        _leave();
+        boundsCheckHalt("Called \"arrayHeap.top\" on an empty heap.");
+      }
+      var result = _data[0];
+      _leave();
+      return result;
+    }
+
+    /*
+      Push an element into the heap.
+
+      :arg element: The element to push
+      :type element: `eltType`
+    */
+    proc push(pragma "no auto destroy" in element: eltType)
+    lifetime this < element {
+      _enter();
+      _pushByRef(element);
+      _leave();
+    }
+
+    /*
+      Push the elements in an array into the heap, acquiring the lock only
+      once. If there are more elements than are in the heap, the heap is
+      rebuilt in O(N) instead of pushing each element.
+
+      :arg x: The array of elements to push
+      :type x: `[?d] eltType`
+    */
+    proc pushMany(const ref x: [?d] eltType) {
+      _enter();
+      _pushMany(x, x.size);
+      _leave();
+    }
+
+    /*
+      Push the elements of a list into the heap, acquiring the lock only
+      once. If there are more elements than are in the heap, the heap is
+      rebuilt in O(N) instead of pushing each element.
+
+      :arg x: The list of elements to push
+      :type x: `list(eltType)`
+    */
+    proc pushMany(const ref x: list(eltType)) {
+      _enter();
+      _pushMany(x, x.size);
+      _leave();
+    }
+
+    /*
+      Pop an element and return it.
+
+      :return: the top element
+      :rtype: eltType
+    */
+    proc pop(): eltType {
+      _enter();
+      if (boundsChecking && _size == 0) {
+        _leave();
+        boundsCheckHalt("Called \"arrayHeap.pop\" on an empty heap.");
+      }
+      var ret = _pop();
+      _leave();
+      return ret;
+    }
+
+    /*
+      Pop the top `n` elements, acquiring the lock only once.
+
+      :arg n: The number of elements to pop
+      :return: An array of the popped elements in the order they were popped
+      :rtype: `[0..#n] eltType`
+    */
+    proc popMany(n: int): [] eltType {
+      if isNonNilableClass(eltType) && isOwnedClass(eltType) then
+        compilerError("popMany() method is not available on an 'arrayHeap'",
+                      " with elements of a non-nilable owned type, here: ",
+                      eltType:string);
+      _enter();
+      if (boundsChecking && (n < 0 || n > _size)) {
+        _leave();
+        boundsCheckHalt("Called \"arrayHeap.popMany\" with " + n:string +
+                        " elements on a heap of size " + _size:string + ".");
+      }
+      pragma "unsafe" var result: [0..#n] eltType;
+      for r in result do
+        r = _pop();
+      _leave();
+      return result;
+    }
+
+    /*
+      Iterate over the elements of this heap in in arbitrary order.
+    */
+    iter these() const ref {
+      for i in 0..#_size {
+        yield _data[i];
+      }
+    }
+
+    /*
+      Iterate over the elements of this heap in order,
+      while removing the yielded elements.
+    */
+    pragma "not order independent yielding loops"
+    iter consume() {
+      var h = this;
+      while !h.isEmpty() {
+        yield h.pop();
+      }
+    }
+
+    /*
+      Returns a new array containing a copy of each of the
+      elements contained in this heap in arbitrary order.
+
+      :return: A new array.
+    */
+    proc const toArray(): [] eltType {
+      if !isCopyableType(eltType) then
+        compilerError("toArray() method is not available on an 'arrayHeap'",
+                      " with elements of a type that can't be copied, here: ",
+                      eltType: string);
+      _enter();
+      pragma "unsafe" var result: [0..#_size] eltType;
+      for (r, i) in zip(result, 0..) do
+        r = _data[i];
+      _leave();
+      return result;
+    }
+
+    /*
+      Write the contents of this heap to a channel in arbitrary order.
+
+      :arg ch: A channel to write to.
+    */
+    proc writeThis(ch: channel) throws {
+      _enter();
+      ch <~> "[";
+      for i in 0..(_size - 2) do
+        ch <~> _data[i] <~> ", ";
+      if _size > 0 then
+        ch <~> _data[_size-1];
+      ch <~> "]";
+      _leave();
+    }
+  }
+
+  /*
+    Copy elements to this heap from another heap.
+
+    :arg lhs: The heap to assign to.
+    :arg rhs: The heap to assign from.
+  */
+  proc =(ref lhs: arrayHeap(?t, ?), const ref rhs: arrayHeap(t, ?)) {
+    // no two heaps share a buffer, so this is 'h = h', which clearing lhs
+    // would empty
+    if lhs._data != nil && lhs._data == rhs._data then
+      return;
+    lhs.comparator = rhs.comparator;
+    lhs._clear();
+    lhs._appendCopies(rhs, rhs._size);
+    lhs._heapifyAll();
+  }
+
+  /*
+    Create an :record:`arrayHeap` from an array in O(N).
+
+    :arg x: The array to initialize the heap from.
+    :type x: `[?d] ?t`
+
+    :arg parSafe: If `true`, the heap will use parallel safe operations.
+    :arg arity: The number of children of each node
+
+    :arg comparator: The comparator to use
+
+    :rtype: arrayHeap(t, parSafe, arity, comparator)
+  */
+  proc createArrayHeap(const ref x: [?d] ?t, param parSafe: bool = false,
+                       param arity = 4, comparator: record = defaultComparator) {
+    var h = new arrayHeap(t, parSafe, arity, comparator);
+    h.pushMany(x);
+    return h;
+  }
 }
@@ -7285,8 +7285,7 @@ iter channel.matches(re:regexp(?), param captures=0, maxmatches:int = max(int))
         m = _to_reMatch(matches[0]);
         if m.matched {
           for param i in 0..nret-1 {
-            m = _to_reMatch(matches[i]);
-            _extractMatch(m, ret[i], error);
+            _extractMatch(_to_reMatch(matches[i]), ret[i], error);
           }
           // Advance to the start of the match.
           qio_channel_revert_unlocked(_channel_internal);
@@ -7314,6 +7313,47 @@ iter channel.matches(re:regexp(?), param captures=0, maxmatches:int = max(int))
   if error then try! this._ch_ioerror(error, "in channel.matches");
 }
 
+/* Read a channel a line at a time, matching each line against all of the
+   patterns in a :record:`Regexp.regexpSet` at once. This is intended for
+   classifying the lines of a log or similar text against many patterns.
+
+   For each line that matches, yields the region of the line (not including
+   its trailing newline) together with the index of a pattern that matched.
+   A line that matches several patterns is yielded once per pattern, in
+   increasing pattern order.
+
+   Leaves the channel position after the last line read: at the end of the
+   channel, or after the line containing the last reported match if
+   `maxmatches` was reached.
+
+   :arg re: a :record:`Regexp.regexpSet` of the patterns to search for
+   :arg maxmatches: the maximum number of (line, pattern) pairs to report
+   :yields: tuples of a :record:`Regexp.reMatch` for the line and the index of
+            the matching pattern
+ */
+pragma "not order independent yielding loops"
+iter channel.matches(re:regexpSet(?), maxmatches:int = max(int))
+// TODO: should be throws
+{
+  var line:re.exprType;
+  var nmatches = 0;
+
+  while nmatches < maxmatches {
+    const lineStart = this.offset();
+    // TODO should be try not try!
+    if !(try! this.readline(line)) then break;
+
+    var len = line.numBytes;
+    if len > 0 && line.byte(len-1) == 0x0a then len -= 1;
+
+    for id in re._matchingPatterns(line, len) {
+      yield (new reMatch(true, lineStart:byteIndex, len), id);
+      nmatches += 1;
+      if nmatches >= maxmatches then break;
+    }
+  }
+}
+
 } /* end of FormattedIO module */
 
 public use FormattedIO;
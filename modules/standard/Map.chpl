@@ -497,6 +497,34 @@ module Map {
       return true;
     }
 
+    /*
+      Adds the key-value pairs formed by zipping ``keys`` and ``vals``
+      to the map, using multiple tasks. As with :proc:`add`, a key that
+      already exists in the map keeps its value, and if a key occurs more
+      than once in ``keys`` only one of its values is added.
+
+      This is much faster than calling :proc:`add` once per pair when
+      building a large map, because the map is resized at most once and the
+      pairs are inserted in parallel.
+
+     :arg keys: The keys to add to the map
+     :type keys: [] keyType
+
+     :arg vals: The values that map to the corresponding ``keys``
+     :type vals: [] valType
+
+     :returns: The number of keys that were not in the map and were added.
+     :rtype: int
+    */
+    proc bulkAdd(const ref keys: [] keyType, const ref vals: [] valType): int {
+      _enter(); defer _leave();
+      if keys.size != vals.size then
+        halt("map.bulkAdd called with ", keys.size, " keys but ",
+             vals.size, " values");
+
+      return table.bulkAdd(keys, vals, none);
+    }
+
 
     /*
       Sets the value associated with a key. Method returns `false` if the key
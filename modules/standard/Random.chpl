@@ -40,6 +40,11 @@
      * :proc:`permutation` creates a random permutation and stores it in an
        array.
 
+   Values from non-uniform distributions such as the normal, exponential,
+   Poisson, and binomial distributions are provided by the procedures in
+   :mod:`RandomDistributions`, which draw their uniform values from any of
+   these streams.
+
    In these and other methods, generated integer values are uniformly
    distributed from `min(T)` to `max(T)`, where `T` is the integral type and the
    boundaries are included. Generated floating point values are uniformly
@@ -52,6 +57,7 @@
 
      * :mod:`PCGRandom`
      * :mod:`NPBRandom`
+     * :mod:`PhiloxRandom`
 
    .. note::
 
@@ -64,17 +70,20 @@ module Random {
   public use RandomSupport;
   public use NPBRandom;
   public use PCGRandom;
+  public use PhiloxRandom;
+  public use RandomDistributions;
   import Set.set;
 
 
 
   /* Select between different supported RNG algorithms.
-     See :mod:`PCGRandom` and :mod:`NPBRandom` for details on
-     these algorithms.
+     See :mod:`PCGRandom`, :mod:`NPBRandom`, and :mod:`PhiloxRandom` for
+     details on these algorithms.
    */
   enum RNG {
     PCG = 1,
-    NPB = 2
+    NPB = 2,
+    PHILOX = 3
   }
 
   /* The default RNG. The current default is PCG - see :mod:`PCGRandom`. */
@@ -113,7 +122,8 @@ module Random {
     .. note::
 
       :mod:`NPBRandom` only supports `real(64)`, `imag(64)`, and `complex(128)`
-      numeric types. :mod:`PCGRandom` supports all primitive numeric types.
+      numeric types. :mod:`PCGRandom` and :mod:`PhiloxRandom` support all
+      primitive numeric types.
 
     :arg arr: The array to be filled, where T is a primitive numeric type
     :type arr: `[] T`
@@ -223,6 +233,10 @@ module Random {
       return new owned NPBRandomStream(seed=seed,
                                        parSafe=parSafe,
                                        eltType=eltType);
+    else if algorithm == RNG.PHILOX then
+      return new owned PhiloxRandomStream(seed=seed,
+                                          parSafe=parSafe,
+                                          eltType=eltType);
     else
       compilerError("Unknown random number generator");
   }
@@ -436,8 +450,8 @@ module Random {
 
     Models a stream of pseudorandom numbers.  This class is defined for
     documentation purposes and should not be instantiated. See
-    :mod:`PCGRandom` and :mod:`NPBRandom` for RNGs that can be
-    instantiated. To create a random stream, use :proc:`createRandomStream`.
+    :mod:`PCGRandom`, :mod:`NPBRandom`, and :mod:`PhiloxRandom` for RNGs
+    that can be instantiated. To create a random stream, use :proc:`createRandomStream`.
 
     .. note::
 
@@ -2879,4 +2893,1341 @@ module Random {
 
 
 
+  /*
+     Counter-based Philox RNG
+
+     The pseudorandom number generator implemented by this module is
+     Philox4x32-10 from `Parallel Random Numbers: As Easy as 1, 2, 3` by
+     J. K. Salmon, M. A. Moraes, R. O. Dror, and D. E. Shaw (SC11, see
+     http://www.thesalmons.org/john/random123/ ).
+
+     Philox is a counter-based RNG: the `n`-th value in a stream is computed
+     directly from the seed and `n` by a keyed bijection of the counter
+     rather than by stepping a state. That makes skipping around in the
+     stream as cheap as generating a value, and so each task filling part of
+     an array (including a distributed one) generates its values
+     independently without any communication or coordination beyond
+     agreeing on where in the stream the array starts. The value at a
+     particular position can also be computed without a stream at all with
+     :proc:`philoxRandom`.
+
+     The 64-bit seed is used as the 2x32-bit Philox key. Each 128-bit
+     Philox output block provides several consecutive values of the stream,
+     with block `b` computed from the counter `(b, 0)`:
+
+       * 8, 16, and 32-bit integers and `bool` use one 32-bit word each
+         (4 values per block), taking its high-order bits
+       * 64-bit integers use two 32-bit words each (2 values per block)
+       * `real(64)` is the high 53 bits of 64 random bits scaled into
+         [0, 1), and `real(32)` is the high 24 bits of a 32-bit word
+         scaled into [0, 1). Note that unlike :mod:`PCGRandom`, 1.0 is never
+         generated.
+       * `imag` is generated as the corresponding `real`
+       * `complex` uses two consecutive `real` values for the real and
+         imaginary parts, so `complex(128)` uses a whole block
+
+     This RNG has been shown to pass the TestU01 BigCrush suite by its
+     authors. It is not suitable for generating key material for encryption.
+
+     .. note::
+
+       This module does not currently support generating values within
+       bounds, :proc:`~RandomStreamInterface.choice`, or shuffling.
+
+  */
+  module PhiloxRandom {
+
+    use super.RandomSupport;
+    use ChapelLocks;
+
+    // Philox4x32 multipliers and Weyl sequence constants for the key
+    private param philoxM0 = 0xD2511F53:uint(32),
+                  philoxM1 = 0xCD9E8D57:uint(32),
+                  philoxW0 = 0x9E3779B9:uint(32),
+                  philoxW1 = 0xBB67AE85:uint(32);
+
+    /*
+      Models a stream of pseudorandom numbers generated by the Philox4x32-10
+      counter-based RNG. See the module-level notes for :mod:`PhiloxRandom`.
+    */
+    class PhiloxRandomStream {
+      /*
+        Specifies the type of value generated by the PhiloxRandomStream.
+        All numeric types are supported: `int`, `uint`, `real`, `imag`,
+        `complex`, and `bool` types of all sizes.
+      */
+      type eltType;
+
+      /*
+        The seed value for the PRNG. Any `int(64)` value can be used.
+      */
+      const seed: int(64);
+
+      /*
+        Indicates whether or not the PhiloxRandomStream needs to be
+        parallel-safe by default.  If multiple tasks interact with it in
+        an uncoordinated fashion, this must be set to `true`.  If it will
+        only be called from a single task, or if only one task will call
+        into it at a time, setting to `false` will reduce overhead related
+        to ensuring mutual exclusion.
+      */
+      param parSafe: bool = true;
+
+      /*
+        Creates a new stream of random numbers using the specified seed
+        and parallel safety.
+
+        :arg eltType: The element type to be generated.
+        :type eltType: `type`
+
+        :arg seed: The seed to use for the PRNG.  Defaults to
+          `currentTime` from :type:`RandomSupport.SeedGenerator`.
+          Can be any int(64) value.
+        :type seed: `int(64)`
+
+        :arg parSafe: The parallel safety setting.  Defaults to `true`.
+        :type parSafe: `bool`
+
+      */
+      proc init(type eltType,
+                seed: int(64) = SeedGenerator.currentTime,
+                param parSafe: bool = true) {
+        this.eltType = eltType;
+        this.seed = seed;
+        this.parSafe = parSafe;
+        this.complete();
+        if !isSupportedNumericType(eltType) then
+          compilerError("PhiloxRandomStream does not support eltType=",
+                        eltType:string);
+      }
+
+      pragma "no doc"
+      proc PhiloxRandomStreamPrivate_getNext_noLock(type resultType) {
+        const n = PhiloxRandomStreamPrivate_count;
+        PhiloxRandomStreamPrivate_count += 1;
+        return philoxRandom(resultType, seed, n);
+      }
+
+      /*
+        Returns the next value in the random stream.
+
+        Generated reals are in [0,1) - 0.0 is a possible value but 1.0 is
+        not.  Imaginary numbers are analogously in [0i, 1i).  Complex
+        numbers consist of a generated real and imaginary part.
+
+        Generated integers cover the full value range of the integer.
+
+        :arg resultType: the type of the result. Defaults to :type:`eltType`.
+        :returns: The next value in the random stream as type `resultType`.
+       */
+      proc getNext(type resultType=eltType): resultType {
+        _lock();
+        const result = PhiloxRandomStreamPrivate_getNext_noLock(resultType);
+        _unlock();
+        return result;
+      }
+
+      /*
+        Advances/rewinds the stream to the `n`-th value in the sequence.
+        The first value corresponds to n=0.  n must be >= 0, otherwise an
+        IllegalArgumentError is thrown.
+
+        :arg n: The position in the stream to skip to.  Must be >= 0.
+        :type n: `integral`
+
+        :throws IllegalArgumentError: When called with negative `n` value.
+       */
+      proc skipToNth(n: integral) throws {
+        if n < 0 then
+          throw new owned IllegalArgumentError("PhiloxRandomStream.skipToNth(n) called with negative 'n' value " + n:string);
+        _lock();
+        PhiloxRandomStreamPrivate_count = n;
+        _unlock();
+      }
+
+      /*
+        Advance/rewind the stream to the `n`-th value and return it
+        (advancing the stream by one).  n must be >= 0, otherwise an
+        IllegalArgumentError is thrown.  This is equivalent to
+        :proc:`skipToNth()` followed by :proc:`getNext()`.
+
+        :arg n: The position in the stream to skip to.  Must be >= 0.
+        :type n: `integral`
+
+        :returns: The `n`-th value in the random stream as type :type:`eltType`.
+        :throws IllegalArgumentError: When called with negative `n` value.
+       */
+      proc getNth(n: integral): eltType throws {
+        if (n < 0) then
+          throw new owned IllegalArgumentError("PhiloxRandomStream.getNth(n) called with negative 'n' value " + n:string);
+        _lock();
+        PhiloxRandomStreamPrivate_count = n;
+        const result = PhiloxRandomStreamPrivate_getNext_noLock(eltType);
+        _unlock();
+        return result;
+      }
+
+      /*
+        Fill the argument array with pseudorandom values.  This method is
+        identical to the standalone :proc:`~Random.fillRandom` procedure,
+        except that it consumes random values from the
+        :class:`PhiloxRandomStream` object on which it's invoked rather
+        than creating a new stream for the purpose of the call.
+
+        Each task computes the values for the elements it is assigned
+        by the array's parallel iterator directly, so for a distributed
+        array each locale fills its own elements without communication.
+
+        :arg arr: The array to be filled
+        :type arr: [] :type:`eltType`
+      */
+      proc fillRandom(arr: [] eltType) {
+        forall (x, r) in zip(arr, iterate(arr.domain, arr.eltType)) do
+          x = r;
+      }
+
+      pragma "no doc"
+      proc fillRandom(arr: []) {
+        compilerError("PhiloxRandomStream(eltType=", eltType:string,
+                      ") can only be used to fill arrays of ", eltType:string);
+      }
+
+      pragma "no doc"
+      proc choice(x: [], size:?sizeType=none, replace=true, prob:?probType=none)
+        throws
+      {
+        compilerError("PhiloxRandomStream.choice() is not supported.");
+      }
+
+      pragma "no doc"
+      proc choice(x: range(stridable=?), size:?sizeType=none, replace=true, prob:?probType=none)
+        throws
+      {
+        compilerError("PhiloxRandomStream.choice() is not supported.");
+      }
+
+      pragma "no doc"
+      proc choice(x: domain, size:?sizeType=none, replace=true, prob:?probType=none)
+        throws
+      {
+        compilerError("PhiloxRandomStream.choice() is not supported.");
+      }
+
+      /*
+
+         Returns an iterable expression for generating `D.size` random
+         numbers. The RNG state will be immediately advanced by `D.size`
+         before the iterable expression yields any values.
+
+         The returned iterable expression is useful in parallel contexts,
+         including standalone and zippered iteration. The domain will determine
+         the parallelization strategy.
+
+         :arg D: a domain
+         :arg resultType: the type of number to yield
+         :return: an iterable expression yielding random `resultType` values
+
+       */
+      pragma "fn returns iterator"
+      proc iterate(D: domain, type resultType=eltType) {
+        _lock();
+        const start = PhiloxRandomStreamPrivate_count;
+        PhiloxRandomStreamPrivate_count += D.size.safeCast(int(64));
+        _unlock();
+        return PhiloxRandomPrivate_iterate(resultType, D, seed, start);
+      }
+
+      // Forward the leader iterator as well.
+      pragma "no doc"
+      pragma "fn returns iterator"
+      proc iterate(D: domain, type resultType=eltType, param tag)
+        where tag == iterKind.leader
+      {
+        // Note that proc iterate() for the serial case (i.e. the one above)
+        // is going to be invoked as well, so we should not be taking
+        // any actions here other than the forwarding.
+        const start = PhiloxRandomStreamPrivate_count;
+        return PhiloxRandomPrivate_iterate(resultType, D, seed, start, tag);
+      }
+
+      pragma "no doc"
+      override proc writeThis(f) throws {
+        f <~> "PhiloxRandomStream(eltType=";
+        f <~> eltType:string;
+        f <~> ", parSafe=";
+        f <~> parSafe;
+        f <~> ", seed=";
+        f <~> seed;
+        f <~> ")";
+      }
+
+      ///////////////////////////////////////////////////////// CLASS PRIVATE //
+      //
+      // It is the intent that once Chapel supports the notion of
+      // 'private', everything in this class declared below this line will
+      // be made private to this class.
+      //
+
+      pragma "no doc"
+      var _l: if parSafe then chpl_LocalSpinlock else nothing;
+      pragma "no doc"
+      inline proc _lock() {
+        if parSafe then _l.lock();
+      }
+      pragma "no doc"
+      inline proc _unlock() {
+        if parSafe then _l.unlock();
+      }
+      // 0-based position of the next value
+      pragma "no doc"
+      var PhiloxRandomStreamPrivate_count: int(64) = 0;
+    }
+
+    /*
+      Compute one block of the Philox4x32-10 bijection, the building block
+      of :class:`PhiloxRandomStream`.
+
+      :arg ctr: the 128-bit counter
+      :arg key: the 64-bit key
+      :returns: 128 pseudorandom bits
+     */
+    proc philox4x32(ctr: 4*uint(32), key: 2*uint(32)): 4*uint(32) {
+      var (c0, c1, c2, c3) = ctr;
+      var (k0, k1) = key;
+      // Kept in scalars rather than a tuple so that the rounds
+      // stay in registers.
+      for param r in 0..9 {
+        if r > 0 {
+          k0 += philoxW0;
+          k1 += philoxW1;
+        }
+        const p0 = philoxM0:uint(64) * c0:uint(64);
+        const p1 = philoxM1:uint(64) * c2:uint(64);
+        const n0 = (p1 >> 32):uint(32) ^ c1 ^ k0;
+        const n2 = (p0 >> 32):uint(32) ^ c3 ^ k1;
+        c1 = p1:uint(32);
+        c3 = p0:uint(32);
+        c0 = n0;
+        c2 = n2;
+      }
+      return (c0, c1, c2, c3);
+    }
+
+    /*
+      Compute the `n`-th value in a :class:`PhiloxRandomStream` with the
+      given seed. This is a pure function of its arguments, so it can be
+      called from any task or locale without synchronization.
+
+      :arg resultType: the type of value to generate
+      :arg seed: the seed of the stream
+      :arg n: the 0-based position in the stream
+      :returns: a pseudorandom value of type `resultType`
+     */
+    proc philoxRandom(type resultType, seed: int(64), n: integral): resultType {
+      if !isSupportedNumericType(resultType) then
+        compilerError("philoxRandom does not support ", resultType:string);
+
+      param perBlock = valuesPerBlock(resultType);
+      const un = n:uint(64);
+      const x = philoxBlock(un / perBlock, seed);
+      return valueFromBlock(resultType, x, (un % perBlock):int);
+    }
+
+
+    ////////////////////////////////////////////////////////// MODULE PRIVATE //
+    //
+    // It is the intent that once Chapel supports the notion of 'private',
+    // everything declared below this line will be made private to this
+    // module.
+    //
+
+    // returns a random number in [0, 1) that is a multiple of 2**-53
+    private inline
+    proc randToReal64(x: uint(64)):real(64)
+    {
+      return (x >> 11):real(64) * 0x1p-53;
+    }
+
+    // returns a random number in [0, 1) that is a multiple of 2**-24
+    private inline
+    proc randToReal32(x: uint(32)):real(32)
+    {
+      return (x >> 8):real(32) * 0x1p-24:real(32);
+    }
+
+    // How many values of type t are taken from each 128-bit block?
+    private proc valuesPerBlock(type t) param {
+      if isBoolType(t) then return 4;
+      else if isComplexType(t) then return 128 / numBits(t);
+      else if numBits(t) == 64 then return 2;
+      else return 4;
+    }
+
+    private inline proc philoxBlock(b: uint(64), seed: int(64)) {
+      const useed = seed:uint(64);
+      return philox4x32((b:uint(32), (b >> 32):uint(32), 0:uint(32), 0:uint(32)),
+                        (useed:uint(32), (useed >> 32):uint(32)));
+    }
+
+    // Returns the j-th value of type resultType from the block x
+    private inline
+    proc valueFromBlock(type resultType, x: 4*uint(32), j: int) {
+      if isBoolType(resultType) {
+        return (x[j] >> 31) != 0;
+      } else if resultType == complex(128) {
+        const re = (x[0]:uint(64) << 32) | x[1];
+        const im = (x[2]:uint(64) << 32) | x[3];
+        return (randToReal64(re), randToReal64(im)):complex(128);
+      } else if resultType == complex(64) {
+        return (randToReal32(x[2*j]), randToReal32(x[2*j+1])):complex(64);
+      } else if numBits(resultType) == 64 {
+        const bits = (x[2*j]:uint(64) << 32) | x[2*j+1];
+        if resultType == real(64) then
+          return randToReal64(bits);
+        else if resultType == imag(64) then
+          return _r2i(randToReal64(bits));
+        else
+          return bits:resultType;
+      } else if resultType == real(32) {
+        return randToReal32(x[j]);
+      } else if resultType == imag(32) {
+        return _r2i(randToReal32(x[j]));
+      } else if resultType == uint(32) || resultType == int(32) {
+        return x[j]:resultType;
+      } else if resultType == uint(16) || resultType == int(16) {
+        return (x[j] >> 16):resultType;
+      } else {
+        return (x[j] >> 24):resultType;
+      }
+    }
+
+    //
+    // iterate over outer ranges in tuple of ranges
+    //
+    pragma "order independent yielding loops"
+    private iter outer(ranges, param dim: int = 0) {
+      if dim + 2 == ranges.size {
+        for i in ranges(dim) do
+          yield (i,);
+      } else if dim + 2 < ranges.size {
+        for i in ranges(dim) do
+          for j in outer(ranges, dim+1) do
+            yield (i, (...j));
+      } else {
+        yield 0; // 1D case is a noop
+      }
+    }
+
+    //
+    // PhiloxRandomStream iterator implementation
+    //
+    // start is the 0-based position in the stream of the first index of D.
+    // Since any position can be computed directly, followers don't need
+    // to skip ahead before generating their values.
+    //
+    pragma "no doc"
+    iter PhiloxRandomPrivate_iterate(type resultType, D: domain, seed: int(64),
+                                     start: int(64)) {
+      var n = start;
+      for i in D {
+        yield philoxRandom(resultType, seed, n);
+        n += 1;
+      }
+    }
+
+    pragma "no doc"
+    iter PhiloxRandomPrivate_iterate(type resultType, D: domain, seed: int(64),
+                                     start: int(64), param tag: iterKind)
+          where tag == iterKind.leader {
+      // forward to the domain D's iterator
+      for block in D.these(tag=iterKind.leader) do
+        yield block;
+    }
+
+    pragma "no doc"
+    iter PhiloxRandomPrivate_iterate(type resultType, D: domain, seed: int(64),
+                 start: int(64), param tag: iterKind, followThis)
+          where tag == iterKind.follower {
+      use DSIUtil;
+      const ZD = computeZeroBasedDomain(D);
+      const innerRange = followThis(ZD.rank-1);
+      for outer in outer(followThis) {
+        var myStart = start;
+        if ZD.rank > 1 then
+          myStart += ZD.indexOrder(((...outer), innerRange.low)).safeCast(int(64));
+        else
+          myStart += ZD.indexOrder(innerRange.low).safeCast(int(64));
+        if !innerRange.stridable {
+          // Compute each block once and yield all of its values that
+          // fall within this row. This is written as a single loop with
+          // a single yield so that it can be inlined when zippered.
+          param perBlock = valuesPerBlock(resultType);
+          var n = myStart:uint(64);
+          var x = philoxBlock(n / perBlock, seed);
+          for i in innerRange {
+            const j = (n % perBlock):int;
+            if j == 0 then x = philoxBlock(n / perBlock, seed);
+            yield valueFromBlock(resultType, x, j);
+            n += 1;
+          }
+        } else {
+          // The inner dimension of ZD is dense, so positions within
+          // a row differ by the inner index.
+          myStart -= innerRange.low.safeCast(int(64));
+          for i in innerRange do
+            yield philoxRandom(resultType, seed, myStart + i.safeCast(int(64)));
+        }
+      }
+    }
+
+  } // close module PhiloxRandom
+
+
+
+  /*
+     Non-uniform random distributions
+
+     This module provides samplers for several non-uniform distributions
+     that draw their uniform values from any of the streams in this
+     module, such as :class:`~PCGRandom.PCGRandomStream` or
+     :class:`~NPBRandom.NPBRandomStream`:
+
+       * :proc:`randomNormal` and :proc:`fillNormal` use the Ziggurat method
+         of Marsaglia and Tsang with the improvements of Doornik
+         (`An Improved Ziggurat Method to Generate Normal Random Samples`,
+         2005)
+       * :proc:`randomExponential` and :proc:`fillExponential` use the
+         Ziggurat method as well
+       * :proc:`randomPoisson` and :proc:`fillPoisson` use inversion for
+         small means and Hörmann's transformed rejection with squeeze
+         (PTRS) otherwise
+       * :proc:`randomBinomial` and :proc:`fillBinomial` use inversion when
+         few successes are expected and Hörmann's transformed rejection
+         (BTRS) otherwise
+       * :record:`aliasTable` samples from a discrete distribution given by
+         a weight for each outcome using Vose's alias method
+
+     The ``random*`` procedures draw a single value using as many values
+     from the given stream as the method needs. The stream must generate
+     `real(64)` values.
+
+     The ``fill*`` procedures fill an array in parallel. The array's
+     elements are visited in the same order as
+     :proc:`~RandomStreamInterface.fillRandom`, and each element takes one
+     value from the stream, which is used to seed a small generator that
+     provides the (varying) number of uniform values the sampler for that
+     element needs. The result is therefore the same no matter how the
+     array is distributed or how many tasks fill it, and filling an array
+     consumes exactly `arr.size` values from the stream.
+
+     .. note::
+
+       :mod:`NPBRandom` produces values with 46 random bits, so the
+       samples drawn from it have correspondingly less precision than
+       those drawn from the other streams.
+
+  */
+  module RandomDistributions {
+
+    use super.RandomSupport;
+    use super.PCGRandomLib;
+    use Random only RNG, defaultRNG, createRandomStream;
+    import super.{PCGRandom, NPBRandom, PhiloxRandom};
+
+    /*
+      Draw a value from the normal distribution with the given mean and
+      standard deviation.
+
+      :arg stream: the stream of `real(64)` values to draw from
+      :arg mean: the mean of the distribution
+      :arg stddev: the standard deviation of the distribution
+      :returns: a normally distributed `real`
+
+      :throws IllegalArgumentError: if `stddev` is negative
+    */
+    proc randomNormal(stream, mean: real = 0.0, stddev: real = 1.0): real
+      throws
+    {
+      checkStream(stream, "randomNormal");
+      checkNormal(stddev);
+      var s = stream.borrow();
+      return mean + stddev * zigNormal(s);
+    }
+
+    /*
+      Draw a value from the exponential distribution with the given rate
+      (the reciprocal of its mean).
+
+      :arg stream: the stream of `real(64)` values to draw from
+      :arg rate: the rate of the distribution
+      :returns: an exponentially distributed `real`
+
+      :throws IllegalArgumentError: if `rate` is not positive
+    */
+    proc randomExponential(stream, rate: real = 1.0): real throws {
+      checkStream(stream, "randomExponential");
+      checkExponential(rate);
+      var s = stream.borrow();
+      return zigExponential(s) / rate;
+    }
+
+    /*
+      Draw a value from the Poisson distribution with the given mean.
+
+      :arg stream: the stream of `real(64)` values to draw from
+      :arg mean: the mean of the distribution
+      :returns: a Poisson distributed `int`
+
+      :throws IllegalArgumentError: if `mean` is negative
+    */
+    proc randomPoisson(stream, mean: real): int throws {
+      checkStream(stream, "randomPoisson");
+      checkPoisson(mean);
+      const params = new poissonParams(mean);
+      var s = stream.borrow();
+      return poissonSample(s, params);
+    }
+
+    /*
+      Draw a value from the binomial distribution, that is, the number of
+      successes in `trials` independent trials that each succeed with
+      probability `p`.
+
+      :arg stream: the stream of `real(64)` values to draw from
+      :arg trials: the number of trials
+      :arg p: the probability that each trial succeeds
+      :returns: a binomially distributed `int` in `0..trials`
+
+      :throws IllegalArgumentError: if `trials` is negative or `p` is not
+                                    in [0, 1]
+    */
+    proc randomBinomial(stream, trials: int, p: real): int throws {
+      checkStream(stream, "randomBinomial");
+      checkBinomial(trials, p);
+      const params = new binomialParams(trials, p);
+      var s = stream.borrow();
+      return binomialSample(s, params);
+    }
+
+    /*
+      Fill an array with values from the normal distribution in parallel
+      using a new stream created specifically for this call.
+
+      :arg arr: the array to be filled
+      :type arr: `[] real`
+
+      :arg mean: the mean of the distribution
+      :arg stddev: the standard deviation of the distribution
+
+      :arg seed: The seed to use for the PRNG.  Defaults to
+       `oddCurrentTime` from :type:`RandomSupport.SeedGenerator`.
+      :type seed: `int(64)`
+
+      :arg algorithm: A param indicating which algorithm to use. Defaults to
+       :param:`~Random.defaultRNG`.
+      :type algorithm: :type:`~Random.RNG`
+
+      :throws IllegalArgumentError: if `stddev` is negative
+    */
+    proc fillNormal(arr: [] real, mean: real = 0.0, stddev: real = 1.0,
+                    seed: int(64) = SeedGenerator.oddCurrentTime,
+                    param algorithm = defaultRNG) throws {
+      var randNums = createRandomStream(seed=seed, eltType=real,
+                                        parSafe=false, algorithm=algorithm);
+      fillNormal(randNums, arr, mean, stddev);
+    }
+
+    /*
+      Fill an array with values from the normal distribution in parallel,
+      consuming `arr.size` values from `stream`.
+
+      :arg stream: the stream of `real(64)` values to draw from
+      :arg arr: the array to be filled
+      :type arr: `[] real`
+      :arg mean: the mean of the distribution
+      :arg stddev: the standard deviation of the distribution
+
+      :throws IllegalArgumentError: if `stddev` is negative
+    */
+    proc fillNormal(stream, arr: [] real, mean: real = 0.0,
+                    stddev: real = 1.0) throws {
+      checkStream(stream, "fillNormal");
+      checkNormal(stddev);
+      const key = streamKey(stream.seed);
+      const start = streamPosition(stream);
+      forall (x, r, i) in zip(arr, stream.iterate(arr.domain, real),
+                              arr.domain) {
+        var rng = new elementRNG(r, key, start + arr.domain.indexOrder(i));
+        x = mean + stddev * zigNormal(rng);
+      }
+    }
+
+    /*
+      Fill an array with values from the exponential distribution in
+      parallel using a new stream created specifically for this call.
+
+      :arg arr: the array to be filled
+      :type arr: `[] real`
+
+      :arg rate: the rate of the distribution
+
+      :arg seed: The seed to use for the PRNG.  Defaults to
+       `oddCurrentTime` from :type:`RandomSupport.SeedGenerator`.
+      :type seed: `int(64)`
+
+      :arg algorithm: A param indicating which algorithm to use. Defaults to
+       :param:`~Random.defaultRNG`.
+      :type algorithm: :type:`~Random.RNG`
+
+      :throws IllegalArgumentError: if `rate` is not positive
+    */
+    proc fillExponential(arr: [] real, rate: real = 1.0,
+                         seed: int(64) = SeedGenerator.oddCurrentTime,
+                         param algorithm = defaultRNG) throws {
+      var randNums = createRandomStream(seed=seed, eltType=real,
+                                        parSafe=false, algorithm=algorithm);
+      fillExponential(randNums, arr, rate);
+    }
+
+    /*
+      Fill an array with values from the exponential distribution in
+      parallel, consuming `arr.size` values from `stream`.
+
+      :arg stream: the stream of `real(64)` values to draw from
+      :arg arr: the array to be filled
+      :type arr: `[] real`
+      :arg rate: the rate of the distribution
+
+      :throws IllegalArgumentError: if `rate` is not positive
+    */
+    proc fillExponential(stream, arr: [] real, rate: real = 1.0) throws {
+      checkStream(stream, "fillExponential");
+      checkExponential(rate);
+      const key = streamKey(stream.seed);
+      const start = streamPosition(stream);
+      forall (x, r, i) in zip(arr, stream.iterate(arr.domain, real),
+                              arr.domain) {
+        var rng = new elementRNG(r, key, start + arr.domain.indexOrder(i));
+        x = zigExponential(rng) / rate;
+      }
+    }
+
+    /*
+      Fill an array with values from the Poisson distribution in parallel
+      using a new stream created specifically for this call.
+
+      :arg arr: the array to be filled
+      :type arr: `[] int`
+
+      :arg mean: the mean of the distribution
+
+      :arg seed: The seed to use for the PRNG.  Defaults to
+       `oddCurrentTime` from :type:`RandomSupport.SeedGenerator`.
+      :type seed: `int(64)`
+
+      :arg algorithm: A param indicating which algorithm to use. Defaults to
+       :param:`~Random.defaultRNG`.
+      :type algorithm: :type:`~Random.RNG`
+
+      :throws IllegalArgumentError: if `mean` is negative
+    */
+    proc fillPoisson(arr: [] int, mean: real,
+                     seed: int(64) = SeedGenerator.oddCurrentTime,
+                     param algorithm = defaultRNG) throws {
+      var randNums = createRandomStream(seed=seed, eltType=real,
+                                        parSafe=false, algorithm=algorithm);
+      fillPoisson(randNums, arr, mean);
+    }
+
+    /*
+      Fill an array with values from the Poisson distribution in parallel,
+      consuming `arr.size` values from `stream`.
+
+      :arg stream: the stream of `real(64)` values to draw from
+      :arg arr: the array to be filled
+      :type arr: `[] int`
+      :arg mean: the mean of the distribution
+
+      :throws IllegalArgumentError: if `mean` is negative
+    */
+    proc fillPoisson(stream, arr: [] int, mean: real) throws {
+      checkStream(stream, "fillPoisson");
+      checkPoisson(mean);
+      const params = new poissonParams(mean);
+      const key = streamKey(stream.seed);
+      const start = streamPosition(stream);
+      forall (x, r, i) in zip(arr, stream.iterate(arr.domain, real),
+                              arr.domain) {
+        var rng = new elementRNG(r, key, start + arr.domain.indexOrder(i));
+        x = poissonSample(rng, params);
+      }
+    }
+
+    /*
+      Fill an array with values from the binomial distribution in parallel
+      using a new stream created specifically for this call.
+
+      :arg arr: the array to be filled
+      :type arr: `[] int`
+
+      :arg trials: the number of trials
+      :arg p: the probability that each trial succeeds
+
+      :arg seed: The seed to use for the PRNG.  Defaults to
+       `oddCurrentTime` from :type:`RandomSupport.SeedGenerator`.
+      :type seed: `int(64)`
+
+      :arg algorithm: A param indicating which algorithm to use. Defaults to
+       :param:`~Random.defaultRNG`.
+      :type algorithm: :type:`~Random.RNG`
+
+      :throws IllegalArgumentError: if `trials` is negative or `p` is not
+                                    in [0, 1]
+    */
+    proc fillBinomial(arr: [] int, trials: int, p: real,
+                      seed: int(64) = SeedGenerator.oddCurrentTime,
+                      param algorithm = defaultRNG) throws {
+      var randNums = createRandomStream(seed=seed, eltType=real,
+                                        parSafe=false, algorithm=algorithm);
+      fillBinomial(randNums, arr, trials, p);
+    }
+
+    /*
+      Fill an array with values from the binomial distribution in parallel,
+      consuming `arr.size` values from `stream`.
+
+      :arg stream: the stream of `real(64)` values to draw from
+      :arg arr: the array to be filled
+      :type arr: `[] int`
+      :arg trials: the number of trials
+      :arg p: the probability that each trial succeeds
+
+      :throws IllegalArgumentError: if `trials` is negative or `p` is not
+                                    in [0, 1]
+    */
+    proc fillBinomial(stream, arr: [] int, trials: int, p: real) throws {
+      checkStream(stream, "fillBinomial");
+      checkBinomial(trials, p);
+      const params = new binomialParams(trials, p);
+      const key = streamKey(stream.seed);
+      const start = streamPosition(stream);
+      forall (x, r, i) in zip(arr, stream.iterate(arr.domain, real),
+                              arr.domain) {
+        var rng = new elementRNG(r, key, start + arr.domain.indexOrder(i));
+        x = binomialSample(rng, params);
+      }
+    }
+
+    /*
+      A table for drawing indices of a 1-D array of weights with probability
+      proportional to the weights, built with Vose's alias method. Once the
+      table is built, drawing a value takes constant time and a single
+      uniform value, regardless of the number of weights.
+
+      .. code-block:: chapel
+
+        var weights = [0.5, 0.2, 0.3];
+        const table = new aliasTable(weights);
+        var stream = createRandomStream(real);
+        const i = table.sample(stream);   // 0 about half of the time
+
+        var samples: [1..1000] int;
+        table.fill(samples);
+    */
+    record aliasTable {
+      pragma "no doc"
+      var low: int;
+
+      pragma "no doc"
+      var D: domain(1);
+
+      // the probability of keeping each column's own index
+      pragma "no doc"
+      var prob: [D] real;
+
+      // the index to use for each column otherwise
+      pragma "no doc"
+      var alias: [D] int;
+
+      /*
+        Build a table for the given weights. The table will produce the
+        indices of `weights`.
+
+        Halts if `weights` is empty, contains a negative value, or sums
+        to 0.
+
+        :arg weights: a 1-D non-strided array of `real` or integral weights
+      */
+      proc init(weights: []) {
+        if weights.rank != 1 || weights.domain.stridable then
+          compilerError("aliasTable requires a 1-D non-strided array");
+        if !(isIntegralType(weights.eltType) || isRealType(weights.eltType)) then
+          compilerError("aliasTable weights must be real or integral");
+
+        const n = weights.size;
+        this.low = weights.domain.low;
+        this.D = {0..#n};
+        this.complete();
+
+        if n == 0 then
+          halt("aliasTable requires at least one weight");
+        if || reduce (weights < 0) then
+          halt("aliasTable weights must be non-negative");
+        const total = + reduce (weights:real);
+        if total <= 0.0 then
+          halt("aliasTable weights must not sum to 0");
+
+        // Scale the weights so they average to 1, then pair each column
+        // whose weight is below 1 with one whose weight is above it.
+        var scaled: [D] real;
+        forall (s, w) in zip(scaled, weights) do
+          s = w:real * n / total;
+
+        var small, large: [D] int;
+        var nSmall, nLarge = 0;
+        for i in D {
+          if scaled[i] < 1.0 {
+            small[nSmall] = i;
+            nSmall += 1;
+          } else {
+            large[nLarge] = i;
+            nLarge += 1;
+          }
+        }
+
+        while nSmall > 0 && nLarge > 0 {
+          nSmall -= 1;
+          const l = small[nSmall];
+          const g = large[nLarge-1];
+          prob[l] = scaled[l];
+          alias[l] = g;
+          scaled[g] = (scaled[g] + scaled[l]) - 1.0;
+          if scaled[g] < 1.0 {
+            nLarge -= 1;
+            small[nSmall] = g;
+            nSmall += 1;
+          }
+        }
+
+        // Anything left over is 1 up to rounding error.
+        for i in 0..#nLarge {
+          prob[large[i]] = 1.0;
+          alias[large[i]] = large[i];
+        }
+        for i in 0..#nSmall {
+          prob[small[i]] = 1.0;
+          alias[small[i]] = small[i];
+        }
+      }
+
+      /*
+        Draw an index of the weights this table was built for.
+
+        :arg stream: the stream of `real(64)` values to draw from
+        :returns: an index of the weights array
+      */
+      proc sample(stream): int {
+        checkStream(stream, "aliasTable.sample");
+        return low + sampleIndex(stream.getNext());
+      }
+
+      /*
+        Fill an array with indices of the weights in parallel using a new
+        stream created specifically for this call.
+
+        :arg arr: the array to be filled
+        :type arr: `[] int`
+
+        :arg seed: The seed to use for the PRNG.  Defaults to
+         `oddCurrentTime` from :type:`RandomSupport.SeedGenerator`.
+        :type seed: `int(64)`
+
+        :arg algorithm: A param indicating which algorithm to use. Defaults
+         to :param:`~Random.defaultRNG`.
+        :type algorithm: :type:`~Random.RNG`
+      */
+      proc fill(arr: [] int, seed: int(64) = SeedGenerator.oddCurrentTime,
+                param algorithm = defaultRNG) {
+        var randNums = createRandomStream(seed=seed, eltType=real,
+                                          parSafe=false, algorithm=algorithm);
+        fill(randNums, arr);
+      }
+
+      /*
+        Fill an array with indices of the weights in parallel, consuming
+        `arr.size` values from `stream`.
+
+        :arg stream: the stream of `real(64)` values to draw from
+        :arg arr: the array to be filled
+        :type arr: `[] int`
+      */
+      proc fill(stream, arr: [] int) {
+        checkStream(stream, "aliasTable.fill");
+        forall (x, r) in zip(arr, stream.iterate(arr.domain, real)) do
+          x = low + sampleIndex(r);
+      }
+
+      // Map a uniform value to a column and use the fractional part to
+      // choose between the column's index and its alias.
+      pragma "no doc"
+      inline proc sampleIndex(u: real): int {
+        const n = D.size;
+        const v = u * n;
+        const col = min(v:int, n-1);
+        return if v - col < prob[col] then col else alias[col];
+      }
+    }
+
+
+    ////////////////////////////////////////////////////////// MODULE PRIVATE //
+    //
+    // It is the intent that once Chapel supports the notion of 'private',
+    // everything declared below this line will be made private to this
+    // module.
+    //
+
+    private proc checkStream(stream, param fn: string) {
+      if stream.eltType != real(64) then
+        compilerError(fn, " requires a stream of real(64) values");
+    }
+
+    private proc checkNormal(stddev: real) throws {
+      if stddev < 0.0 then
+        throw new owned IllegalArgumentError("normal stddev must not be negative");
+    }
+
+    private proc checkExponential(rate: real) throws {
+      if !(rate > 0.0) then
+        throw new owned IllegalArgumentError("exponential rate must be positive");
+    }
+
+    private proc checkPoisson(mean: real) throws {
+      if !(mean >= 0.0) then
+        throw new owned IllegalArgumentError("Poisson mean must not be negative");
+    }
+
+    private proc checkBinomial(trials: int, p: real) throws {
+      if trials < 0 then
+        throw new owned IllegalArgumentError("binomial trials must not be negative");
+      if !(p >= 0.0 && p <= 1.0) then
+        throw new owned IllegalArgumentError("binomial p must be in [0, 1]");
+    }
+
+    // the finalizer of MurmurHash3, a bijection that mixes all the bits
+    private inline proc mix64(in z: uint(64)): uint(64) {
+      z = (z ^ (z >> 33)) * 0xff51afd7ed558ccd;
+      z = (z ^ (z >> 33)) * 0xc4ceb9fe1a85ec53;
+      return z ^ (z >> 33);
+    }
+
+    private inline proc streamKey(seed: int(64)): uint(64) {
+      return mix64(seed:uint(64) ^ 0x9E3779B97F4A7C15);
+    }
+
+    // The position in 'stream' of the next value it will produce. The
+    // streams count from different bases, which does not matter here.
+    private proc streamPosition(stream): int(64) {
+      const s = stream.borrow();
+      if isSubtype(s.type, PCGRandom.PCGRandomStream) then
+        return s.PCGRandomStreamPrivate_count;
+      else if isSubtype(s.type, NPBRandom.NPBRandomStream) then
+        return s.NPBRandomStreamPrivate_count;
+      else if isSubtype(s.type, PhiloxRandom.PhiloxRandomStream) then
+        return s.PhiloxRandomStreamPrivate_count;
+      else
+        return 0;
+    }
+
+    //
+    // The generator used for the uniform values of one element in the
+    // fill* procedures. It is seeded from the value the element took from
+    // the stream, that value's position in the stream and the stream's key,
+    // with both the state and the sequence constant depending on all three
+    // so that different elements don't share a sequence. The value alone
+    // has at most 53 random bits (46 for NPB streams), so elements of large
+    // arrays would often get the same seed without the position.
+    //
+    pragma "no doc"
+    record elementRNG {
+      var rng: pcg_setseq_64_rxs_m_xs_64_rng;
+      var inc: uint(64);
+
+      proc init(r: real, key: uint(64), pos: int(64)) {
+        const bits = mix64((r * 0x1p53):uint(64) ^ mix64(pos:uint(64) + key));
+        this.inc = (mix64(bits + key) << 1) | 1;
+        this.complete();
+        rng.srandom(mix64(bits ^ key), inc);
+      }
+
+      // returns a value in (0, 1) that is an odd multiple of 2**-54
+      inline proc ref getNext(): real {
+        return ((rng.random(inc) >> 11):real + 0.5) * 0x1p-53;
+      }
+    }
+
+    //
+    // Ziggurat tables, following Doornik's ZIGNOR. Layer i of the ziggurat
+    // is a rectangle from y=f(X[i]) to y=f(X[i+1]) and from x=0 to X[i]. All
+    // layers have area V, including layer 0, which is the part of the base
+    // strip under x=R together with the tail beyond R. Ratio[i] is
+    // X[i+1]/X[i]: points of layer i left of that fraction are under f.
+    //
+    private param zigNormalLayers = 128,
+                  zigNormalR = 3.442619855899,
+                  zigNormalV = 9.91256303526217e-3;
+
+    private param zigExpLayers = 256,
+                  zigExpR = 7.69711747013104972,
+                  zigExpV = 3.949659822581572e-3;
+
+    private proc zigNormalTables() {
+      param C = zigNormalLayers;
+      var X: (C+1)*real, F: (C+1)*real, Ratio: C*real;
+      var f = exp(-0.5 * zigNormalR * zigNormalR);
+      X[0] = zigNormalV / f;
+      X[1] = zigNormalR;
+      X[C] = 0.0;
+      for i in 2..C-1 {
+        X[i] = sqrt(-2.0 * log(zigNormalV / X[i-1] + f));
+        f = exp(-0.5 * X[i] * X[i]);
+      }
+      for i in 0..C do
+        F[i] = exp(-0.5 * X[i] * X[i]);
+      for i in 0..C-1 do
+        Ratio[i] = X[i+1] / X[i];
+      return (X, F, Ratio);
+    }
+
+    private proc zigExpTables() {
+      param C = zigExpLayers;
+      var X: (C+1)*real, F: (C+1)*real, Ratio: C*real;
+      X[0] = zigExpV / exp(-zigExpR);
+      X[1] = zigExpR;
+      X[C] = 0.0;
+      for i in 2..C-1 do
+        X[i] = -log(zigExpV / X[i-1] + exp(-X[i-1]));
+      for i in 0..C do
+        F[i] = exp(-X[i]);
+      for i in 0..C-1 do
+        Ratio[i] = X[i+1] / X[i];
+      return (X, F, Ratio);
+    }
+
+    private const zigNormalTab = zigNormalTables();
+    private const zigExpTab = zigExpTables();
+
+    //
+    // Both Ziggurat samplers take the layer from the high bits of one
+    // uniform value and use the rest of it as the uniform position within
+    // the layer, so the common case uses a single value.
+    //
+    private inline proc zigNormal(ref rng): real {
+      param C = zigNormalLayers;
+      const ref zigNormalX = zigNormalTab[0],
+                zigNormalF = zigNormalTab[1],
+                zigNormalRatio = zigNormalTab[2];
+      while true {
+        const v = rng.getNext() * C;
+        const i = min(v:int, C-1);
+        const u = 2.0 * (v - i) - 1.0;
+        if abs(u) < zigNormalRatio[i] then
+          return u * zigNormalX[i];
+        if i == 0 then
+          return normalTail(rng, u < 0.0);
+        const x = u * zigNormalX[i];
+        const y = zigNormalF[i] + rng.getNext() * (zigNormalF[i+1] - zigNormalF[i]);
+        if y < exp(-0.5 * x * x) then
+          return x;
+      }
+      return 0.0;
+    }
+
+    // Marsaglia's method for the tail of the normal beyond R
+    private proc normalTail(ref rng, neg: bool): real {
+      var x, y: real;
+      do {
+        x = log(rng.getNext()) / zigNormalR;
+        y = log(rng.getNext());
+      } while -2.0 * y < x * x;
+      return if neg then x - zigNormalR else zigNormalR - x;
+    }
+
+    private inline proc zigExponential(ref rng): real {
+      param C = zigExpLayers;
+      const ref zigExpX = zigExpTab[0],
+                zigExpF = zigExpTab[1],
+                zigExpRatio = zigExpTab[2];
+      while true {
+        const v = rng.getNext() * C;
+        const i = min(v:int, C-1);
+        const u = v - i;
+        if u < zigExpRatio[i] then
+          return u * zigExpX[i];
+        // the exponential distribution is memoryless, so its tail is just
+        // another exponential shifted by R
+        if i == 0 then
+          return zigExpR - log(rng.getNext());
+        const x = u * zigExpX[i];
+        const y = zigExpF[i] + rng.getNext() * (zigExpF[i+1] - zigExpF[i]);
+        if y < exp(-x) then
+          return x;
+      }
+      return 0.0;
+    }
+
+    // Below this mean, Poisson values are drawn by inversion
+    private param poissonInversionMax = 10.0;
+
+    // Values that only depend on the mean, computed once per fill
+    pragma "no doc"
+    record poissonParams {
+      var mean: real;
+      var expMean: real;  // for inversion
+      var loglam, b, a, logInvAlpha, vr: real;  // for PTRS
+
+      proc init(mean: real) {
+        this.mean = mean;
+        this.complete();
+        if mean < poissonInversionMax {
+          expMean = exp(-mean);
+        } else {
+          const slam = sqrt(mean);
+          loglam = log(mean);
+          b = 0.931 + 2.53 * slam;
+          a = -0.059 + 0.02483 * b;
+          logInvAlpha = log(1.1239 + 1.1328 / (b - 3.4));
+          vr = 0.9277 - 3.6224 / (b - 2.0);
+        }
+      }
+    }
+
+    private proc poissonSample(ref rng, const ref params: poissonParams): int {
+      const mean = params.mean;
+      if mean < poissonInversionMax {
+        if mean == 0.0 then return 0;
+        // Walk the CDF until it passes u. The CDF can fall short of 1 by
+        // rounding, so start over if the probabilities underflow first.
+        while true {
+          const u = rng.getNext();
+          var k = 0;
+          var p = params.expMean;
+          var cdf = p;
+          while u > cdf && p > 0.0 {
+            k += 1;
+            p *= mean / k;
+            cdf += p;
+          }
+          if u <= cdf then return k;
+        }
+      } else {
+        // W. Hörmann, The transformed rejection method for generating
+        // Poisson random variables, 1993
+        const b = params.b, a = params.a;
+        while true {
+          const u = rng.getNext() - 0.5;
+          const v = rng.getNext();
+          const us = 0.5 - abs(u);
+          const k = floor((2.0 * a / us + b) * u + mean + 0.43);
+          if us >= 0.07 && v <= params.vr then
+            return k:int;
+          if k < 0.0 || (us < 0.013 && v > us) then
+            continue;
+          if log(v) + params.logInvAlpha - log(a / (us * us) + b) <=
+             -mean + k * params.loglam - lgamma(k + 1.0) then
+            return k:int;
+        }
+      }
+      return 0;
+    }
+
+    // Below this many expected successes, binomial values are drawn by
+    // inversion
+    private param binomialInversionMax = 10.0;
+
+    // Values that only depend on trials and p, computed once per fill.
+    // The sampler works with the smaller of p and 1-p.
+    pragma "no doc"
+    record binomialParams {
+      var n: int;
+      var p: real;
+      var flip: bool;
+      var q, qn, bound: real;  // for inversion
+      var b, a, c, vr, alpha, logr, m, lgm: real;  // for BTRS
+
+      proc init(trials: int, p: real) {
+        this.n = trials;
+        this.p = min(p, 1.0 - p);
+        this.flip = p > 0.5;
+        this.complete();
+        const ps = this.p;
+        q = 1.0 - ps;
+        const np = n * ps;
+        if np < binomialInversionMax {
+          qn = exp(n * log(q));
+          bound = min(n:real, np + 10.0 * sqrt(np * q + 1.0));
+        } else {
+          const stddev = sqrt(np * q);
+          b = 1.15 + 2.53 * stddev;
+          a = -0.0873 + 0.0248 * b + 0.01 * ps;
+          c = np + 0.5;
+          vr = 0.92 - 4.2 / b;
+          alpha = (2.83 + 5.1 / b) * stddev;
+          logr = log(ps / q);
+          m = floor((n + 1) * ps);
+          lgm = lgamma(m + 1.0) + lgamma(n - m + 1.0);
+        }
+      }
+    }
+
+    private proc binomialSample(ref rng, const ref params: binomialParams): int {
+      const n = params.n, p = params.p;
+      var k = 0;
+      if p == 0.0 {
+        k = 0;
+      } else if n * p < binomialInversionMax {
+        // Walk the PMF until it passes u, starting over past a bound that
+        // is only reached through rounding error.
+        const q = params.q;
+        var px = params.qn;
+        var u = rng.getNext();
+        while u > px {
+          k += 1;
+          if k > params.bound {
+            k = 0;
+            px = params.qn;
+            u = rng.getNext();
+          } else {
+            u -= px;
+            px = ((n - k + 1) * p * px) / (k * q);
+          }
+        }
+      } else {
+        // W. Hörmann, The generation of binomial random variates, 1993
+        const b = params.b, a = params.a;
+        while true {
+          const u = rng.getNext() - 0.5;
+          var v = rng.getNext();
+          const us = 0.5 - abs(u);
+          const kr = floor((2.0 * a / us + b) * u + params.c);
+          if us >= 0.07 && v <= params.vr {
+            k = kr:int;
+            break;
+          }
+          if kr < 0.0 || kr > n then
+            continue;
+          // compare against log(f(kr)/f(m)), where m is the mode
+          v = log(v * params.alpha / (a / (us * us) + b));
+          if v <= params.lgm - lgamma(kr + 1.0) - lgamma(n - kr + 1.0) +
+                  (kr - params.m) * params.logr {
+            k = kr:int;
+            break;
+          }
+        }
+      }
+      return if params.flip then n - k else k;
+    }
+
+  } // close module RandomDistributions
+
+
 } // close module Random
@@ -61,6 +61,16 @@ Chapel supports both string and bytes regular expressions.
 Now you can use these methods on regular expressions: :proc:`regexp.search`,
 :proc:`regexp.match`, :proc:`regexp.split`, :proc:`regexp.matches`.
 
+To test text against many regular expressions at once, compile them together
+with :proc:`compileSet`. The resulting :record:`regexpSet` reports which of
+the patterns match in a single pass over the text, which is much faster than
+trying each pattern in turn:
+
+.. code-block:: chapel
+
+   var levels = compileSet(["ERROR", "WARN(ING)?", "timeout"]);
+   writeln(levels.matchingPatterns("WARNING: timeout on node 3")); // 1 2
+
 You can also use the string versions of these methods: :proc:`string.search`,
 :proc:`string.match`, :proc:`string.split`, or :proc:`string.matches`. Methods
 with same prototypes exist for :mod:`Bytes` type, as well.
@@ -396,6 +406,15 @@ private extern proc qio_regexp_string_piece_isnull(ref sp:qio_regexp_string_piec
 private extern proc qio_regexp_match(const ref re:qio_regexp_t, text:c_string, textlen:int(64), startpos:int(64), endpos:int(64), anchor:c_int, submatch:_ddata(qio_regexp_string_piece_t), nsubmatch:int(64)):bool;
 private extern proc qio_regexp_replace(const ref re:qio_regexp_t, repl:c_string, repllen:int(64), text:c_string, textlen:int(64), startpos:int(64), endpos:int(64), global:bool, ref replaced:c_string, ref replaced_len:int(64)):int(64);
 
+pragma "no doc"
+extern type qio_regexp_set_t;
+private extern proc qio_regexp_set_null():qio_regexp_set_t;
+private extern proc qio_regexp_set_create_compile(strs:c_ptr(c_string), strlens:c_ptr(int(64)), npatterns:int(64), ref options:qio_regexp_options_t, ref compiled:qio_regexp_set_t, ref err_idx:int(64), ref err_str:c_string);
+private extern proc qio_regexp_set_retain(const ref compiled:qio_regexp_set_t);
+private extern proc qio_regexp_set_release(ref compiled:qio_regexp_set_t);
+private extern proc qio_regexp_set_size(const ref compiled:qio_regexp_set_t):int(64);
+private extern proc qio_regexp_set_match(const ref compiled:qio_regexp_set_t, text:c_string, textlen:int(64), ids:c_ptr(int(64)), max_ids:int(64)):int(64);
+
 // These two could be folded together if we had a way
 // to check if a default argument was supplied
 // (or any way to use 'nil' in pass-by-ref)
@@ -1099,6 +1118,164 @@ inline proc _cast(type t: regexp(bytes), x: bytes) throws {
   return compile(x);
 }
 
+/*
+   Compile several regular expressions into a :record:`regexpSet`, which
+   matches all of them in one pass over the text. Patterns are identified by
+   their position in `patterns`, counting from 0. This routine will throw a
+   :class:`BadRegexpError` naming the first pattern that could not be
+   compiled.
+
+   :arg patterns: the regular expressions to compile, as strings or bytes. See
+                  :ref:`regular-expression-syntax` for details.
+
+   The remaining arguments have the same meaning as for :proc:`compile` and
+   apply to every pattern in the set. Sets never capture, so there is no
+   ``noCapture`` argument.
+ */
+proc compileSet(patterns: [] ?t, posix=false, literal=false,
+                /*i*/ ignoreCase=false, /*m*/ multiLine=false,
+                /*s*/ dotnl=false): regexpSet(t) throws
+                where t==string || t==bytes {
+
+  if CHPL_REGEXP == "none" {
+    compilerError("Cannot use Regexp with CHPL_REGEXP=none");
+  }
+
+  var opts:qio_regexp_options_t;
+  qio_regexp_init_default_options(opts);
+
+  opts.utf8 = t==string;
+  opts.posix = posix;
+  opts.literal = literal;
+  opts.nocapture = true;
+  opts.ignorecase = ignoreCase;
+  opts.multiline = multiLine;
+  opts.dotnl = dotnl;
+
+  // Keep local copies of the patterns alive while the set is compiled
+  const n = patterns.size;
+  var localPatterns: [0..#n] t;
+  var strs: [0..#max(n, 1)] c_string;
+  var lens: [0..#max(n, 1)] int(64);
+  for (pattern, i) in zip(patterns, 0..) {
+    localPatterns[i] = pattern.localize();
+    strs[i] = localPatterns[i].c_str();
+    lens[i] = pattern.numBytes;
+  }
+
+  var ret: regexpSet(t);
+  var errIdx: int(64);
+  var errStr: c_string;
+  qio_regexp_set_create_compile(c_ptrTo(strs), c_ptrTo(lens), n, opts,
+                                ret._set, errIdx, errStr);
+  if errIdx != -1 {
+    var errMsg: string;
+    try! {
+      errMsg = createStringWithOwnedBuffer(errStr);
+    }
+    if errIdx < n {
+      const pattern = localPatterns[errIdx];
+      const patternStr = if t==string then pattern
+                                      else pattern.decode(decodePolicy.replace);
+      errMsg += " when compiling regexp '" + patternStr + "'" +
+                " (pattern " + errIdx:string + " of the set)";
+    }
+    throw new owned BadRegexpError(errMsg);
+  }
+  return ret;
+}
+
+/*  A set of compiled regular expressions that are matched against text
+    together, in a single pass. It reports which of the patterns matched, but
+    not where. To create one, use :proc:`compileSet`.
+
+    Like :record:`regexp`, sets are reference counted, so copying one is
+    cheap.
+  */
+pragma "ignore noinit"
+record regexpSet {
+  /* The type of text the patterns match: string or bytes */
+  type exprType;
+  pragma "no doc"
+  var home: locale = here;
+  pragma "no doc"
+  var _set:qio_regexp_set_t = qio_regexp_set_null();
+
+  pragma "no doc"
+  proc init(type exprType) {
+    this.exprType = exprType;
+  }
+
+  pragma "no doc"
+  proc init=(x: regexpSet(?)) {
+    this.exprType = x.exprType;
+    this.home = x.home;
+    this._set = x._set;
+    this.complete();
+    on home {
+      qio_regexp_set_retain(_set);
+    }
+  }
+
+  pragma "no doc"
+  proc ref deinit() {
+    on home {
+      qio_regexp_set_release(_set);
+    }
+  }
+
+  /* The number of patterns in the set */
+  proc size: int {
+    var ret: int;
+    on home do ret = qio_regexp_set_size(_set);
+    return ret;
+  }
+
+  /*
+     :arg text: a string or bytes to search
+     :returns: `true` if any of the patterns match anywhere in `text`
+   */
+  proc matchesAny(text: exprType): bool {
+    var ret: bool;
+    on home {
+      ret = qio_regexp_set_match(_set, text.localize().c_str(), text.numBytes,
+                                 nil, 0) != 0;
+    }
+    return ret;
+  }
+
+  /*
+     :arg text: a string or bytes to search
+     :returns: an array of the indices of the patterns that match anywhere in
+               `text`, in increasing order
+   */
+  proc matchingPatterns(text: exprType): [] int {
+    return _matchingPatterns(text, text.numBytes);
+  }
+
+  // Matches the first textLen bytes of text.  Also used to match lines read
+  // from a channel without their newline.
+  pragma "no doc"
+  proc _matchingPatterns(text: exprType, textLen: int): [] int {
+    var D: domain(1);
+    var ret: [D] int;
+    on home {
+      const n = qio_regexp_set_size(_set);
+      var ids: [0..#max(n, 1)] int;
+      const nFound = qio_regexp_set_match(_set, text.localize().c_str(),
+                                          textLen, c_ptrTo(ids), n);
+      D = {0..#nFound};
+      ret = ids[0..#nFound];
+    }
+    return ret;
+  }
+
+  pragma "no doc"
+  proc writeThis(f) throws {
+    f <~> "regexpSet(" <~> this.size <~> " patterns)";
+  }
+}
+
 /*
 
    Compile a regular expression and search the receiving string for matches at
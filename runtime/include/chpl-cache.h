@@ -89,6 +89,10 @@ void chpl_cache_comm_getput_unordered(c_nodeid_t dstnode, void* dstaddr,
                                       size_t size, int32_t commID,
                                       int ln, int32_t fn);
 void chpl_cache_comm_getput_unordered_task_fence(void);
+void chpl_cache_comm_put_aggregated(void* addr, c_nodeid_t node, void* raddr,
+                                    size_t size, int32_t commID, int ln, int32_t fn);
+void chpl_cache_comm_get_aggregated(void *addr, c_nodeid_t node, void* raddr,
+                                    size_t size, int32_t commID, int ln, int32_t fn);
 
 // For debugging.
 void chpl_cache_print(void);
@@ -174,6 +174,34 @@ void chpl_gen_comm_getput_unordered(c_nodeid_t dstnode, void* dstaddr,
   }
 }
 
+static inline
+void chpl_gen_comm_get_aggregated(void *addr, c_nodeid_t node, void* raddr,
+                                  size_t size, int32_t commID, int ln, int32_t fn)
+{
+  if (0) {
+#ifdef HAS_CHPL_CACHE_FNS
+  } else if( chpl_cache_enabled() ) {
+    chpl_cache_comm_get_aggregated(addr, node, raddr, size, commID, ln, fn);
+#endif
+  } else {
+    chpl_comm_get_aggregated(addr, node, raddr, size, commID, ln, fn);
+  }
+}
+
+static inline
+void chpl_gen_comm_put_aggregated(void* addr, c_nodeid_t node, void* raddr,
+                                  size_t size, int32_t commID, int ln, int32_t fn)
+{
+  if (0) {
+#ifdef HAS_CHPL_CACHE_FNS
+  } else if( chpl_cache_enabled() ) {
+    chpl_cache_comm_put_aggregated(addr, node, raddr, size, commID, ln, fn);
+#endif
+  } else {
+    chpl_comm_put_aggregated(addr, node, raddr, size, commID, ln, fn);
+  }
+}
+
 static inline
 void chpl_gen_comm_getput_unordered_task_fence(void)
 {
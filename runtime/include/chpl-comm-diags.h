@@ -23,9 +23,11 @@
 
 #include <stdarg.h>
 #include <stdio.h>
+#include <time.h>
 
 #include "chpl-atomics.h"
 #include "chpl-comm.h"
+#include "chpl-thread-local-storage.h"
 #include "error.h"
 
 ////////////////////
@@ -70,6 +72,35 @@ void chpl_comm_stopDiagnosticsHere(void);
 void chpl_comm_resetDiagnosticsHere(void);
 void chpl_comm_getDiagnosticsHere(chpl_commDiagnostics *cd);
 
+//
+// Per-site profile: the count, bytes, and cumulative time of the
+// operations of each kind initiated from each (commID, line, file).
+// Non-blocking operations are timed until they are initiated.
+//
+typedef enum {
+  chpl_comm_diags_site_get,
+  chpl_comm_diags_site_put,
+  chpl_comm_diags_site_execute_on
+} chpl_comm_diags_site_kind_t;
+
+typedef struct _chpl_commSiteDiagnostics {
+  int32_t kind;         // chpl_comm_diags_site_kind_t
+  int32_t commID;
+  int32_t lineno;
+  int32_t filename;
+  uint64_t count;
+  uint64_t numBytes;
+  uint64_t time;        // nanoseconds
+} chpl_commSiteDiagnostics;
+
+//
+// Fill in up to 'max' entries of 'sd', merged over all threads and in
+// decreasing order of bytes moved, and return the total number of
+// entries.
+//
+size_t chpl_comm_getSiteDiagnosticsHere(chpl_commSiteDiagnostics *sd,
+                                        size_t max);
+
 
 ////////////////////
 //
@@ -81,32 +112,49 @@ typedef struct _chpl_atomic_commDiagnostics {
 #undef _COMM_DIAGS_DECL_ATOMIC
 } chpl_atomic_commDiagnostics;
 
-extern chpl_atomic_commDiagnostics chpl_comm_diags_counters;
-extern atomic_int_least16_t chpl_comm_diags_disable_flag;
+//
+// One entry in a thread's per-site table.  Only the owning thread adds
+// entries; it fills in the key and then sets inUse.
+//
+typedef struct _chpl_comm_diags_site {
+  atomic_bool inUse;
+  int32_t kind;
+  int32_t commID;
+  int32_t lineno;
+  int32_t filename;
+  atomic_uint_least64_t count;
+  atomic_uint_least64_t numBytes;
+  atomic_uint_least64_t time;
+} chpl_comm_diags_site_t;
 
-static inline
-void chpl_comm_diags_init(void) {
-#define _COMM_DIAGS_INIT(cdv) \
-        atomic_init_uint_least64_t(&chpl_comm_diags_counters.cdv, 0);
-  CHPL_COMM_DIAGS_VARS_ALL(_COMM_DIAGS_INIT);
-#undef _COMM_DIAGS_INIT
-  atomic_init_int_least16_t(&chpl_comm_diags_disable_flag, 0);
-}
+//
+// The counters are sharded per thread, so that threads counting their
+// own operations don't contend for the same cache lines.  A thread gets
+// its shard the first time it counts something.  Shards are kept on a
+// list for readers and are never freed.
+//
+typedef struct _chpl_comm_diags_shard {
+  chpl_atomic_commDiagnostics counters;
+  chpl_comm_diags_site_t* sites;        // per-site table, NULL until used
+  struct _chpl_comm_diags_shard* next;
+} chpl_comm_diags_shard_t;
 
-static inline
-void chpl_comm_diags_reset(void) {
-#define _COMM_DIAGS_RESET(cdv) \
-        atomic_store_uint_least64_t(&chpl_comm_diags_counters.cdv, 0);
- CHPL_COMM_DIAGS_VARS_ALL(_COMM_DIAGS_RESET);
-#undef _COMM_DIAGS_RESET
-}
+extern CHPL_TLS_DECL(chpl_comm_diags_shard_t*, chpl_comm_diags_my_shard);
+extern atomic_int_least16_t chpl_comm_diags_disable_flag;
+
+void chpl_comm_diags_init(void);
+void chpl_comm_diags_reset(void);
+void chpl_comm_diags_copy(chpl_commDiagnostics* cd);
+chpl_comm_diags_shard_t* chpl_comm_diags_new_shard(void);
+void chpl_comm_diags_site_record(chpl_comm_diags_site_kind_t kind,
+                                 size_t size, int32_t commID,
+                                 int ln, int32_t fn, uint64_t startTime);
 
 static inline
-void chpl_comm_diags_copy(chpl_commDiagnostics* cd) {
-#define _COMM_DIAGS_COPY(cdv) \
-        cd->cdv = atomic_load_uint_least64_t(&chpl_comm_diags_counters.cdv);
-  CHPL_COMM_DIAGS_VARS_ALL(_COMM_DIAGS_COPY);
-#undef _COMM_DIAGS_COPY
+chpl_comm_diags_shard_t* chpl_comm_diags_shard(void) {
+  chpl_comm_diags_shard_t* shard =
+    (chpl_comm_diags_shard_t*) CHPL_TLS_GET(chpl_comm_diags_my_shard);
+  return (shard != NULL) ? shard : chpl_comm_diags_new_shard();
 }
 
 static inline
@@ -173,9 +221,32 @@ int chpl_comm_diags_is_enabled(void) {
 #define chpl_comm_diags_incr(_ctr)                                      \
   do {                                                                  \
     if (chpl_comm_diagnostics && chpl_comm_diags_is_enabled()) {        \
-      atomic_uint_least64_t* ctrAddr = &chpl_comm_diags_counters._ctr;  \
+      atomic_uint_least64_t* ctrAddr =                                  \
+        &chpl_comm_diags_shard()->counters._ctr;                        \
       (void) atomic_fetch_add_uint_least64_t(ctrAddr, 1);               \
     }                                                                   \
   } while(0)
 
+//
+// Per-site profiling.  Comm layers call chpl_comm_diags_site_start()
+// before an operation and chpl_comm_diags_site() after it.  The start
+// time is 0 when diagnostics are off, and then nothing is recorded.
+//
+static inline
+uint64_t chpl_comm_diags_site_start(void) {
+  struct timespec ts;
+  if (!chpl_comm_diagnostics || !chpl_comm_diags_is_enabled())
+    return 0;
+  (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + (uint64_t) ts.tv_nsec + 1;
+}
+
+#define chpl_comm_diags_site(_kind, size, commid, ln, fn, start)        \
+  do {                                                                  \
+    if ((start) != 0) {                                                 \
+      chpl_comm_diags_site_record(chpl_comm_diags_site_##_kind,         \
+                                  size, commid, ln, fn, start);         \
+    }                                                                   \
+  } while(0)
+
 #endif
@@ -466,6 +466,22 @@ void chpl_comm_getput_unordered(c_nodeid_t dstnode, void* dstaddr,
 
 void chpl_comm_getput_unordered_task_fence(void);
 
+//
+// Aggregated ops
+//
+// These are unordered ops that the comm layer may hold in per-task,
+// per-node buffers and carry out many at a time, using one network
+// operation per buffer.  Like the unordered ops above they are
+// complete after chpl_comm_getput_unordered_task_fence(), and also
+// after chpl_comm_task_end().  Comm layers that have no aggregation
+// of their own just do unordered ops.
+//
+void chpl_comm_get_aggregated(void *addr, c_nodeid_t node, void* raddr,
+                              size_t size, int32_t commID, int ln, int32_t fn);
+
+void chpl_comm_put_aggregated(void* addr, c_nodeid_t node, void* raddr,
+                              size_t size, int32_t commID, int ln, int32_t fn);
+
 //
 // Runs a function f on a remote locale, passing it
 // arg where size of arg is stored in arg_size.
@@ -66,6 +66,7 @@
   m(STR_CONCAT_DATA,      "string concat data",                       true ), \
   m(STR_MOVE_DATA,        "string move data",                         true ), \
   m(STR_SELECT_DATA,      "string select data",                       true ), \
+  m(STR_CP_INDEX,         "string codepoint index",                   true ), \
   m(CFG_ARG_COPY_DATA,    "config arg copy data",                     true ), \
   m(CF_TABLE_DATA,        "config table data",                        true ), \
   m(LOCALE_NAME_BUF,      "locale name buffer",                       true ), \
@@ -34,7 +34,10 @@ struct chpl_chpl____wide_chpl_string_s;
 
 chpl_string chpl_wide_string_copy(struct chpl_chpl____wide_chpl_string_s* x, int32_t lineno, int32_t filename);
 
-#define CHPL_SHORT_STRING_SIZE 8
+// Strings and bytes of up to this many bytes are serialized with their data
+// inline, so they can be passed to on-statements without a separate GET.
+// Sized so that typical short keys and tokens fit.
+#define CHPL_SHORT_STRING_SIZE 24
 
 typedef struct chpl__inPlaceBuffer_t {
   uint8_t data[CHPL_SHORT_STRING_SIZE];
@@ -43,4 +46,18 @@ typedef struct chpl__inPlaceBuffer_t {
 uint8_t* chpl__getInPlaceBufferData(chpl__inPlaceBuffer* buf);
 uint8_t* chpl__getInPlaceBufferDataForWrite(chpl__inPlaceBuffer* buf);
 
+// Non-ASCII strings can carry a breadcrumb index that records the byte
+// offset of every CHPL_STRING_CP_INDEX_STRIDE-th codepoint, so finding the
+// byte offset of a codepoint takes at most that many steps rather than a
+// walk from the start of the string.
+#define CHPL_STRING_CP_INDEX_STRIDE 32
+
+// Returns the byte offset of codepoint cp_idx in buf, or buflen if the string
+// has cp_idx or fewer codepoints.  *cp_index is the string's cached index; it
+// is built (once, even if several tasks race to do so) if it is NULL.
+int64_t chpl_string_cp_to_byte_offset(void** cp_index,
+                                      const uint8_t* buf, int64_t buflen,
+                                      int64_t num_cp, int64_t cp_idx);
+void chpl_string_free_cp_index(void* cp_index);
+
 #endif
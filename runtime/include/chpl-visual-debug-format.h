@@ -0,0 +1,132 @@
+/*
+ * Copyright 2020 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Visual Debug binary record format
+//
+// This header is shared by the runtime (chpl-visual-debug.c), which writes
+// the records, and chplvis (tools/chplvis/DataModel.cxx), which reads them.
+// It must not depend on anything else in the runtime.
+//
+// Each data file starts with text lines (see tools/chplvis/DataFormat.txt),
+// the last of which is the "Clock:" line.  The rest of the file is a
+// sequence of the records below in native byte order.  Every record starts
+// with a chpl_vdebug_rec_hdr_t and its size is a multiple of 8 bytes.
+// Records are buffered per thread, so they are not in time order in the
+// file.
+//
+
+#ifndef _chpl_visual_debug_format_h_
+#define _chpl_visual_debug_format_h_
+
+#include <stdint.h>
+
+#define CHPL_VDEBUG_VER_MAJOR 2
+#define CHPL_VDEBUG_VER_MINOR 0
+
+typedef enum {
+  chpl_vdebug_rec_task = 1,   // task created
+  chpl_vdebug_rec_btask,      // task began
+  chpl_vdebug_rec_etask,      // task ended
+  chpl_vdebug_rec_put_nb,
+  chpl_vdebug_rec_get_nb,
+  chpl_vdebug_rec_put,
+  chpl_vdebug_rec_get,
+  chpl_vdebug_rec_put_strd,
+  chpl_vdebug_rec_get_strd,
+  chpl_vdebug_rec_fork,
+  chpl_vdebug_rec_fork_nb,
+  chpl_vdebug_rec_fork_fast,
+  chpl_vdebug_rec_mark,       // task is part of a xxxVdebug() call
+  chpl_vdebug_rec_tag,
+  chpl_vdebug_rec_pause,
+  chpl_vdebug_rec_end,        // data collection stopped
+  chpl_vdebug_rec_tagname
+} chpl_vdebug_rec_kind_t;
+
+typedef struct {
+  uint16_t kind;        // a chpl_vdebug_rec_kind_t
+  uint16_t size;        // size of the whole record in bytes
+  int32_t  nodeID;
+  uint64_t time;        // nanoseconds on the node's monotonic clock
+} chpl_vdebug_rec_hdr_t;
+
+// task
+typedef struct {
+  chpl_vdebug_rec_hdr_t hdr;
+  uint64_t taskID;
+  uint64_t parentTaskID;
+  int32_t  isExecuteOn;
+  int32_t  lineno;
+  int32_t  fileno;
+  int32_t  fid;
+} chpl_vdebug_rec_task_t;
+
+// btask, etask, and mark
+typedef struct {
+  chpl_vdebug_rec_hdr_t hdr;
+  uint64_t taskID;
+} chpl_vdebug_rec_task_id_t;
+
+// All of the puts and gets.  For gets, nodeID is the node making the
+// request and remoteNodeID is the node the data comes from.
+typedef struct {
+  chpl_vdebug_rec_hdr_t hdr;
+  int32_t  remoteNodeID;
+  int32_t  commID;
+  uint64_t taskID;
+  uint64_t addr;
+  uint64_t raddr;
+  uint64_t elemSize;
+  uint64_t length;
+  int32_t  lineno;
+  int32_t  fileno;
+} chpl_vdebug_rec_comm_t;
+
+// All of the forks (executeOns)
+typedef struct {
+  chpl_vdebug_rec_hdr_t hdr;
+  int32_t  remoteNodeID;
+  int32_t  subloc;
+  uint64_t taskID;
+  uint64_t arg;
+  uint64_t argSize;
+  int32_t  fid;
+  int32_t  lineno;
+  int32_t  fileno;
+  int32_t  pad;
+} chpl_vdebug_rec_fork_t;
+
+// tag, pause, and end.  Times are in microseconds from getrusage().
+typedef struct {
+  chpl_vdebug_rec_hdr_t hdr;
+  uint64_t taskID;
+  int64_t  tagno;       // unused for end
+  int64_t  userUsec;
+  int64_t  sysUsec;
+} chpl_vdebug_rec_tag_t;
+
+// tagname, followed by the name (not NUL terminated) and padding
+typedef struct {
+  chpl_vdebug_rec_hdr_t hdr;
+  int32_t  tagno;
+  int32_t  length;
+} chpl_vdebug_rec_tagname_t;
+
+#endif
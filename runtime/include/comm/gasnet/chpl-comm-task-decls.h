@@ -27,6 +27,7 @@
 
 typedef struct {
     chpl_cache_taskPrvData_t cache_data;
+    void* agg_buff;     // aggregated GET/PUT buffers
 } chpl_comm_taskPrvData_t;
 
 //
@@ -25,9 +25,17 @@
 
 #include <sys/types.h>
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 #include <wchar.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 #include "utf8-decoder.h"
 
 
@@ -197,32 +205,157 @@ int chpl_enc_decode_char_buf_wctype(int32_t* CHPL_ENC_RESTRICT chr,
 #endif
 }
 
+static inline
+int chpl_enc_ctz32(uint32_t x) {
+#if defined(__GNUC__)
+  return __builtin_ctz(x);
+#else
+  int n = 0;
+  while ((x & 1) == 0) {
+    x >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+static inline
+int chpl_enc_popcount32(uint32_t x) {
+#if defined(__GNUC__)
+  return __builtin_popcount(x);
+#else
+  int n = 0;
+  for (; x != 0; x &= x - 1) n++;
+  return n;
+#endif
+}
+
+/*
+ * Returns the length of the longest prefix of `buf` that consists of ASCII
+ * bytes only.  The buffer is scanned 32 (AVX2) or 16 (SSE2) bytes at a time
+ * when the target supports it, and 8 bytes at a time otherwise.
+ */
+static inline
+ssize_t chpl_enc_ascii_prefix_len(const char* buf, ssize_t buflen) {
+  const unsigned char* s = (const unsigned char*) buf;
+  ssize_t i = 0;
+
+#if defined(__AVX2__)
+  for (; i + 32 <= buflen; i += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i*)(s + i));
+    uint32_t mask = (uint32_t) _mm256_movemask_epi8(v);
+    if (mask != 0) return i + chpl_enc_ctz32(mask);
+  }
+#endif
+#if defined(__SSE2__)
+  for (; i + 16 <= buflen; i += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+    uint32_t mask = (uint32_t) _mm_movemask_epi8(v);
+    if (mask != 0) return i + chpl_enc_ctz32(mask);
+  }
+#endif
+  for (; i + 8 <= buflen; i += 8) {
+    uint64_t w;
+    memcpy(&w, s + i, sizeof(w));
+    if (w & UINT64_C(0x8080808080808080)) break;
+  }
+  for (; i < buflen; i++) {
+    if (s[i] & 0x80) break;
+  }
+  return i;
+}
+
+/*
+ * Counts the codepoints in a correctly encoded UTF8 buffer by counting the
+ * bytes that are not continuation bytes (0b10xxxxxx).
+ */
+static inline
+int64_t chpl_enc_count_codepoints(const char* buf, ssize_t buflen) {
+  const unsigned char* s = (const unsigned char*) buf;
+  int64_t n = 0;
+  ssize_t i = 0;
+
+  // As signed bytes, continuation bytes are exactly those <= (int8_t)0xbf
+#if defined(__AVX2__)
+  {
+    const __m256i lastCont = _mm256_set1_epi8((char) 0xbf);
+    for (; i + 32 <= buflen; i += 32) {
+      __m256i v = _mm256_loadu_si256((const __m256i*)(s + i));
+      __m256i initial = _mm256_cmpgt_epi8(v, lastCont);
+      n += chpl_enc_popcount32((uint32_t) _mm256_movemask_epi8(initial));
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  {
+    const __m128i lastCont = _mm_set1_epi8((char) 0xbf);
+    for (; i + 16 <= buflen; i += 16) {
+      __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+      __m128i initial = _mm_cmpgt_epi8(v, lastCont);
+      n += chpl_enc_popcount32((uint32_t) _mm_movemask_epi8(initial));
+    }
+  }
+#endif
+  for (; i < buflen; i++) {
+    n += ((s[i] & 0xc0) != 0x80);
+  }
+  return n;
+}
+
 /*
  * Check if the bytes in the char buffer form a valid UTF8 sequence
  *
+ * Runs of ASCII bytes are skipped in bulk by chpl_enc_ascii_prefix_len, so
+ * only the non-ASCII parts of the buffer are decoded a byte at a time.
+ *
  * :arg buflen: Upper limit for number of bytes to read
+ * :arg num_cp: Set to the number of codepoints in the buffer if it is valid
+ * :arg allow_escape: Whether escaped bytes (see chpl_enc_check_escape) are
+ *                    accepted as valid codepoints
  *
  * :returns: 0 if valid, -1 if illegal byte sequence
  */
 static inline
-int chpl_enc_validate_buf(const char *buf, ssize_t buflen, int64_t *num_cp) {
-  int32_t cp;
-  int nbytes;
+int chpl_enc_validate_buf_esc(const char *buf, ssize_t buflen, int64_t *num_cp,
+                              int allow_escape) {
+  const char* p = buf;
+  const char* end = buf + buflen;
+  int64_t n = 0;
 
-  int offset = 0;
   *num_cp = 0;
-  while (offset<buflen) {
-    // you can create a chapel string with a codepoint that represents an
-    // escaped byte, so the last argument is true
-    if (chpl_enc_decode_char_buf_utf8(&cp, &nbytes, buf+offset,
-                                      buflen-offset, true) != 0) {
-      return -1;  // invalid : return EILSEQ
+  while (p < end) {
+    const ssize_t nAscii = chpl_enc_ascii_prefix_len(p, end - p);
+    p += nAscii;
+    n += nAscii;
+
+    while (p < end && (*(const unsigned char*) p & 0x80)) {
+      uint32_t codepoint = 0, state = UTF8_ACCEPT;
+      const char* q = p;
+      do {
+        chpl_enc_utf8_decode(&state, &codepoint, *(const unsigned char*) q);
+        q++;
+      } while (q < end && state != UTF8_ACCEPT && state != UTF8_REJECT);
+
+      if (state == UTF8_ACCEPT) {
+        p = q;
+      } else if (allow_escape && chpl_enc_check_escape(p, end) > 0) {
+        // you can create a chapel string with a codepoint that represents
+        // an escaped byte
+        p += 3;
+      } else {
+        return -1;  // invalid : return EILSEQ
+      }
+      n += 1;
     }
-    offset += nbytes;
-    *num_cp += 1;
   }
+  *num_cp = n;
   return 0;  // valid
 }
 
+static inline
+int chpl_enc_validate_buf(const char *buf, ssize_t buflen, int64_t *num_cp) {
+  return chpl_enc_validate_buf_esc(buf, buflen, num_cp, true);
+}
+
 #endif
 
@@ -142,6 +142,40 @@ int64_t qio_regexp_replace(qio_regexp_t* regexp, const char* repl, int64_t repl_
 //
 qioerr qio_regexp_channel_match(const qio_regexp_t* regexp, const int threadsafe, struct qio_channel_s* ch, int64_t maxlen, int anchor, qio_bool can_discard, qio_bool keep_unmatched, qio_bool keep_whole_pattern, qio_regexp_string_piece_t* submatch, int64_t nsubmatch);
 
+// A set of regular expressions that are all matched in one pass over the
+// text.  Sets are reference counted like qio_regexp_t; all of the patterns are
+// added by qio_regexp_set_create_compile and the set cannot change afterwards.
+typedef struct qio_regexp_set_s {
+  void* set;
+} qio_regexp_set_t;
+
+static inline
+qio_regexp_set_t qio_regexp_set_null(void)
+{
+  qio_regexp_set_t ret;
+  ret.set = NULL;
+  return ret;
+}
+
+// Compiles npatterns patterns, pattern i being strs[i] with length
+// str_lens[i].  If a pattern fails to parse or the set can't be compiled,
+// *err_idx is set to the index of the bad pattern (or npatterns if the
+// compile failed) and *err_str is set to an error message that must be freed
+// by the caller.  Otherwise *err_idx is -1 and *err_str is NULL.
+void qio_regexp_set_create_compile(const char** strs, const int64_t* str_lens, int64_t npatterns, const qio_regexp_options_t* options, qio_regexp_set_t* compiled, int64_t* err_idx, const char** err_str);
+
+void qio_regexp_set_retain(const qio_regexp_set_t* set);
+void qio_regexp_set_release(qio_regexp_set_t* set);
+
+// A null set (see qio_regexp_set_null) has no patterns and matches nothing.
+int64_t qio_regexp_set_size(const qio_regexp_set_t* set);
+
+// Matches all of the patterns in the set against text.  Stores the indices
+// of up to max_ids matching patterns, in increasing order, in ids, and
+// returns the total number of patterns that matched.  If ids is NULL, only
+// reports whether any pattern matched (returning 1 or 0), which is faster.
+int64_t qio_regexp_set_match(const qio_regexp_set_t* set, const char* text, int64_t text_len, int64_t* ids, int64_t max_ids);
+
 #ifdef __cplusplus
 } // end extern "C"
 #endif
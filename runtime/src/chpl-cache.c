@@ -2968,6 +2968,26 @@ void chpl_cache_comm_getput_unordered_task_fence(void)
   chpl_comm_getput_unordered_task_fence();
 }
 
+void chpl_cache_comm_put_aggregated(void* addr, c_nodeid_t node, void* raddr,
+                                    size_t size, int32_t commID, int ln, int32_t fn)
+{
+  struct rdcache_s* cache = tls_cache_remote_data();
+  cache_lock(cache);
+  cache_invalidate(cache, node, (raddr_t)raddr, size);
+  cache_unlock(cache);
+  chpl_comm_put_aggregated(addr, node, raddr, size, commID, ln, fn);
+}
+
+void chpl_cache_comm_get_aggregated(void *addr, c_nodeid_t node, void* raddr,
+                                    size_t size, int32_t commID, int ln, int32_t fn)
+{
+  struct rdcache_s* cache = tls_cache_remote_data();
+  cache_lock(cache);
+  cache_invalidate(cache, node, (raddr_t)raddr, size);
+  cache_unlock(cache);
+  chpl_comm_get_aggregated(addr, node, raddr, size, commID, ln, fn);
+}
+
 // This is for debugging.
 void chpl_cache_print(void)
 {
@@ -28,12 +28,15 @@
 #include "chpl-comm.h"
 #include "chpl-comm-diags.h"
 #include "chpl-comm-internal.h"
+#include "chpl-mem.h"
 #include "chpl-mem-consistency.h"
 #include "error.h"
 
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 int chpl_verbose_comm = 0;
 int chpl_verbose_comm_stacktrace = 0;
@@ -41,11 +44,254 @@ int chpl_comm_diagnostics = 0;
 int chpl_comm_diags_print_unstable = 0;
 
 atomic_int_least16_t chpl_comm_diags_disable_flag;
-chpl_atomic_commDiagnostics chpl_comm_diags_counters;
+CHPL_TLS_DECL(chpl_comm_diags_shard_t*, chpl_comm_diags_my_shard);
+
+static chpl_comm_diags_shard_t* shards = NULL;
+static pthread_mutex_t shards_lock = PTHREAD_MUTEX_INITIALIZER;
+
+//
+// Per-thread per-site tables are open-addressed with linear probing.
+// Sites that don't fit are counted in the thread's last entry, which
+// reports commID -1 and no line or file.
+//
+#define SITE_TABLE_SIZE 1024
+#define SITE_SHARD_ALIGN 64
 
 static pthread_once_t bcastPrintUnstable_once = PTHREAD_ONCE_INIT;
 
 
+void chpl_comm_diags_init(void) {
+  CHPL_TLS_INIT(chpl_comm_diags_my_shard);
+  atomic_init_int_least16_t(&chpl_comm_diags_disable_flag, 0);
+}
+
+
+chpl_comm_diags_shard_t* chpl_comm_diags_new_shard(void) {
+  chpl_comm_diags_shard_t* shard;
+  size_t size;
+
+  // Round up so no other data shares the shard's cache lines.
+  size = (sizeof(*shard) + SITE_SHARD_ALIGN - 1) & ~(SITE_SHARD_ALIGN - 1);
+  shard = chpl_mem_memalign(SITE_SHARD_ALIGN, size,
+                            CHPL_RT_MD_COMM_UTIL, 0, 0);
+#define _COMM_DIAGS_INIT(cdv) \
+        atomic_init_uint_least64_t(&shard->counters.cdv, 0);
+  CHPL_COMM_DIAGS_VARS_ALL(_COMM_DIAGS_INIT);
+#undef _COMM_DIAGS_INIT
+  shard->sites = NULL;
+
+  pthread_mutex_lock(&shards_lock);
+  shard->next = shards;
+  shards = shard;
+  pthread_mutex_unlock(&shards_lock);
+
+  CHPL_TLS_SET(chpl_comm_diags_my_shard, shard);
+  return shard;
+}
+
+
+void chpl_comm_diags_reset(void) {
+  chpl_comm_diags_shard_t* shard;
+  int i;
+
+  pthread_mutex_lock(&shards_lock);
+  for (shard = shards; shard != NULL; shard = shard->next) {
+#define _COMM_DIAGS_RESET(cdv) \
+        atomic_store_uint_least64_t(&shard->counters.cdv, 0);
+    CHPL_COMM_DIAGS_VARS_ALL(_COMM_DIAGS_RESET);
+#undef _COMM_DIAGS_RESET
+    if (shard->sites != NULL) {
+      for (i = 0; i < SITE_TABLE_SIZE; i++) {
+        atomic_store_uint_least64_t(&shard->sites[i].count, 0);
+        atomic_store_uint_least64_t(&shard->sites[i].numBytes, 0);
+        atomic_store_uint_least64_t(&shard->sites[i].time, 0);
+      }
+    }
+  }
+  pthread_mutex_unlock(&shards_lock);
+}
+
+
+void chpl_comm_diags_copy(chpl_commDiagnostics* cd) {
+  chpl_comm_diags_shard_t* shard;
+
+  memset(cd, 0, sizeof(*cd));
+  pthread_mutex_lock(&shards_lock);
+  for (shard = shards; shard != NULL; shard = shard->next) {
+#define _COMM_DIAGS_COPY(cdv) \
+        cd->cdv += atomic_load_uint_least64_t(&shard->counters.cdv);
+    CHPL_COMM_DIAGS_VARS_ALL(_COMM_DIAGS_COPY);
+#undef _COMM_DIAGS_COPY
+  }
+  pthread_mutex_unlock(&shards_lock);
+}
+
+
+static
+chpl_comm_diags_site_t* site_table_alloc(void) {
+  chpl_comm_diags_site_t* sites;
+  int i;
+
+  sites = chpl_mem_allocMany(SITE_TABLE_SIZE, sizeof(*sites),
+                             CHPL_RT_MD_COMM_UTIL, 0, 0);
+  for (i = 0; i < SITE_TABLE_SIZE; i++) {
+    atomic_init_bool(&sites[i].inUse, false);
+    atomic_init_uint_least64_t(&sites[i].count, 0);
+    atomic_init_uint_least64_t(&sites[i].numBytes, 0);
+    atomic_init_uint_least64_t(&sites[i].time, 0);
+  }
+
+  // The overflow entry
+  sites[SITE_TABLE_SIZE - 1].kind = -1;
+  sites[SITE_TABLE_SIZE - 1].commID = -1;
+  sites[SITE_TABLE_SIZE - 1].lineno = 0;
+  sites[SITE_TABLE_SIZE - 1].filename = 0;
+  atomic_store_bool(&sites[SITE_TABLE_SIZE - 1].inUse, true);
+  return sites;
+}
+
+
+static inline
+uint32_t site_hash(int32_t kind, int32_t commID, int ln, int32_t fn) {
+  uint64_t h = ((uint64_t) (uint32_t) commID << 32) ^ (uint32_t) ln;
+  h ^= ((uint64_t) (uint32_t) fn << 40) ^ ((uint64_t) kind << 20);
+  h *= 0x9e3779b97f4a7c15ULL;
+  return (uint32_t) (h >> 32);
+}
+
+
+void chpl_comm_diags_site_record(chpl_comm_diags_site_kind_t kind,
+                                 size_t size, int32_t commID,
+                                 int ln, int32_t fn, uint64_t startTime) {
+  chpl_comm_diags_shard_t* shard = chpl_comm_diags_shard();
+  chpl_comm_diags_site_t* site = NULL;
+  uint64_t now = chpl_comm_diags_site_start();
+  uint32_t i, h;
+
+  if (shard->sites == NULL)
+    shard->sites = site_table_alloc();
+
+  // Find the entry for this site, or claim an empty one.  The last
+  // entry is reserved for overflow.
+  h = site_hash(kind, commID, ln, fn);
+  for (i = 0; i < SITE_TABLE_SIZE - 1; i++) {
+    chpl_comm_diags_site_t* s =
+      &shard->sites[(h + i) & (SITE_TABLE_SIZE - 1)];
+    if (s == &shard->sites[SITE_TABLE_SIZE - 1])
+      continue;
+    if (!atomic_load_bool(&s->inUse)) {
+      s->kind = kind;
+      s->commID = commID;
+      s->lineno = ln;
+      s->filename = fn;
+      atomic_store_bool(&s->inUse, true);
+      site = s;
+      break;
+    }
+    if (s->kind == (int32_t) kind && s->commID == commID
+        && s->lineno == ln && s->filename == fn) {
+      site = s;
+      break;
+    }
+  }
+  if (site == NULL)
+    site = &shard->sites[SITE_TABLE_SIZE - 1];
+
+  (void) atomic_fetch_add_uint_least64_t(&site->count, 1);
+  (void) atomic_fetch_add_uint_least64_t(&site->numBytes, size);
+  if (now > startTime)
+    (void) atomic_fetch_add_uint_least64_t(&site->time, now - startTime);
+}
+
+
+static
+int site_compare(const void* va, const void* vb) {
+  const chpl_commSiteDiagnostics* a = (const chpl_commSiteDiagnostics*) va;
+  const chpl_commSiteDiagnostics* b = (const chpl_commSiteDiagnostics*) vb;
+  if (a->kind != b->kind) return (a->kind < b->kind) ? -1 : 1;
+  if (a->commID != b->commID) return (a->commID < b->commID) ? -1 : 1;
+  if (a->filename != b->filename) return (a->filename < b->filename) ? -1 : 1;
+  if (a->lineno != b->lineno) return (a->lineno < b->lineno) ? -1 : 1;
+  return 0;
+}
+
+
+// Heaviest sites first; ties are broken by site so the order is stable.
+static
+int site_compare_volume(const void* va, const void* vb) {
+  const chpl_commSiteDiagnostics* a = (const chpl_commSiteDiagnostics*) va;
+  const chpl_commSiteDiagnostics* b = (const chpl_commSiteDiagnostics*) vb;
+  if (a->numBytes != b->numBytes) return (a->numBytes > b->numBytes) ? -1 : 1;
+  if (a->count != b->count) return (a->count > b->count) ? -1 : 1;
+  return site_compare(va, vb);
+}
+
+
+size_t chpl_comm_getSiteDiagnosticsHere(chpl_commSiteDiagnostics* sd,
+                                        size_t max) {
+  chpl_comm_diags_shard_t* shard;
+  chpl_commSiteDiagnostics* all;
+  size_t n, nAll, i;
+
+  pthread_mutex_lock(&shards_lock);
+
+  // Gather the entries from all of the threads
+  nAll = 0;
+  for (shard = shards; shard != NULL; shard = shard->next) {
+    if (shard->sites != NULL)
+      nAll += SITE_TABLE_SIZE;
+  }
+  if (nAll == 0) {
+    pthread_mutex_unlock(&shards_lock);
+    return 0;
+  }
+  all = chpl_mem_allocMany(nAll, sizeof(*all), CHPL_RT_MD_COMM_UTIL, 0, 0);
+  n = 0;
+  for (shard = shards; shard != NULL; shard = shard->next) {
+    if (shard->sites == NULL)
+      continue;
+    for (i = 0; i < SITE_TABLE_SIZE; i++) {
+      chpl_comm_diags_site_t* s = &shard->sites[i];
+      if (!atomic_load_bool(&s->inUse))
+        continue;
+      all[n].kind = s->kind;
+      all[n].commID = s->commID;
+      all[n].lineno = s->lineno;
+      all[n].filename = s->filename;
+      all[n].count = atomic_load_uint_least64_t(&s->count);
+      all[n].numBytes = atomic_load_uint_least64_t(&s->numBytes);
+      all[n].time = atomic_load_uint_least64_t(&s->time);
+      if (all[n].count != 0)
+        n++;
+    }
+  }
+  pthread_mutex_unlock(&shards_lock);
+
+  // Merge the entries for the same site
+  nAll = n;
+  n = 0;
+  if (nAll > 0) {
+    qsort(all, nAll, sizeof(*all), site_compare);
+    for (i = 1; i < nAll; i++) {
+      if (site_compare(&all[n], &all[i]) == 0) {
+        all[n].count += all[i].count;
+        all[n].numBytes += all[i].numBytes;
+        all[n].time += all[i].time;
+      } else {
+        all[++n] = all[i];
+      }
+    }
+    n++;
+    qsort(all, n, sizeof(*all), site_compare_volume);
+  }
+
+  if (sd != NULL)
+    memcpy(sd, all, ((n < max) ? n : max) * sizeof(*all));
+  chpl_mem_free(all, 0, 0);
+  return n;
+}
+
+
 static
 void broadcast_print_unstable(void) {
   chpl_comm_diags_disable();
@@ -21,6 +21,7 @@
 #include "chplrt.h"
 #include "chpl-string.h"
 #include "chpl-gen-includes.h"
+#include "chpl-mem.h"
 
 struct chpl_chpl____wide_chpl_string_s {
   chpl_localeID_t locale;
@@ -47,3 +48,80 @@ uint8_t* chpl__getInPlaceBufferData(chpl__inPlaceBuffer* buf) {
 uint8_t* chpl__getInPlaceBufferDataForWrite(chpl__inPlaceBuffer* buf) {
   return chpl__getInPlaceBufferData(buf);
 }
+
+typedef struct {
+  int64_t num_entries;
+  int64_t offsets[];  // offsets[k] is the byte offset of codepoint k*STRIDE
+} chpl_string_cp_index;
+
+static inline int is_initial_byte(uint8_t c) {
+  return (c & 0xc0) != 0x80;
+}
+
+static chpl_string_cp_index* build_cp_index(const uint8_t* buf,
+                                            int64_t buflen, int64_t num_cp) {
+  const int64_t max_entries = (num_cp + CHPL_STRING_CP_INDEX_STRIDE - 1) /
+                              CHPL_STRING_CP_INDEX_STRIDE;
+  chpl_string_cp_index* index =
+    chpl_mem_alloc(sizeof(chpl_string_cp_index) +
+                   max_entries * sizeof(int64_t),
+                   CHPL_RT_MD_STR_CP_INDEX, 0, 0);
+  int64_t cp = 0, k = 0;
+  for (int64_t i = 0; i < buflen && k < max_entries; i++) {
+    if (is_initial_byte(buf[i])) {
+      if (cp % CHPL_STRING_CP_INDEX_STRIDE == 0)
+        index->offsets[k++] = i;
+      cp++;
+    }
+  }
+  index->num_entries = k;
+  return index;
+}
+
+// Advance from the codepoint starting at byte offset `off` by `n` codepoints.
+static inline int64_t skip_codepoints(const uint8_t* buf, int64_t buflen,
+                                      int64_t off, int64_t n) {
+  while (n > 0 && off < buflen) {
+    off++;
+    while (off < buflen && !is_initial_byte(buf[off]))
+      off++;
+    n--;
+  }
+  return off;
+}
+
+int64_t chpl_string_cp_to_byte_offset(void** cp_index,
+                                      const uint8_t* buf, int64_t buflen,
+                                      int64_t num_cp, int64_t cp_idx) {
+  if (cp_idx <= 0)
+    return 0;
+  if (cp_idx >= num_cp)
+    return buflen;
+
+#if defined(__GNUC__)
+  chpl_string_cp_index* index = __atomic_load_n(cp_index, __ATOMIC_ACQUIRE);
+  if (index == NULL) {
+    void* expected = NULL;
+    index = build_cp_index(buf, buflen, num_cp);
+    if (!__atomic_compare_exchange_n(cp_index, &expected, (void*) index, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      // another task published its index first; use that one
+      chpl_mem_free(index, 0, 0);
+      index = expected;
+    }
+  }
+
+  int64_t k = cp_idx / CHPL_STRING_CP_INDEX_STRIDE;
+  if (k >= index->num_entries)
+    k = index->num_entries - 1;
+  return skip_codepoints(buf, buflen, index->offsets[k],
+                         cp_idx - k * CHPL_STRING_CP_INDEX_STRIDE);
+#else
+  // Without atomics to publish the index safely, walk from the start.
+  return skip_codepoints(buf, buflen, 0, cp_idx);
+#endif
+}
+
+void chpl_string_free_cp_index(void* cp_index) {
+  chpl_mem_free(cp_index, 0, 0);
+}
@@ -23,24 +23,31 @@
 //
 
 #include "chpl-visual-debug.h"
+#include "chpl-visual-debug-format.h"
 #include "chplrt.h"
+#include "chpl-atomics.h"
 #include "chpl-comm.h"
 #include "chpl-tasks.h"
 #include "chpl-tasks-callbacks.h"
 #include "chpl-comm-callbacks.h"
 #include "chpl-linefile-support.h"
+#include "chpl-thread-local-storage.h"
 #include <stdint.h>
 #include <string.h>
 #include <unistd.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdarg.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <pthread.h>
+#include <time.h>
 #include <sys/types.h>
 #include <sys/time.h>
 #include <sys/stat.h>
 #include <sys/resource.h>
 #include <sys/param.h>
+#include <sys/uio.h>
 
 #include "chplcgfns.h"
 
@@ -67,9 +74,6 @@ int chpl_vdebug = 0;
 
 #define TID_STRING(buff, tid) (chpl_task_idToString(buff, CHPL_TASK_ID_STRING_MAX_LEN, tid))
 
-#define VDEBUG_GETPUT_FORMAT_NAMES "kind tv srcNodeID dstNodeID commTaskID addr raddr elemSize length commID lineNumber fileno"
-#define VDEBUG_GETPUT_FORMAT_STRING "%s: %lld.%06ld %d %d %s %#lx %#lx %zd %zd %d %d %d\n"
-
 int chpl_dprintf (int fd, const char * format, ...) {
   char buffer[2048]; 
   va_list ap;
@@ -87,6 +91,178 @@ int chpl_dprintf (int fd, const char * format, ...) {
   return -1;
 }
 
+//
+// Event records are written in binary (see chpl-visual-debug-format.h)
+// to a ring buffer owned by the thread that generates them, so recording
+// an event is a clock read and a copy.  A background thread periodically
+// appends the contents of every ring to the data file.  A thread that
+// fills its ring before then writes it out itself.  Each ring is written
+// with one O_APPEND write, so the records of different rings don't
+// interleave within a record.
+//
+// Rings are never freed, since their threads may log again after a
+// stop and start.
+//
+
+#define VDEBUG_RING_SIZE (64 * 1024)
+
+// How often the background thread writes out the rings, in nanoseconds
+#define VDEBUG_FLUSH_INTERVAL 20000000
+
+typedef struct vdebug_ring_s {
+  atomic_uint_least64_t head;     // total bytes ever put in the ring
+  atomic_uint_least64_t tail;     // total bytes ever written to the file
+  pthread_mutex_t flushLock;      // held while writing the ring out
+  struct vdebug_ring_s *next;
+  char buf[VDEBUG_RING_SIZE];
+} vdebug_ring_t;
+
+static CHPL_TLS_DECL(vdebug_ring_t *, vdebug_thread_ring);
+static int vdebug_tls_inited = 0;
+
+static vdebug_ring_t *vdebug_rings = NULL;
+static pthread_mutex_t vdebug_rings_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_t vdebug_flusher;
+static atomic_bool vdebug_flusher_run;
+static int vdebug_flusher_started = 0;
+
+static inline uint64_t vdebug_now (void) {
+  struct timespec ts;
+  (void) clock_gettime (CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + (uint64_t) ts.tv_nsec;
+}
+
+static vdebug_ring_t *vdebug_get_ring (void) {
+  vdebug_ring_t *ring = (vdebug_ring_t *) CHPL_TLS_GET(vdebug_thread_ring);
+  if (ring == NULL) {
+    ring = (vdebug_ring_t *) malloc (sizeof (vdebug_ring_t));
+    if (ring == NULL)
+      return NULL;
+    atomic_init_uint_least64_t (&ring->head, 0);
+    atomic_init_uint_least64_t (&ring->tail, 0);
+    pthread_mutex_init (&ring->flushLock, NULL);
+    pthread_mutex_lock (&vdebug_rings_lock);
+    ring->next = vdebug_rings;
+    vdebug_rings = ring;
+    pthread_mutex_unlock (&vdebug_rings_lock);
+    CHPL_TLS_SET(vdebug_thread_ring, ring);
+  }
+  return ring;
+}
+
+// Write everything in the ring to the data file.  Only the owning thread
+// adds to the ring, so it can keep doing that while this runs.
+static void vdebug_flush_ring (vdebug_ring_t *ring) {
+  uint64_t tail, head;
+  size_t off, len;
+  struct iovec iov[2];
+  int niov = 0;
+
+  pthread_mutex_lock (&ring->flushLock);
+  tail = atomic_load_explicit_uint_least64_t (&ring->tail, memory_order_relaxed);
+  head = atomic_load_explicit_uint_least64_t (&ring->head, memory_order_acquire);
+  if (head != tail) {
+    off = tail % VDEBUG_RING_SIZE;
+    len = head - tail;
+    if (off + len > VDEBUG_RING_SIZE) {
+      iov[niov].iov_base = ring->buf + off;
+      iov[niov].iov_len = VDEBUG_RING_SIZE - off;
+      len -= iov[niov].iov_len;
+      off = 0;
+      niov++;
+    }
+    iov[niov].iov_base = ring->buf + off;
+    iov[niov].iov_len = len;
+    niov++;
+    if (chpl_vdebug_fd >= 0)
+      (void) writev (chpl_vdebug_fd, iov, niov);
+    atomic_store_explicit_uint_least64_t (&ring->tail, head, memory_order_release);
+  }
+  pthread_mutex_unlock (&ring->flushLock);
+}
+
+static void vdebug_flush_all (void) {
+  vdebug_ring_t *ring;
+  pthread_mutex_lock (&vdebug_rings_lock);
+  for (ring = vdebug_rings; ring != NULL; ring = ring->next)
+    vdebug_flush_ring (ring);
+  pthread_mutex_unlock (&vdebug_rings_lock);
+}
+
+static void *vdebug_flusher_main (void *arg) {
+  struct timespec interval = { 0, VDEBUG_FLUSH_INTERVAL };
+  while (atomic_load_bool (&vdebug_flusher_run)) {
+    (void) nanosleep (&interval, NULL);
+    vdebug_flush_all ();
+  }
+  return NULL;
+}
+
+static void vdebug_start_flusher (void) {
+  if (vdebug_flusher_started)
+    return;
+  atomic_store_bool (&vdebug_flusher_run, true);
+  if (pthread_create (&vdebug_flusher, NULL, vdebug_flusher_main, NULL) == 0)
+    vdebug_flusher_started = 1;
+}
+
+static void vdebug_stop_flusher (void) {
+  if (!vdebug_flusher_started)
+    return;
+  atomic_store_bool (&vdebug_flusher_run, false);
+  (void) pthread_join (vdebug_flusher, NULL);
+  vdebug_flusher_started = 0;
+}
+
+// Fill in a record header
+static inline void vdebug_hdr (chpl_vdebug_rec_hdr_t *hdr,
+                               chpl_vdebug_rec_kind_t kind, size_t size,
+                               int nodeID) {
+  hdr->kind = kind;
+  hdr->size = size;
+  hdr->nodeID = nodeID;
+  hdr->time = vdebug_now ();
+}
+
+// Add a record to this thread's ring
+static void vdebug_log (const void *rec, size_t size) {
+  vdebug_ring_t *ring = vdebug_get_ring ();
+  uint64_t head, tail;
+  size_t off, first;
+
+  if (ring == NULL)
+    return;
+  head = atomic_load_explicit_uint_least64_t (&ring->head, memory_order_relaxed);
+  tail = atomic_load_explicit_uint_least64_t (&ring->tail, memory_order_acquire);
+  if (VDEBUG_RING_SIZE - (head - tail) < size)
+    vdebug_flush_ring (ring);
+  off = head % VDEBUG_RING_SIZE;
+  first = size < VDEBUG_RING_SIZE - off ? size : VDEBUG_RING_SIZE - off;
+  memcpy (ring->buf + off, rec, first);
+  memcpy (ring->buf, (const char *) rec + first, size - first);
+  atomic_store_explicit_uint_least64_t (&ring->head, head + size, memory_order_release);
+}
+
+static void vdebug_get_rusage (int64_t *userUsec, int64_t *sysUsec) {
+  struct rusage ru;
+  if ( getrusage (RUSAGE_SELF, &ru) < 0) {
+    *userUsec = *sysUsec = 0;
+  } else {
+    *userUsec = (int64_t) ru.ru_utime.tv_sec * 1000000 + ru.ru_utime.tv_usec;
+    *sysUsec = (int64_t) ru.ru_stime.tv_sec * 1000000 + ru.ru_stime.tv_usec;
+  }
+}
+
+static void vdebug_log_tag (chpl_vdebug_rec_kind_t kind, int tagno) {
+  chpl_vdebug_rec_tag_t rec;
+  vdebug_hdr (&rec.hdr, kind, sizeof (rec), chpl_nodeID);
+  rec.taskID = (uint64_t) chpl_task_getId();
+  rec.tagno = tagno;
+  vdebug_get_rusage (&rec.userUsec, &rec.sysUsec);
+  vdebug_log (&rec, sizeof (rec));
+}
+
 static int chpl_make_vdebug_file (const char *rootname) {
     char fname[MAXPATHLEN]; 
     struct stat sb;
@@ -120,18 +296,25 @@ static int chpl_make_vdebug_file (const char *rootname) {
 
 // Record>  ChplVdebug: ver # nid # tid # seq time.sec user.time system.time 
 //
-//  Ver # -- version number, currently 1.1
+//  Ver # -- version number, currently 2.0
 //  nid # -- nodeID
 //  tid # -- taskID
 //  seq time.sec -- unique number for this run
+//
+// Record>  Clock: nsec
+//
+//  The monotonic clock at time.sec in the first line.  This is the last
+//  text line, and is followed by binary records.
 
 void chpl_vdebug_start (const char *fileroot, double now) {
   const char * rootname;
   struct rusage ru;
   struct timeval tv;
+  uint64_t clock;
   chpl_taskID_t startTask = chpl_task_getId();
   char buff[CHPL_TASK_ID_STRING_MAX_LEN];
   (void) gettimeofday (&tv, NULL);
+  clock = vdebug_now ();
 
   install_callbacks();
 
@@ -149,6 +332,11 @@ void chpl_vdebug_start (const char *fileroot, double now) {
   // In case of an error, just return
   if (chpl_make_vdebug_file (rootname) < 0)
     return;
+
+  if (!vdebug_tls_inited) {
+    CHPL_TLS_INIT(vdebug_thread_ring);
+    vdebug_tls_inited = 1;
+  }
   
   // Write initial information to the file, including resource time
   if ( getrusage (RUSAGE_SELF, &ru) < 0) {
@@ -158,7 +346,8 @@ void chpl_vdebug_start (const char *fileroot, double now) {
     ru.ru_stime.tv_usec = 0;
   }
   chpl_dprintf (chpl_vdebug_fd,
-                "ChplVdebug: ver 1.4 nodes %d nid %d tid %s seq %.3lf %lld.%06ld %ld.%06ld %ld.%06ld \n",
+                "ChplVdebug: ver %d.%d nodes %d nid %d tid %s seq %.3lf %lld.%06ld %ld.%06ld %ld.%06ld \n",
+                CHPL_VDEBUG_VER_MAJOR, CHPL_VDEBUG_VER_MINOR,
                 chpl_numNodes, chpl_nodeID, TID_STRING(buff, startTask), now,
                 (long long) tv.tv_sec, (long) tv.tv_usec,
                 (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
@@ -192,6 +381,10 @@ void chpl_vdebug_start (const char *fileroot, double now) {
                     chpl_finfo[ix].lineno, chpl_finfo[ix].fileno,
                     chpl_finfo[ix].name);
   }
+
+  chpl_dprintf (chpl_vdebug_fd, "Clock: %llu\n", (unsigned long long) clock);
+
+  vdebug_start_flusher ();
   
   chpl_vdebug = 1;
 }
@@ -201,10 +394,7 @@ void chpl_vdebug_start (const char *fileroot, double now) {
 // Should be the last record in the file.
 
 void chpl_vdebug_stop (void) {
-  struct rusage ru;  
-  struct timeval tv;
-  chpl_taskID_t stopTask = chpl_task_getId();
-  char buff[CHPL_TASK_ID_STRING_MAX_LEN];
+  chpl_vdebug_rec_tag_t rec;
 
   // First, shutdown VisualDebug
   chpl_vdebug = 0;
@@ -212,20 +402,17 @@ void chpl_vdebug_stop (void) {
 
   // Now log the stop
   if (chpl_vdebug_fd >= 0) {
-    (void) gettimeofday (&tv, NULL);
-    if ( getrusage (RUSAGE_SELF, &ru) < 0) {
-      ru.ru_utime.tv_sec = 0;
-      ru.ru_utime.tv_usec = 0;
-      ru.ru_stime.tv_sec = 0;
-      ru.ru_stime.tv_usec = 0;
-    }
-    // Generate the End record
-    chpl_dprintf (chpl_vdebug_fd, "End: %lld.%06ld %ld.%06ld %ld.%06ld %d %s\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,
-                  (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
-                  (long) ru.ru_stime.tv_sec, (long) ru.ru_stime.tv_usec,
-                  chpl_nodeID, TID_STRING(buff, stopTask));
+    // Write out everything that was logged, then the End record
+    vdebug_stop_flusher ();
+    vdebug_flush_all ();
+
+    vdebug_hdr (&rec.hdr, chpl_vdebug_rec_end, sizeof (rec), chpl_nodeID);
+    rec.taskID = (uint64_t) chpl_task_getId();
+    rec.tagno = 0;
+    vdebug_get_rusage (&rec.userUsec, &rec.sysUsec);
+    (void) write (chpl_vdebug_fd, &rec, sizeof (rec));
     close (chpl_vdebug_fd);
+    chpl_vdebug_fd = -1;
   }
 }
 
@@ -236,268 +423,166 @@ void chpl_vdebug_stop (void) {
 // the xxxVdebug() call and chplvis should ignore them.
 
 void chpl_vdebug_mark (void) {
-  struct timeval tv;
-  chpl_taskID_t tagTask = chpl_task_getId();
-  char buff[CHPL_TASK_ID_STRING_MAX_LEN];
-  (void) gettimeofday (&tv, NULL);
-  chpl_dprintf (chpl_vdebug_fd, "VdbMark: %lld.%06ld %d %s\n",
-                (long long) tv.tv_sec, (long) tv.tv_usec, chpl_nodeID, TID_STRING(buff, tagTask) );
+  chpl_vdebug_rec_task_id_t rec;
+  if (chpl_vdebug_fd < 0) return;
+  vdebug_hdr (&rec.hdr, chpl_vdebug_rec_mark, sizeof (rec), chpl_nodeID);
+  rec.taskID = (uint64_t) chpl_task_getId();
+  vdebug_log (&rec, sizeof (rec));
 }
 
 // Record>  tname: tag# tagname
 
 void chpl_vdebug_tagname (const char* tagname, int tagno) {
-  chpl_dprintf (chpl_vdebug_fd, "tname: %d %s\n", tagno, tagname);
+  char buff[sizeof (chpl_vdebug_rec_tagname_t) + 256];
+  chpl_vdebug_rec_tagname_t *rec = (chpl_vdebug_rec_tagname_t *) buff;
+  size_t len = strlen (tagname);
+  size_t size;
+  if (chpl_vdebug_fd < 0) return;
+  if (len > 255) len = 255;
+  size = (sizeof (*rec) + len + 7) & ~(size_t) 7;
+  memset (buff, 0, size);
+  vdebug_hdr (&rec->hdr, chpl_vdebug_rec_tagname, size, chpl_nodeID);
+  rec->tagno = tagno;
+  rec->length = len;
+  memcpy (buff + sizeof (*rec), tagname, len);
+  vdebug_log (buff, size);
 }
 
 // Record>  Tag: time.sec user.time sys.time nodeId taskId tag# 
 
 void chpl_vdebug_tag (int tagno) {
-  struct rusage ru;
-  struct timeval tv;
-  
-  chpl_taskID_t tagTask = chpl_task_getId();
-  char buff[CHPL_TASK_ID_STRING_MAX_LEN];
-
-  (void) gettimeofday (&tv, NULL);
-  if ( getrusage (RUSAGE_SELF, &ru) < 0) {
-    ru.ru_utime.tv_sec = 0;
-    ru.ru_utime.tv_usec = 0;
-    ru.ru_stime.tv_sec = 0;
-    ru.ru_stime.tv_usec = 0;
-  }
-  chpl_dprintf (chpl_vdebug_fd, "Tag: %lld.%06ld %ld.%06ld %ld.%06ld %d %s %d\n",
-                (long long) tv.tv_sec, (long) tv.tv_usec,
-                (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
-                (long) ru.ru_stime.tv_sec, (long) ru.ru_stime.tv_usec,
-                chpl_nodeID, TID_STRING(buff, tagTask), tagno);
+  if (chpl_vdebug_fd < 0) return;
+  vdebug_log_tag (chpl_vdebug_rec_tag, tagno);
   chpl_vdebug = 1;
 }
 
 // Record>  Pause: time.sec user.time sys.time nodeId taskId tag#
 
 void chpl_vdebug_pause (int tagno) {
-  struct rusage ru;
-  struct timeval tv;
-  chpl_taskID_t pauseTask = chpl_task_getId();
-  char buff[CHPL_TASK_ID_STRING_MAX_LEN];
-
   if (chpl_vdebug_fd >=0 && chpl_vdebug == 1) {
-    (void) gettimeofday (&tv, NULL);
-    if ( getrusage (RUSAGE_SELF, &ru) < 0) {
-      ru.ru_utime.tv_sec = 0;
-      ru.ru_utime.tv_usec = 0;
-      ru.ru_stime.tv_sec = 0;
-      ru.ru_stime.tv_usec = 0;
-    }
-    chpl_dprintf (chpl_vdebug_fd, "Pause: %lld.%06ld %ld.%06ld %ld.%06ld %d %s %d\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,
-                  (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
-                  (long) ru.ru_stime.tv_sec, (long) ru.ru_stime.tv_usec,
-                  chpl_nodeID, TID_STRING(buff, pauseTask), tagno);
+    vdebug_log_tag (chpl_vdebug_rec_pause, tagno);
     chpl_vdebug = 0;
   }
 }
 
 // Routines to log data ... put here so other places can
 // just call this code to get things logged.
-// FIXME: the size argument (size_t) is being cast to int here. chplvis needs
-//        to be updated to take in size_t. The elemsize field is no longer
-//        relevant as well.
 
-// Record>  nb_put: time.sec srcNodeId dstNodeId commTaskId addr raddr elemsize 
-//                  length lineNumber fileName
+// Record>  put, get, nb_put, nb_get: time nodeId remoteNodeId commTaskId
+//                                    addr raddr elemsize length commID
+//                                    lineNumber fileName
 //
-
-void cb_comm_put_nb (const chpl_comm_cb_info_t *info) {
-  if (chpl_vdebug) {
-    struct timeval tv;
-    const struct chpl_comm_info_comm *cm = &info->iu.comm;
-    chpl_taskID_t commTask = chpl_task_getId();
-    char buff[CHPL_TASK_ID_STRING_MAX_LEN];
-    (void) gettimeofday (&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd, 
-                  VDEBUG_GETPUT_FORMAT_STRING, "nb_put",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,  info->localNodeID,
-                  info->remoteNodeID, TID_STRING(buff, commTask), (unsigned long) cm->addr,
-                  (unsigned long) cm->raddr, (size_t)1, cm->size,
-                  cm->commID, cm->lineno, cm->filename);
-  }
+// Note: for gets, nodeId is the node requesting the get
+
+static void vdebug_log_comm (chpl_vdebug_rec_kind_t kind,
+                             const chpl_comm_cb_info_t *info) {
+  chpl_vdebug_rec_comm_t rec;
+  const struct chpl_comm_info_comm *cm = &info->iu.comm;
+  vdebug_hdr (&rec.hdr, kind, sizeof (rec), info->localNodeID);
+  rec.remoteNodeID = info->remoteNodeID;
+  rec.commID = cm->commID;
+  rec.taskID = (uint64_t) chpl_task_getId();
+  rec.addr = (uint64_t) (uintptr_t) cm->addr;
+  rec.raddr = (uint64_t) (uintptr_t) cm->raddr;
+  rec.elemSize = 1;
+  rec.length = cm->size;
+  rec.lineno = cm->lineno;
+  rec.fileno = cm->filename;
+  vdebug_log (&rec, sizeof (rec));
 }
 
-// Record>  nb_get: time.sec dstNodeId srcNodeId commTaskId addr raddr elemsize 
-//                  length lineNumber fileName
-//
-// Note: dstNodeId is node requesting Get
+// Record>  st_put, st_get: same as put and get, with the total length
+//                          of the strided data
 
-void cb_comm_get_nb (const chpl_comm_cb_info_t *info) {
-  if (chpl_vdebug) {
-    struct timeval tv;
-    const struct chpl_comm_info_comm *cm = &info->iu.comm;
-    chpl_taskID_t commTask = chpl_task_getId();
-    char buff[CHPL_TASK_ID_STRING_MAX_LEN];
-    (void) gettimeofday (&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd,
-                  VDEBUG_GETPUT_FORMAT_STRING, "nb_get",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,  info->localNodeID,
-                  info->remoteNodeID, TID_STRING(buff, commTask), (unsigned long) cm->addr,
-                  (unsigned long) cm->raddr, (size_t)1, cm->size,
-                  cm->commID, cm->lineno, cm->filename);
+static void vdebug_log_comm_strd (chpl_vdebug_rec_kind_t kind,
+                                  const chpl_comm_cb_info_t *info) {
+  chpl_vdebug_rec_comm_t rec;
+  const struct chpl_comm_info_comm_strd *cm = &info->iu.comm_strd;
+  size_t length = 1;
+  for (int32_t i = 0; i < cm->stridelevels; i++) {
+    length *= cm->count[i];
+  }
+  vdebug_hdr (&rec.hdr, kind, sizeof (rec), info->localNodeID);
+  rec.remoteNodeID = info->remoteNodeID;
+  rec.commID = cm->commID;
+  rec.taskID = (uint64_t) chpl_task_getId();
+  if (kind == chpl_vdebug_rec_put_strd) {
+    rec.addr = (uint64_t) (uintptr_t) cm->srcaddr;
+    rec.raddr = (uint64_t) (uintptr_t) cm->dstaddr;
+  } else {
+    rec.addr = (uint64_t) (uintptr_t) cm->dstaddr;
+    rec.raddr = (uint64_t) (uintptr_t) cm->srcaddr;
   }
+  rec.elemSize = cm->elemSize;
+  rec.length = length;
+  rec.lineno = cm->lineno;
+  rec.fileno = cm->filename;
+  vdebug_log (&rec, sizeof (rec));
 }
 
-// Record>  put: time.sec srcNodeId dstNodeId commTaskId addr raddr elemsize 
-//               length lineNumber fileName
+// Record>  fork, fork_nb, f_fork: time nodeId forkNodeId subLoc funcId arg
+//                                 argSize forkTaskId lineNumber fileName
+
+static void vdebug_log_fork (chpl_vdebug_rec_kind_t kind,
+                             const chpl_comm_cb_info_t *info) {
+  chpl_vdebug_rec_fork_t rec;
+  const struct chpl_comm_info_comm_executeOn *cm = &info->iu.executeOn;
+  vdebug_hdr (&rec.hdr, kind, sizeof (rec), info->localNodeID);
+  rec.remoteNodeID = info->remoteNodeID;
+  rec.subloc = cm->subloc;
+  rec.taskID = (uint64_t) chpl_task_getId();
+  rec.arg = (uint64_t) (uintptr_t) cm->arg;
+  rec.argSize = cm->arg_size;
+  rec.fid = cm->fid;
+  rec.lineno = cm->lineno;
+  rec.fileno = cm->filename;
+  rec.pad = 0;
+  vdebug_log (&rec, sizeof (rec));
+}
 
+void cb_comm_put_nb (const chpl_comm_cb_info_t *info) {
+  if (chpl_vdebug)
+    vdebug_log_comm (chpl_vdebug_rec_put_nb, info);
+}
 
-void cb_comm_put (const chpl_comm_cb_info_t *info) {
-  if (chpl_vdebug) {
-    struct timeval tv;
-    const struct chpl_comm_info_comm *cm = &info->iu.comm;
-    chpl_taskID_t commTask = chpl_task_getId();
-    char buff[CHPL_TASK_ID_STRING_MAX_LEN];
-    (void) gettimeofday (&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd,
-                  VDEBUG_GETPUT_FORMAT_STRING, "put",
-                  (long long) tv.tv_sec, (long) tv.tv_usec, info->localNodeID,
-                  info->remoteNodeID, TID_STRING(buff, commTask), (unsigned long) cm->addr,
-                  (unsigned long) cm->raddr, (size_t)1, cm->size,
-                  cm->commID, cm->lineno, cm->filename);
-  }
+void cb_comm_get_nb (const chpl_comm_cb_info_t *info) {
+  if (chpl_vdebug)
+    vdebug_log_comm (chpl_vdebug_rec_get_nb, info);
 }
 
-// Record>  get: time.sec dstNodeId srcNodeId commTaskId addr raddr elemsize 
-//               length lineNumber fileName
-//
-// Note:  dstNodeId is for the node making the request
+void cb_comm_put (const chpl_comm_cb_info_t *info) {
+  if (chpl_vdebug)
+    vdebug_log_comm (chpl_vdebug_rec_put, info);
+}
 
 void cb_comm_get (const chpl_comm_cb_info_t *info) {
-  if (chpl_vdebug) {
-    struct timeval tv;
-    const struct chpl_comm_info_comm *cm = &info->iu.comm;
-    chpl_taskID_t commTask = chpl_task_getId();
-    char buff[CHPL_TASK_ID_STRING_MAX_LEN];
-    (void) gettimeofday (&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd,
-                  VDEBUG_GETPUT_FORMAT_STRING, "get",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,  info->localNodeID,
-                  info->remoteNodeID, TID_STRING(buff, commTask), (unsigned long) cm->addr,
-                  (unsigned long) cm->raddr, (size_t)1, cm->size,
-                  cm->commID, cm->lineno, cm->filename);
-  }
+  if (chpl_vdebug)
+    vdebug_log_comm (chpl_vdebug_rec_get, info);
 }
 
-// Record>  st_put: time.sec srcNodeId dstNodeId commTaskId addr raddr elemsize 
-//                  length lineNumber fileName
-
 void cb_comm_put_strd (const chpl_comm_cb_info_t *info) {
-    if (chpl_vdebug) {
-    struct timeval tv;
-    size_t length;
-    const struct chpl_comm_info_comm_strd *cm = &info->iu.comm_strd;
-    chpl_taskID_t commTask = chpl_task_getId();
-    char buff[CHPL_TASK_ID_STRING_MAX_LEN];
-    (void) gettimeofday (&tv, NULL);
-
-    length = 1;
-    for (int32_t i = 0; i < cm->stridelevels; i++) {
-      length *= cm->count[i];
-    }
-
-    chpl_dprintf (chpl_vdebug_fd,
-                  VDEBUG_GETPUT_FORMAT_STRING, "st_put",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,  info->localNodeID, 
-                  info->remoteNodeID, TID_STRING(buff, commTask),
-                  (unsigned long) cm->srcaddr, (unsigned long) cm->dstaddr, cm->elemSize,
-                  length, cm->commID, cm->lineno, cm->filename);
-    // printout srcstrides and dststrides and stridelevels and count?
-  }
-
+  if (chpl_vdebug)
+    vdebug_log_comm_strd (chpl_vdebug_rec_put_strd, info);
 }
 
-// Record>  st_get: time.sec dstNodeId srcNodeId commTaskId addr raddr elemsize 
-//                  length lineNumber fileName
-//
-// Note:  dstNode is node making request for get
-
 void cb_comm_get_strd (const chpl_comm_cb_info_t *info) {
-  if (chpl_vdebug) {
-    struct timeval tv;
-    size_t length;
-    const struct chpl_comm_info_comm_strd *cm = &info->iu.comm_strd;
-    chpl_taskID_t commTask = chpl_task_getId();
-    char buff[CHPL_TASK_ID_STRING_MAX_LEN];
-    (void) gettimeofday (&tv, NULL);
-
-    length = 1;
-    for (int32_t i = 0; i < cm->stridelevels; i++) {
-      length *= cm->count[i];
-    }
-
-    chpl_dprintf (chpl_vdebug_fd,
-                  VDEBUG_GETPUT_FORMAT_STRING, "st_get",
-                  (long long) tv.tv_sec, (long) tv.tv_usec, info->localNodeID,
-                  info->remoteNodeID, TID_STRING(buff, commTask),
-                  (unsigned long) cm->dstaddr, (unsigned long) cm->srcaddr, cm->elemSize,
-                  length, cm->commID, cm->lineno, cm->filename);
-    // print out the srcstrides and dststrides and stridelevels and count?
-  }
+  if (chpl_vdebug)
+    vdebug_log_comm_strd (chpl_vdebug_rec_get_strd, info);
 }
 
-// Record>  fork: time.sec nodeId forkNodeId subLoc funcId arg argSize forkTaskId lineNumber fileName
-
 void cb_comm_executeOn (const chpl_comm_cb_info_t *info) {
-
-  // Visual Debug Support
-  if (chpl_vdebug) {
-    const struct chpl_comm_info_comm_executeOn *cm = &info->iu.executeOn;
-    chpl_taskID_t executeOnTask = chpl_task_getId();
-    char buff[CHPL_TASK_ID_STRING_MAX_LEN];
-    struct timeval tv;
-    (void) gettimeofday (&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd,
-                  "fork: %lld.%06ld %d %d %d %d %#lx %zd %s %d %d\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec, info->localNodeID,
-                  info->remoteNodeID, cm->subloc, cm->fid, (unsigned long) cm->arg,
-                  cm->arg_size, TID_STRING(buff, executeOnTask),
-                  cm->lineno, cm->filename);
-  }
+  if (chpl_vdebug)
+    vdebug_log_fork (chpl_vdebug_rec_fork, info);
 }
 
-// Record>  fork_nb: time.sec nodeId forkNodeId subLoc funcId arg argSize forkTaskId lineNumber fileName
-
-
 void  cb_comm_executeOn_nb (const chpl_comm_cb_info_t *info) {
-  if (chpl_vdebug) {
-    const struct chpl_comm_info_comm_executeOn *cm = &info->iu.executeOn;
-    chpl_taskID_t executeOnTask = chpl_task_getId();
-    char buff[CHPL_TASK_ID_STRING_MAX_LEN];
-    struct timeval tv;
-    (void) gettimeofday (&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd, "fork_nb: %lld.%06ld %d %d %d %d %#lx %zd %s %d %d\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec, info->localNodeID,
-                  info->remoteNodeID, cm->subloc, cm->fid, (unsigned long) cm->arg, 
-                  cm->arg_size, TID_STRING(buff, executeOnTask),
-                  cm->lineno, cm->filename);
-  }
+  if (chpl_vdebug)
+    vdebug_log_fork (chpl_vdebug_rec_fork_nb, info);
 }
 
-// Record>  f_fork: time.sec nodeId forkNodeId subLoc funcId arg argSize forkTaskId lineNumber fileName
-
 void cb_comm_executeOn_fast (const chpl_comm_cb_info_t *info) {
-  if (chpl_vdebug) {
-    const struct chpl_comm_info_comm_executeOn *cm = &info->iu.executeOn;
-    chpl_taskID_t executeOnTask = chpl_task_getId();
-    char buff[CHPL_TASK_ID_STRING_MAX_LEN];
-    struct timeval tv;
-    (void) gettimeofday (&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd,
-                  "f_fork: %lld.%06ld %d %d %d %d %#lx %zd %s %d %d\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec, info->localNodeID,
-                  info->remoteNodeID, cm->subloc, cm->fid, (unsigned long)cm->arg, 
-                  cm->arg_size, TID_STRING(buff, executeOnTask),
-                  cm->lineno, cm->filename);
-  }
+  if (chpl_vdebug)
+    vdebug_log_fork (chpl_vdebug_rec_fork_fast, info);
 }
 
 
@@ -596,53 +681,43 @@ int uninstall_callbacks (void) {
   return rv;
 }
 
-// Record>  task: time.sec nodeId taskId parentTaskId On/Local lineNum srcName fid
+// Record>  task: time nodeId taskId parentTaskId On/Local lineNum srcName fid
 
 void cb_task_create (const chpl_task_cb_info_t *info) {
-  struct timeval tv;
+  chpl_vdebug_rec_task_t rec;
   if (!chpl_vdebug) return;
   if (chpl_vdebug_fd >= 0) {
-    chpl_taskID_t taskId = chpl_task_getId();
-    char buff[CHPL_TASK_ID_STRING_MAX_LEN];
-    //printf ("taskCB: event: %d, node %d proc %s task id: %llu, new task id: %llu\n",
-    //         (int)info->event_kind, (int)info->nodeID,
-    //        (info->iu.full.is_executeOn ? "O" : "L"), taskId, info->iu.full.id);
-    (void)gettimeofday(&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd, "task: %lld.%06ld %lld %ld %s %s %ld %d %d\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,
-                  (long long) info->nodeID, (long int) info->iu.full.id,
-                  TID_STRING(buff, taskId),
-                  (info->iu.full.is_executeOn ? "O" : "L"),
-                  (long int) info->iu.full.lineno,
-                  info->iu.full.filename,
-                  info->iu.full.fid);
-   }
-}
-
-// Record>  Btask: time.sec nodeId taskId
+    vdebug_hdr (&rec.hdr, chpl_vdebug_rec_task, sizeof (rec), info->nodeID);
+    rec.taskID = (uint64_t) info->iu.full.id;
+    rec.parentTaskID = (uint64_t) chpl_task_getId();
+    rec.isExecuteOn = info->iu.full.is_executeOn;
+    rec.lineno = info->iu.full.lineno;
+    rec.fileno = info->iu.full.filename;
+    rec.fid = info->iu.full.fid;
+    vdebug_log (&rec, sizeof (rec));
+  }
+}
+
+// Record>  Btask: time nodeId taskId
 
 void cb_task_begin (const chpl_task_cb_info_t *info) {
-  struct timeval tv;
+  chpl_vdebug_rec_task_id_t rec;
   if (!chpl_vdebug) return;
   if (chpl_vdebug_fd >= 0) {
-    (void)gettimeofday(&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd, "Btask: %lld.%06ld %lld %lu\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,
-                  (long long) info->nodeID, (unsigned long) info->iu.full.id);
- 
+    vdebug_hdr (&rec.hdr, chpl_vdebug_rec_btask, sizeof (rec), info->nodeID);
+    rec.taskID = (uint64_t) info->iu.full.id;
+    vdebug_log (&rec, sizeof (rec));
   }
 }
 
-// Record>  Etask: time.sec nodeId taskId
+// Record>  Etask: time nodeId taskId
 
 void cb_task_end (const chpl_task_cb_info_t *info) {
-  struct timeval tv;
+  chpl_vdebug_rec_task_id_t rec;
   if (!chpl_vdebug) return;
   if (chpl_vdebug_fd >= 0) {
-    (void)gettimeofday(&tv, NULL);
-    chpl_dprintf (chpl_vdebug_fd, "Etask: %lld.%06ld %lld %lu\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,
-                  (long long) info->nodeID, (unsigned long) info->iu.id_only.id);
- 
+    vdebug_hdr (&rec.hdr, chpl_vdebug_rec_etask, sizeof (rec), info->nodeID);
+    rec.taskID = (uint64_t) info->iu.id_only.id;
+    vdebug_log (&rec, sizeof (rec));
   }
 }
@@ -232,6 +232,48 @@ typedef struct {
   size_t size; // number of bytes.
 } xfer_info_t;
 
+//
+// Aggregated GETs and PUTs (see chpl_comm_put_aggregated()).  Each
+// task has a buffer per node for each direction.  A PUT buffer holds
+// agg_put_t records, each followed by its data.  A GET buffer holds
+// agg_get_t records, and the reply to it holds agg_put_t records
+// addressed to the requester.  Data is padded to 8 bytes.
+//
+#define AGG_BUFF_SIZE 8192
+
+typedef struct {
+  uint64_t addr;    // where the data goes
+  uint64_t size;
+} agg_put_t;
+
+typedef struct {
+  uint64_t raddr;   // where the data comes from
+  uint64_t laddr;   // where it goes on the requester
+  uint64_t size;
+} agg_get_t;
+
+typedef struct {
+  size_t len;       // bytes used in buf
+  size_t replyLen;  // for GETs, bytes the reply will need
+  int ln;           // first operation in buf, for diagnostics
+  int32_t fn;
+  uint64_t buf[0];
+} agg_node_buff_t;
+
+typedef struct {
+  uint_least32_t        sent;   // buffers sent
+  atomic_uint_least32_t acked;  // buffers done
+  agg_node_buff_t**     get_v;  // per-node GET buffers
+  agg_node_buff_t**     put_v;  // per-node PUT buffers
+} agg_buff_task_info_t;
+
+static inline
+size_t agg_round(size_t size) {
+  return (size + 7) & ~(size_t) 7;
+}
+
+static void agg_buff_end(void);
+
 
 //
 // AM functions
@@ -254,7 +296,11 @@ typedef enum {
   SHUTDOWN,             // tell nodes to get ready for shutdown
   BCAST_SEGINFO,        // broadcast for segment info table
   DO_REPLY_PUT,         // do a PUT here from another locale
-  DO_COPY_PAYLOAD       // copy AM payload to another address
+  DO_COPY_PAYLOAD,      // copy AM payload to another address
+  DO_AGG_PUT,           // do a buffer of aggregated PUTs here
+  DO_AGG_GET,           // reply with the data for aggregated GETs
+  AGG_GET_REPLY,        // store the data for aggregated GETs
+  AGG_SIGNAL            // ack an aggregated buffer
 } AM_handler_function_idx_t;
 
 static void AM_fork_fast(gasnet_token_t token, void* buf, size_t nbytes) {
@@ -331,6 +377,9 @@ static void AM_fork_fast_small(gasnet_token_t token, void* buf, size_t nbytes) {
 static void fork_wrapper(chpl_comm_on_bundle_t *f) {
   chpl_ftable_call(f->task_bundle.requested_fid, f);
 
+  // The on body may have left aggregated ops in this task's buffers.
+  agg_buff_end();
+
   GASNET_Safe(gasnet_AMRequestShort2(f->comm.caller, SIGNAL,
                                      Arg0(f->comm.ack), Arg1(f->comm.ack)));
 }
@@ -385,6 +434,7 @@ static void fork_large_wrapper(large_fork_task_t* f) {
 
   // Call the on body function
   chpl_ftable_call(fid, arg);
+  agg_buff_end();
 
   // Signal completion
   GASNET_Safe(gasnet_AMRequestShort2(caller, SIGNAL, Arg0(ack), Arg1(ack)));
@@ -412,6 +462,7 @@ static void AM_fork_large(gasnet_token_t token, void* buf, size_t nbytes) {
 
 static void fork_nb_wrapper(chpl_comm_on_bundle_t *f) {
   chpl_ftable_call(f->task_bundle.requested_fid, f);
+  agg_buff_end();
 }
 
 static void AM_fork_nb(gasnet_token_t  token,
@@ -470,6 +521,7 @@ static void fork_nb_large_wrapper(large_fork_task_t* f) {
 
   // Call the user function
   chpl_ftable_call(fid, arg);
+  agg_buff_end();
 
   // Free the bundle we just allocated
   chpl_mem_free(arg, 0, 0);
@@ -576,6 +628,75 @@ void AM_copy_payload(gasnet_token_t token, void* buf, size_t nbytes,
   GASNET_Safe(gasnet_AMReplyShort2(token, SIGNAL, ack0, ack1));
 }
 
+// Store the data in a buffer of agg_put_t records.
+static
+void agg_do_puts(void* buf, size_t nbytes) {
+  char* p = buf;
+  char* end = p + nbytes;
+
+  while (p < end) {
+    agg_put_t rec;
+    memcpy(&rec, p, sizeof(rec));
+    p += sizeof(rec);
+    memcpy((void*) (uintptr_t) rec.addr, p, rec.size);
+    p += agg_round(rec.size);
+  }
+}
+
+static
+void agg_signal(gasnet_handlerarg_t a0, gasnet_handlerarg_t a1) {
+  atomic_uint_least32_t* acked = get_ptr_from_args(a0, a1);
+  (void) atomic_fetch_add_explicit_uint_least32_t(acked, 1,
+                                                  memory_order_seq_cst);
+}
+
+static
+void AM_agg_put(gasnet_token_t token, void* buf, size_t nbytes,
+                gasnet_handlerarg_t a0, gasnet_handlerarg_t a1) {
+  agg_do_puts(buf, nbytes);
+  GASNET_Safe(gasnet_AMReplyShort2(token, AGG_SIGNAL, a0, a1));
+}
+
+// Gather the data for a buffer of agg_get_t records and send it back
+// as agg_put_t records.  The requester made sure the reply fits.
+static
+void AM_agg_get(gasnet_token_t token, void* buf, size_t nbytes,
+                gasnet_handlerarg_t a0, gasnet_handlerarg_t a1) {
+  uint64_t reply[AGG_BUFF_SIZE / sizeof(uint64_t)];
+  char* r = (char*) reply;
+  char* p = buf;
+  char* end = p + nbytes;
+
+  while (p < end) {
+    agg_get_t req;
+    agg_put_t rec;
+    memcpy(&req, p, sizeof(req));
+    p += sizeof(req);
+    rec.addr = req.laddr;
+    rec.size = req.size;
+    memcpy(r, &rec, sizeof(rec));
+    r += sizeof(rec);
+    memcpy(r, (void*) (uintptr_t) req.raddr, req.size);
+    r += agg_round(req.size);
+  }
+
+  GASNET_Safe(gasnet_AMReplyMedium2(token, AGG_GET_REPLY,
+                                    reply, r - (char*) reply, a0, a1));
+}
+
+static
+void AM_agg_get_reply(gasnet_token_t token, void* buf, size_t nbytes,
+                      gasnet_handlerarg_t a0, gasnet_handlerarg_t a1) {
+  agg_do_puts(buf, nbytes);
+  agg_signal(a0, a1);
+}
+
+static
+void AM_agg_signal(gasnet_token_t token,
+                   gasnet_handlerarg_t a0, gasnet_handlerarg_t a1) {
+  agg_signal(a0, a1);
+}
+
 static gasnet_handlerentry_t ftable[] = {
   {FORK,          AM_fork},
   {FORK_SMALL,    AM_fork_small},
@@ -593,7 +714,11 @@ static gasnet_handlerentry_t ftable[] = {
   {SHUTDOWN,      AM_shutdown},
   {BCAST_SEGINFO, AM_bcast_seginfo},
   {DO_REPLY_PUT,  AM_reply_put},
-  {DO_COPY_PAYLOAD, AM_copy_payload}
+  {DO_COPY_PAYLOAD, AM_copy_payload},
+  {DO_AGG_PUT,    AM_agg_put},
+  {DO_AGG_GET,    AM_agg_get},
+  {AGG_GET_REPLY, AM_agg_get_reply},
+  {AGG_SIGNAL,    AM_agg_signal}
 };
 
 //
@@ -605,6 +730,7 @@ chpl_comm_nb_handle_t chpl_comm_put_nb(void *addr, c_nodeid_t node, void* raddr,
 {
   gasnet_handle_t ret;
   int remote_in_segment;
+  uint64_t diagsStart;
 
   // Communication callbacks
   if (chpl_comm_have_callbacks(chpl_comm_cb_event_kind_put_nb)) {
@@ -626,9 +752,11 @@ chpl_comm_nb_handle_t chpl_comm_put_nb(void *addr, c_nodeid_t node, void* raddr,
     return (chpl_comm_nb_handle_t) ret;
   }
 
+  diagsStart = chpl_comm_diags_site_start();
   ret = gasnet_put_nb_bulk(node, raddr, addr, size);
 
   chpl_comm_diags_incr(put_nb);
+  chpl_comm_diags_site(put, size, commID, ln, fn, diagsStart);
 
   return (chpl_comm_nb_handle_t) ret;
 }
@@ -639,6 +767,7 @@ chpl_comm_nb_handle_t chpl_comm_get_nb(void* addr, c_nodeid_t node, void* raddr,
 {
   gasnet_handle_t ret;
   int remote_in_segment;
+  uint64_t diagsStart;
 
   // Communications callback support
   if (chpl_comm_have_callbacks(chpl_comm_cb_event_kind_get_nb)) {
@@ -660,9 +789,11 @@ chpl_comm_nb_handle_t chpl_comm_get_nb(void* addr, c_nodeid_t node, void* raddr,
     return (chpl_comm_nb_handle_t) ret;
   }
 
+  diagsStart = chpl_comm_diags_site_start();
   ret = gasnet_get_nb_bulk(addr, node, raddr, size);
 
   chpl_comm_diags_incr(get_nb);
+  chpl_comm_diags_site(get, size, commID, ln, fn, diagsStart);
 
   return (chpl_comm_nb_handle_t) ret;
 }
@@ -1082,6 +1213,7 @@ void chpl_comm_exit(int all, int status) {
 void  chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
                     size_t size, int32_t commID, int ln, int32_t fn) {
   int remote_in_segment;
+  uint64_t diagsStart;
 
   if (chpl_nodeID == node) {
     memmove(raddr, addr, size);
@@ -1096,6 +1228,7 @@ void  chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
 
     chpl_comm_diags_verbose_rdma("put", node, size, ln, fn, commID);
     chpl_comm_diags_incr(put);
+    diagsStart = chpl_comm_diags_site_start();
 
     // Handle remote address not in remote segment.
 #ifdef GASNET_SEGMENT_EVERYTHING
@@ -1148,6 +1281,8 @@ void  chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
         wait_done_obj(&done, false);
       }
     }
+
+    chpl_comm_diags_site(put, size, commID, ln, fn, diagsStart);
   }
 }
 
@@ -1157,6 +1292,7 @@ void  chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
 void  chpl_comm_get(void* addr, c_nodeid_t node, void* raddr,
                     size_t size, int32_t commID, int ln, int32_t fn) {
   int remote_in_segment;
+  uint64_t diagsStart;
 
   if (chpl_nodeID == node) {
     memmove(addr, raddr, size);
@@ -1171,6 +1307,7 @@ void  chpl_comm_get(void* addr, c_nodeid_t node, void* raddr,
 
     chpl_comm_diags_verbose_rdma("get", node, size, ln, fn, commID);
     chpl_comm_diags_incr(get);
+    diagsStart = chpl_comm_diags_site_start();
 
     // Handle remote address not in remote segment.
 
@@ -1267,6 +1404,8 @@ void  chpl_comm_get(void* addr, c_nodeid_t node, void* raddr,
         chpl_mem_free(local_buf, 0, 0);
       }
     }
+
+    chpl_comm_diags_site(get, size, commID, ln, fn, diagsStart);
   }
 }
 
@@ -1286,6 +1425,7 @@ void  chpl_comm_get_strd(void* dstaddr, size_t* dststrides, c_nodeid_t srcnode_i
   size_t dststr[strlvls];
   size_t srcstr[strlvls];
   size_t cnt[strlvls+1];
+  uint64_t diagsStart;
 
   // Only count[0] and strides are measured in number of bytes.
   cnt[0] = count[0] * elemSize;
@@ -1315,9 +1455,17 @@ void  chpl_comm_get_strd(void* dstaddr, size_t* dststrides, c_nodeid_t srcnode_i
   if (chpl_nodeID != srcnode) {
     chpl_comm_diags_incr(get);
   }
+  diagsStart = (chpl_nodeID != srcnode) ? chpl_comm_diags_site_start() : 0;
 
   // TODO -- handle strided get for non-registered memory
   gasnet_gets_bulk(dstaddr, dststr, srcnode, srcaddr, srcstr, cnt, strlvls);
+
+  if (diagsStart != 0) {
+    size_t bytes = cnt[0];
+    for (i = 1; i <= strlvls; i++)
+      bytes *= cnt[i];
+    chpl_comm_diags_site(get, bytes, commID, ln, fn, diagsStart);
+  }
 }
 
 // See the comment for chpl_comm_gets().
@@ -1332,6 +1480,7 @@ void  chpl_comm_put_strd(void* dstaddr, size_t* dststrides, c_nodeid_t dstnode_i
   size_t dststr[strlvls];
   size_t srcstr[strlvls];
   size_t cnt[strlvls+1];
+  uint64_t diagsStart;
 
   // Only count[0] and strides are measured in number of bytes.
   cnt[0] = count[0] * elemSize;
@@ -1360,9 +1509,17 @@ void  chpl_comm_put_strd(void* dstaddr, size_t* dststrides, c_nodeid_t dstnode_i
   if (chpl_nodeID != dstnode) {
     chpl_comm_diags_incr(put);
   }
+  diagsStart = (chpl_nodeID != dstnode) ? chpl_comm_diags_site_start() : 0;
 
   // TODO -- handle strided put for non-registered memory
   gasnet_puts_bulk(dstnode, dstaddr, dststr, srcaddr, srcstr, cnt, strlvls);
+
+  if (diagsStart != 0) {
+    size_t bytes = cnt[0];
+    for (i = 1; i <= strlvls; i++)
+      bytes *= cnt[i];
+    chpl_comm_diags_site(put, bytes, commID, ln, fn, diagsStart);
+  }
 }
 
 #define MAX_UNORDERED_TRANS_SZ 1024
@@ -1411,7 +1568,209 @@ void chpl_comm_put_unordered(void* addr, c_nodeid_t node, void* raddr,
   chpl_comm_put(addr, node, raddr, size, commID, ln, fn);
 }
 
-void chpl_comm_getput_unordered_task_fence(void) { }
+static inline
+size_t agg_buff_size(void) {
+  return (gasnet_AMMaxMedium() < AGG_BUFF_SIZE)
+         ? gasnet_AMMaxMedium()
+         : AGG_BUFF_SIZE;
+}
+
+// Larger transfers gain little from aggregation, so they are done
+// directly.
+static inline
+size_t agg_max_xfer_size(void) {
+  return agg_buff_size() / 8;
+}
+
+static
+agg_buff_task_info_t* agg_buff_acquire(void) {
+  chpl_task_infoRuntime_t* infoRuntime = chpl_task_getInfoRuntime();
+  agg_buff_task_info_t* info;
+
+  if (infoRuntime == NULL)
+    return NULL;
+
+  info = infoRuntime->comm_data.agg_buff;
+  if (info == NULL) {
+    info = chpl_mem_alloc(sizeof(*info), CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+    info->sent = 0;
+    atomic_init_uint_least32_t(&info->acked, 0);
+    info->get_v = chpl_mem_allocManyZero(chpl_numNodes, sizeof(info->get_v[0]),
+                                         CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+    info->put_v = chpl_mem_allocManyZero(chpl_numNodes, sizeof(info->put_v[0]),
+                                         CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+    infoRuntime->comm_data.agg_buff = info;
+  }
+  return info;
+}
+
+static
+agg_node_buff_t* agg_node_buff(agg_node_buff_t** v, c_nodeid_t node) {
+  if (v[node] == NULL) {
+    v[node] = chpl_mem_alloc(sizeof(agg_node_buff_t) + agg_buff_size(),
+                             CHPL_RT_MD_COMM_XMIT_RCV_BUF, 0, 0);
+    v[node]->len = 0;
+    v[node]->replyLen = 0;
+  }
+  return v[node];
+}
+
+// Send one node's buffer.  Medium AM payloads are copied out before
+// the request returns, so the buffer can be refilled right away.
+static
+void agg_send(agg_buff_task_info_t* info, agg_node_buff_t* b,
+              c_nodeid_t node, chpl_bool isGet) {
+  info->sent++;
+  if (isGet) {
+    chpl_comm_diags_verbose_rdma("aggregated get", node, b->replyLen,
+                                 b->ln, b->fn, CHPL_COMM_UNKNOWN_ID);
+    chpl_comm_diags_incr(get);
+    GASNET_Safe(gasnet_AMRequestMedium2(node, DO_AGG_GET, b->buf, b->len,
+                                        Arg0(&info->acked),
+                                        Arg1(&info->acked)));
+  } else {
+    chpl_comm_diags_verbose_rdma("aggregated put", node, b->len,
+                                 b->ln, b->fn, CHPL_COMM_UNKNOWN_ID);
+    chpl_comm_diags_incr(put);
+    GASNET_Safe(gasnet_AMRequestMedium2(node, DO_AGG_PUT, b->buf, b->len,
+                                        Arg0(&info->acked),
+                                        Arg1(&info->acked)));
+  }
+  b->len = 0;
+  b->replyLen = 0;
+}
+
+// Send all of this task's buffers and wait for them to be done.
+static
+void agg_buff_flush(agg_buff_task_info_t* info) {
+  c_nodeid_t node;
+
+  for (node = 0; node < chpl_numNodes; node++) {
+    if (info->get_v[node] != NULL && info->get_v[node]->len > 0)
+      agg_send(info, info->get_v[node], node, true);
+    if (info->put_v[node] != NULL && info->put_v[node]->len > 0)
+      agg_send(info, info->put_v[node], node, false);
+  }
+
+#ifndef CHPL_COMM_YIELD_TASK_WHILE_POLLING
+  GASNET_BLOCKUNTIL(atomic_load_uint_least32_t(&info->acked) == info->sent);
+#else
+  while (atomic_load_uint_least32_t(&info->acked) != info->sent) {
+    am_poll_try();
+    chpl_task_yield();
+  }
+#endif
+}
+
+static
+void agg_buff_end(void) {
+  chpl_task_infoRuntime_t* infoRuntime = chpl_task_getInfoRuntime();
+  agg_buff_task_info_t* info;
+  c_nodeid_t node;
+
+  if (infoRuntime == NULL || infoRuntime->comm_data.agg_buff == NULL)
+    return;
+
+  info = infoRuntime->comm_data.agg_buff;
+  agg_buff_flush(info);
+  for (node = 0; node < chpl_numNodes; node++) {
+    if (info->get_v[node] != NULL)
+      chpl_mem_free(info->get_v[node], 0, 0);
+    if (info->put_v[node] != NULL)
+      chpl_mem_free(info->put_v[node], 0, 0);
+  }
+  chpl_mem_free(info->get_v, 0, 0);
+  chpl_mem_free(info->put_v, 0, 0);
+  chpl_mem_free(info, 0, 0);
+  infoRuntime->comm_data.agg_buff = NULL;
+}
+
+void chpl_comm_get_aggregated(void* addr, c_nodeid_t node, void* raddr,
+                              size_t size, int32_t commID, int ln, int32_t fn) {
+  agg_buff_task_info_t* info;
+  agg_node_buff_t* b;
+  agg_get_t req;
+  uint64_t diagsStart;
+
+  if (size == 0)
+    return;
+
+  if (node == chpl_nodeID) {
+    memmove(addr, raddr, size);
+    return;
+  }
+
+  if (size > agg_max_xfer_size() || (info = agg_buff_acquire()) == NULL) {
+    chpl_comm_get(addr, node, raddr, size, commID, ln, fn);
+    return;
+  }
+
+  diagsStart = chpl_comm_diags_site_start();
+
+  b = agg_node_buff(info->get_v, node);
+  if (b->len + sizeof(req) > agg_buff_size() ||
+      b->replyLen + sizeof(agg_put_t) + agg_round(size) > agg_buff_size())
+    agg_send(info, b, node, true);
+  if (b->len == 0) {
+    b->ln = ln;
+    b->fn = fn;
+  }
+
+  req.raddr = (uint64_t) (uintptr_t) raddr;
+  req.laddr = (uint64_t) (uintptr_t) addr;
+  req.size = size;
+  memcpy((char*) b->buf + b->len, &req, sizeof(req));
+  b->len += sizeof(req);
+  b->replyLen += sizeof(agg_put_t) + agg_round(size);
+
+  chpl_comm_diags_site(get, size, commID, ln, fn, diagsStart);
+}
+
+void chpl_comm_put_aggregated(void* addr, c_nodeid_t node, void* raddr,
+                              size_t size, int32_t commID, int ln, int32_t fn) {
+  agg_buff_task_info_t* info;
+  agg_node_buff_t* b;
+  agg_put_t rec;
+  uint64_t diagsStart;
+
+  if (size == 0)
+    return;
+
+  if (node == chpl_nodeID) {
+    memmove(raddr, addr, size);
+    return;
+  }
+
+  if (size > agg_max_xfer_size() || (info = agg_buff_acquire()) == NULL) {
+    chpl_comm_put(addr, node, raddr, size, commID, ln, fn);
+    return;
+  }
+
+  diagsStart = chpl_comm_diags_site_start();
+
+  b = agg_node_buff(info->put_v, node);
+  if (b->len + sizeof(rec) + agg_round(size) > agg_buff_size())
+    agg_send(info, b, node, false);
+  if (b->len == 0) {
+    b->ln = ln;
+    b->fn = fn;
+  }
+
+  rec.addr = (uint64_t) (uintptr_t) raddr;
+  rec.size = size;
+  memcpy((char*) b->buf + b->len, &rec, sizeof(rec));
+  memcpy((char*) b->buf + b->len + sizeof(rec), addr, size);
+  b->len += sizeof(rec) + agg_round(size);
+
+  chpl_comm_diags_site(put, size, commID, ln, fn, diagsStart);
+}
+
+void chpl_comm_getput_unordered_task_fence(void) {
+  chpl_task_infoRuntime_t* infoRuntime = chpl_task_getInfoRuntime();
+
+  if (infoRuntime != NULL && infoRuntime->comm_data.agg_buff != NULL)
+    agg_buff_flush(infoRuntime->comm_data.agg_buff);
+}
 
 static inline
 void  execute_on_common(c_nodeid_t node, c_sublocid_t subloc,
@@ -1533,6 +1892,8 @@ void  chpl_comm_execute_on(c_nodeid_t node, c_sublocid_t subloc,
                            chpl_fn_int_t fid,
                            chpl_comm_on_bundle_t *arg, size_t arg_size,
                            int ln, int32_t fn) {
+  uint64_t diagsStart;
+
   if (chpl_nodeID == node) {
     assert(0);
     chpl_ftable_call(fid, arg);
@@ -1547,9 +1908,12 @@ void  chpl_comm_execute_on(c_nodeid_t node, c_sublocid_t subloc,
 
     chpl_comm_diags_verbose_executeOn("", node, ln, fn);
     chpl_comm_diags_incr(execute_on);
+    diagsStart = chpl_comm_diags_site_start();
 
     execute_on_common(node, subloc, fid, arg, arg_size,
                      /*fast*/ false, /*blocking*/ true);
+
+    chpl_comm_diags_site(execute_on, arg_size, -1, ln, fn, diagsStart);
   }
 }
 
@@ -1557,6 +1921,7 @@ void  chpl_comm_execute_on_nb(c_nodeid_t node, c_sublocid_t subloc,
                               chpl_fn_int_t fid,
                               chpl_comm_on_bundle_t *arg, size_t arg_size,
                               int ln, int32_t fn) {
+  uint64_t diagsStart;
 
   if (chpl_nodeID == node) {
     assert(0); // locale model code should prevent this...
@@ -1571,9 +1936,12 @@ void  chpl_comm_execute_on_nb(c_nodeid_t node, c_sublocid_t subloc,
 
     chpl_comm_diags_verbose_executeOn("non-blocking", node, ln, fn);
     chpl_comm_diags_incr(execute_on_nb);
+    diagsStart = chpl_comm_diags_site_start();
 
     execute_on_common(node, subloc, fid, arg, arg_size,
                       /*fast*/ false, /*blocking*/ false);
+
+    chpl_comm_diags_site(execute_on, arg_size, -1, ln, fn, diagsStart);
   }
 }
 
@@ -1582,6 +1950,8 @@ void  chpl_comm_execute_on_fast(c_nodeid_t node, c_sublocid_t subloc,
                                 chpl_fn_int_t fid,
                                 chpl_comm_on_bundle_t *arg, size_t arg_size,
                                 int ln, int32_t fn) {
+  uint64_t diagsStart;
+
   if (chpl_nodeID == node) {
     assert(0);
     chpl_ftable_call(fid, arg);
@@ -1596,10 +1966,15 @@ void  chpl_comm_execute_on_fast(c_nodeid_t node, c_sublocid_t subloc,
 
     chpl_comm_diags_verbose_executeOn("fast", node, ln, fn);
     chpl_comm_diags_incr(execute_on_fast);
+    diagsStart = chpl_comm_diags_site_start();
 
     execute_on_common(node, subloc, fid, arg, arg_size,
                       /*fast*/ true, /*blocking*/ true);
+
+    chpl_comm_diags_site(execute_on, arg_size, -1, ln, fn, diagsStart);
   }
 }
 
-void chpl_comm_task_end(void) { }
+void chpl_comm_task_end(void) {
+  agg_buff_end();
+}
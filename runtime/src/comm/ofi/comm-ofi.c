@@ -2673,8 +2673,10 @@ void chpl_comm_execute_on(c_nodeid_t node, c_sublocid_t subloc,
 
   chpl_comm_diags_verbose_executeOn("", node, ln, fn);
   chpl_comm_diags_incr(execute_on);
+  uint64_t diagsStart = chpl_comm_diags_site_start();
 
   amRequestExecOn(node, subloc, fid, arg, argSize, false, true);
+  chpl_comm_diags_site(execute_on, argSize, -1, ln, fn, diagsStart);
 }
 
 
@@ -2697,8 +2699,10 @@ void chpl_comm_execute_on_nb(c_nodeid_t node, c_sublocid_t subloc,
 
   chpl_comm_diags_verbose_executeOn("non-blocking", node, ln, fn);
   chpl_comm_diags_incr(execute_on_nb);
+  uint64_t diagsStart = chpl_comm_diags_site_start();
 
   amRequestExecOn(node, subloc, fid, arg, argSize, false, false);
+  chpl_comm_diags_site(execute_on, argSize, -1, ln, fn, diagsStart);
 }
 
 
@@ -2721,8 +2725,10 @@ void chpl_comm_execute_on_fast(c_nodeid_t node, c_sublocid_t subloc,
 
   chpl_comm_diags_verbose_executeOn("fast", node, ln, fn);
   chpl_comm_diags_incr(execute_on_fast);
+  uint64_t diagsStart = chpl_comm_diags_site_start();
 
   amRequestExecOn(node, subloc, fid, arg, argSize, true, true);
+  chpl_comm_diags_site(execute_on, argSize, -1, ln, fn, diagsStart);
 }
 
 
@@ -3652,8 +3658,10 @@ void chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
 
   chpl_comm_diags_verbose_rdma("put", node, size, ln, fn, commID);
   chpl_comm_diags_incr(put);
+  uint64_t diagsStart = chpl_comm_diags_site_start();
 
   (void) ofi_put(addr, node, raddr, size);
+  chpl_comm_diags_site(put, size, commID, ln, fn, diagsStart);
 }
 
 
@@ -3684,8 +3692,10 @@ void chpl_comm_get(void* addr, int32_t node, void* raddr,
 
   chpl_comm_diags_verbose_rdma("get", node, size, ln, fn, commID);
   chpl_comm_diags_incr(get);
+  uint64_t diagsStart = chpl_comm_diags_site_start();
 
   (void) ofi_get(addr, node, raddr, size);
+  chpl_comm_diags_site(get, size, commID, ln, fn, diagsStart);
 }
 
 
@@ -3789,8 +3799,10 @@ void chpl_comm_get_unordered(void* addr, c_nodeid_t node, void* raddr,
 
   chpl_comm_diags_verbose_rdma("unordered get", node, size, ln, fn, commID);
   chpl_comm_diags_incr(get);
+  uint64_t diagsStart = chpl_comm_diags_site_start();
 
   do_remote_get_buff(addr, node, raddr, size);
+  chpl_comm_diags_site(get, size, commID, ln, fn, diagsStart);
 }
 
 
@@ -3825,8 +3837,10 @@ void chpl_comm_put_unordered(void* addr, c_nodeid_t node, void* raddr,
 
   chpl_comm_diags_verbose_rdma("unordered put", node, size, ln, fn, commID);
   chpl_comm_diags_incr(put);
+  uint64_t diagsStart = chpl_comm_diags_site_start();
 
   do_remote_put_buff(addr, node, raddr, size);
+  chpl_comm_diags_site(put, size, commID, ln, fn, diagsStart);
 }
 
 
@@ -3836,6 +3850,22 @@ void chpl_comm_getput_unordered_task_fence(void) {
 }
 
 
+//
+// The unordered ops are already buffered per task, so we use them as
+// our aggregated ops.
+//
+void chpl_comm_get_aggregated(void* addr, c_nodeid_t node, void* raddr,
+                              size_t size, int32_t commID, int ln, int32_t fn) {
+  chpl_comm_get_unordered(addr, node, raddr, size, commID, ln, fn);
+}
+
+
+void chpl_comm_put_aggregated(void* addr, c_nodeid_t node, void* raddr,
+                              size_t size, int32_t commID, int ln, int32_t fn) {
+  chpl_comm_put_unordered(addr, node, raddr, size, commID, ln, fn);
+}
+
+
 ////////////////////////////////////////
 //
 // Internal communication support
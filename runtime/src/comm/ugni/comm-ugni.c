@@ -5066,8 +5066,10 @@ void chpl_comm_put(void* addr, c_nodeid_t locale, void* raddr,
 
   chpl_comm_diags_verbose_rdma("put", locale, size, ln, fn, commID);
   chpl_comm_diags_incr(put);
+  uint64_t diagsStart = chpl_comm_diags_site_start();
 
   do_remote_put(addr, locale, raddr, size, NULL, may_proxy_true);
+  chpl_comm_diags_site(put, size, commID, ln, fn, diagsStart);
 }
 
 
@@ -5590,8 +5592,10 @@ void chpl_comm_get_unordered(void* addr, c_nodeid_t locale, void* raddr,
 
   chpl_comm_diags_verbose_rdma("unordered get", locale, size, ln, fn, commID);
   chpl_comm_diags_incr(get);
+  uint64_t diagsStart = chpl_comm_diags_site_start();
 
   do_remote_get_buff(addr, locale, raddr, size, may_proxy_true);
+  chpl_comm_diags_site(get, size, commID, ln, fn, diagsStart);
 }
 
 void chpl_comm_put_unordered(void* addr, c_nodeid_t locale, void* raddr,
@@ -5621,14 +5625,32 @@ void chpl_comm_put_unordered(void* addr, c_nodeid_t locale, void* raddr,
 
   chpl_comm_diags_verbose_rdma("unordered put", locale, size, ln, fn, commID);
   chpl_comm_diags_incr(put);
+  uint64_t diagsStart = chpl_comm_diags_site_start();
 
   do_remote_put_buff(addr, locale, raddr, size, may_proxy_true);
+  chpl_comm_diags_site(put, size, commID, ln, fn, diagsStart);
 }
 
 void chpl_comm_getput_unordered_task_fence(void) {
   task_local_buff_flush(get_buff | put_buff);
 }
 
+//
+// The unordered ops are already chained per task, so we use them as
+// our aggregated ops.
+//
+void chpl_comm_get_aggregated(void* addr, c_nodeid_t locale, void* raddr,
+                              size_t size, int32_t commID, int ln, int32_t fn)
+{
+  chpl_comm_get_unordered(addr, locale, raddr, size, commID, ln, fn);
+}
+
+void chpl_comm_put_aggregated(void* addr, c_nodeid_t locale, void* raddr,
+                              size_t size, int32_t commID, int ln, int32_t fn)
+{
+  chpl_comm_put_unordered(addr, locale, raddr, size, commID, ln, fn);
+}
+
 
 void chpl_comm_get(void* addr, c_nodeid_t locale, void* raddr,
                    size_t size, int32_t commID, int ln, int32_t fn)
@@ -5656,8 +5678,10 @@ void chpl_comm_get(void* addr, c_nodeid_t locale, void* raddr,
 
   chpl_comm_diags_verbose_rdma("get", locale, size, ln, fn, commID);
   chpl_comm_diags_incr(get);
+  uint64_t diagsStart = chpl_comm_diags_site_start();
 
   do_remote_get(addr, locale, raddr, size, may_proxy_true);
+  chpl_comm_diags_site(get, size, commID, ln, fn, diagsStart);
 }
 
 /*
@@ -6883,9 +6907,11 @@ void chpl_comm_execute_on(c_nodeid_t locale, c_sublocid_t subloc,
 
   chpl_comm_diags_verbose_executeOn("", locale, ln, fn);
   chpl_comm_diags_incr(execute_on);
+  uint64_t diagsStart = chpl_comm_diags_site_start();
 
   PERFSTATS_INC(fork_call_cnt);
   fork_call_common(locale, subloc, fid, arg, arg_size, false, true);
+  chpl_comm_diags_site(execute_on, arg_size, -1, ln, fn, diagsStart);
 }
 
 
@@ -6910,9 +6936,11 @@ void chpl_comm_execute_on_nb(c_nodeid_t locale, c_sublocid_t subloc,
 
   chpl_comm_diags_verbose_executeOn("non-blocking", locale, ln, fn);
   chpl_comm_diags_incr(execute_on_nb);
+  uint64_t diagsStart = chpl_comm_diags_site_start();
 
   PERFSTATS_INC(fork_call_nb_cnt);
   fork_call_common(locale, subloc, fid, arg, arg_size, false, false);
+  chpl_comm_diags_site(execute_on, arg_size, -1, ln, fn, diagsStart);
 }
 
 
@@ -6937,6 +6965,7 @@ void chpl_comm_execute_on_fast(c_nodeid_t locale, c_sublocid_t subloc,
 
   chpl_comm_diags_verbose_executeOn("fast", locale, ln, fn);
   chpl_comm_diags_incr(execute_on_fast);
+  uint64_t diagsStart = chpl_comm_diags_site_start();
 
   //
   // Note: the rf_handler() logic assumes that fast implies blocking.
@@ -6944,6 +6973,7 @@ void chpl_comm_execute_on_fast(c_nodeid_t locale, c_sublocid_t subloc,
   //
   PERFSTATS_INC(fork_call_fast_cnt);
   fork_call_common(locale, subloc, fid, arg, arg_size, true, true);
+  chpl_comm_diags_site(execute_on, arg_size, -1, ln, fn, diagsStart);
 }
 
 
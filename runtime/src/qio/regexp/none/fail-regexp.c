@@ -91,3 +91,26 @@ qioerr qio_regexp_channel_match(const qio_regexp_t* regexp, const int threadsafe
   return 0;
 }
 
+
+void qio_regexp_set_create_compile(const char** strs, const int64_t* str_lens, int64_t npatterns, const qio_regexp_options_t* options, qio_regexp_set_t* compiled, int64_t* err_idx, const char** err_str)
+{
+  chpl_internal_error("No Regexp Support");
+}
+
+void qio_regexp_set_retain(const qio_regexp_set_t* compiled)
+{
+}
+void qio_regexp_set_release(qio_regexp_set_t* compiled)
+{
+}
+
+int64_t qio_regexp_set_size(const qio_regexp_set_t* compiled)
+{
+  return 0;
+}
+
+int64_t qio_regexp_set_match(const qio_regexp_set_t* compiled, const char* text, int64_t text_len, int64_t* ids, int64_t max_ids)
+{
+  chpl_internal_error("No Regexp Support");
+  return 0;
+}
@@ -43,6 +43,10 @@
 #undef printf
 
 #include "re2/re2.h"
+#include "re2/set.h"
+
+#include <algorithm>
+#include <vector>
 
 using namespace re2;
 
@@ -371,6 +375,95 @@ int64_t qio_regexp_replace(qio_regexp_t* regexp, const char* repl, int64_t repl_
   return ret;
 }
 
+struct re_set_t {
+  RE2::Set set;
+  int64_t size;
+  qbytes_refcnt_t ref_cnt;
+  re_set_t(const RE2::Options& options)
+    : set(options, RE2::UNANCHORED), size(0)
+  {
+    DO_INIT_REFCNT(this);
+  }
+};
+
+static
+void re_set_free(re_set_t* re_set)
+{
+  delete re_set;
+}
+
+void qio_regexp_set_create_compile(const char** strs, const int64_t* str_lens, int64_t npatterns, const qio_regexp_options_t* options, qio_regexp_set_t* compiled, int64_t* err_idx, const char** err_str)
+{
+  RE2::Options opts;
+  qio_re_options_to_re2_options(options, &opts);
+  // Errors are reported to the caller through err_str
+  opts.set_log_errors(false);
+  re_set_t* re_set = new re_set_t(opts);
+
+  *err_idx = -1;
+  *err_str = NULL;
+
+  for( int64_t i = 0; i < npatterns; i++ ) {
+    std::string error;
+    StringPiece strp(strs[i], str_lens[i]);
+    if( re_set->set.Add(strp, &error) < 0 ) {
+      *err_idx = i;
+      *err_str = qio_strdup(error.c_str());
+      break;
+    }
+    re_set->size++;
+  }
+
+  if( *err_idx == -1 && ! re_set->set.Compile() ) {
+    *err_idx = npatterns;
+    *err_str = qio_strdup("out of memory compiling regexp set");
+  }
+
+  compiled->set = (void*) re_set;
+}
+
+void qio_regexp_set_retain(const qio_regexp_set_t* compiled)
+{
+  re_set_t* re_set = (re_set_t*) compiled->set;
+  DO_RETAIN(re_set);
+}
+
+void qio_regexp_set_release(qio_regexp_set_t* compiled)
+{
+  re_set_t* re_set = (re_set_t*) compiled->set;
+  if( re_set ) DO_RELEASE(re_set, re_set_free);
+  compiled->set = NULL;
+}
+
+int64_t qio_regexp_set_size(const qio_regexp_set_t* compiled)
+{
+  re_set_t* re_set = (re_set_t*) compiled->set;
+  if( ! re_set ) return 0;
+  return re_set->size;
+}
+
+int64_t qio_regexp_set_match(const qio_regexp_set_t* compiled, const char* text, int64_t text_len, int64_t* ids, int64_t max_ids)
+{
+  re_set_t* re_set = (re_set_t*) compiled->set;
+  StringPiece textp(text, text_len);
+
+  if( ! re_set ) return 0;
+
+  if( ids == NULL ) {
+    return re_set->set.Match(textp, NULL) ? 1 : 0;
+  }
+
+  std::vector<int> v;
+  if( ! re_set->set.Match(textp, &v) ) return 0;
+
+  // RE2::Set does not promise any order
+  std::sort(v.begin(), v.end());
+  for( size_t i = 0; i < v.size() && (int64_t) i < max_ids; i++ ) {
+    ids[i] = v[i];
+  }
+  return v.size();
+}
+
 int qio_regexp_channel_read_byte(qio_channel_s* ch);
 void qio_regexp_channel_discard(qio_channel_s* ch, int64_t cur, int64_t min);
 
@@ -410,6 +503,153 @@ void qio_regexp_channel_discard(qio_channel_s* ch, int64_t cur, int64_t min)
 }
 
 
+// Patterns that can match more than this many bytes use MatchFile
+#define QIO_REGEXP_CHUNK_MAX_MATCH_LEN (64*1024)
+// Minimum size of a window copied to straddle a part boundary
+#define QIO_REGEXP_CHUNK_STRADDLE_LEN 4096
+
+// Search the channel one contiguous buffer part at a time, running RE2
+// directly over the bytes in each part instead of reading them one at
+// a time through FileSearchInfo.
+//
+// This is only used for unanchored searches with a pattern that
+// has a bounded match length (max_len). A match found in a window
+// [ws, we) is only trusted if it starts at or before we - max_len - 1;
+// any match starting there ends before we and so does not depend on
+// the data that follows. Otherwise the next window starts at
+// we - max_len, so matches straddling a part boundary are found
+// in a small window copied from both parts.
+//
+// Leaves the channel positioned after the searched data (or within
+// the last window if there was a match) and stores the match and the
+// first nsub-1 captures in captures, if it is not NULL.
+static
+qioerr qio_regexp_channel_match_chunked(RE2* re, qio_channel_t* ch, int64_t start_offset, int64_t end, qio_bool can_discard, qio_bool keep_unmatched, qio_regexp_string_piece_t* captures, int nsub, int64_t* match_start_out, int64_t* match_len_out, bool* found_out)
+{
+  qioerr err = 0;
+  StringPiece* subs = NULL;
+  MAYBE_STACK_SPACE(StringPiece, subs_onstack);
+  int64_t max_len = re->max_match_length_bytes();
+  int64_t ws = start_offset; // start of the window to search
+  int64_t cur = start_offset; // channel position; ws or ws-1 for context
+  std::string scratch;
+
+  *found_out = false;
+
+  MAYBE_STACK_ALLOC(StringPiece, nsub, subs, subs_onstack);
+  if( ! subs ) return QIO_ENOMEM;
+
+  while( true ) {
+    qbuffer_t* buf = NULL;
+    qbuffer_iter_t istart;
+    qbuffer_iter_t iend;
+    qbytes_t* bytes = NULL;
+    int64_t skip = 0;
+    int64_t part_len = 0;
+    int64_t avail;
+    int64_t want;
+    int64_t ctx = ws - cur;
+    int64_t we;
+    bool at_eof = false;
+    bool exact;
+    bool matched;
+    StringPiece text;
+
+    // Make sure we have a window big enough to make progress.
+    want = ctx + 2*(max_len+1);
+    if( want < QIO_REGEXP_CHUNK_STRADDLE_LEN )
+      want = QIO_REGEXP_CHUNK_STRADDLE_LEN;
+    if( want > end - cur ) want = end - cur;
+    err = qio_channel_require_read(false, ch, want);
+    if( qio_err_to_int(err) == EEOF ) {
+      at_eof = true;
+      err = 0;
+    }
+    if( err ) break;
+
+    err = qio_channel_begin_peek_buffer(false, ch, 0, 0, &buf, &istart, &iend);
+    if( err ) break;
+
+    avail = qbuffer_iter_num_bytes(istart, iend);
+    if( avail > end - cur ) {
+      avail = end - cur;
+      at_eof = true;
+    }
+    if( avail < want ) at_eof = true;
+
+    if( avail > 0 ) qbuffer_iter_get(istart, iend, &bytes, &skip, &part_len);
+    if( part_len > avail ) part_len = avail;
+
+    if( part_len == avail || part_len - ctx > max_len + 1 ) {
+      // Common case: search within the current part.
+      if( part_len > 0 )
+        text.set((const char*) qbytes_data(bytes) + skip, part_len);
+      else
+        text.set("", 0);
+    } else {
+      // The window straddles a part boundary; copy it.
+      qbuffer_iter_t icopy_end = istart;
+      int64_t len = want;
+      if( len > avail ) len = avail;
+      qbuffer_iter_advance(buf, &icopy_end, len);
+      scratch.resize(len);
+      err = qbuffer_copyout(buf, istart, icopy_end, &scratch[0], len);
+      if( err ) {
+        qio_channel_end_peek_buffer(false, ch, 0);
+        break;
+      }
+      text.set(scratch.data(), len);
+    }
+
+    we = cur + text.size();
+    exact = at_eof && we == cur + avail;
+
+    matched = re->Match(text, ctx, text.size(), RE2::UNANCHORED, subs, nsub);
+    if( matched ) {
+      int64_t match_start = cur + (subs[0].data() - text.data());
+      if( exact || match_start + max_len < we ) {
+        for( int i = 0; captures && i < nsub; i++ ) {
+          if( subs[i].data() == NULL ) {
+            captures[i].offset = -1;
+            captures[i].len = 0;
+          } else {
+            captures[i].offset = cur + (subs[i].data() - text.data());
+            captures[i].len = subs[i].size();
+          }
+        }
+        *match_start_out = match_start;
+        *match_len_out = subs[0].size();
+        *found_out = true;
+        err = qio_channel_end_peek_buffer(false, ch, 0);
+        break;
+      }
+    }
+
+    if( exact ) {
+      // Nothing more to search; leave the channel after the data.
+      err = qio_channel_end_peek_buffer(false, ch, we - cur);
+      break;
+    }
+
+    // No match starts before we - max_len. Search again from there,
+    // keeping one byte before the window for ^, $ and \b.
+    ws = we - max_len;
+    if( ws < start_offset + 1 ) ws = start_offset + 1;
+    err = qio_channel_end_peek_buffer(false, ch, ws - 1 - cur);
+    if( err ) break;
+    cur = ws - 1;
+
+    // Let the channel release data we no longer need
+    if( can_discard && ! keep_unmatched ) {
+      qio_regexp_channel_discard(ch, cur, cur);
+    }
+  }
+
+  MAYBE_STACK_FREE(subs, subs_onstack);
+
+  return err;
+}
+
 qioerr qio_regexp_channel_match(const qio_regexp_t* regexp, const int threadsafe, struct qio_channel_s* ch, int64_t maxlen, int anchor, qio_bool can_discard, qio_bool keep_unmatched, qio_bool keep_whole_pattern, qio_regexp_string_piece_t* captures, int64_t ncaptures)
 {
   RE2* re = (RE2*) regexp->regexp;
@@ -476,6 +716,25 @@ qioerr qio_regexp_channel_match(const qio_regexp_t* regexp, const int threadsafe
     goto markerror;
   }
 
+  // Unanchored searches for a pattern with a bounded match length
+  // can run RE2 over the buffered data directly.
+  if( ranchor == RE2::UNANCHORED &&
+      re->max_match_length_bytes() >= 0 &&
+      re->max_match_length_bytes() <= QIO_REGEXP_CHUNK_MAX_MATCH_LEN ) {
+    err = qio_regexp_channel_match_chunked(re, ch, start_offset, end,
+                                           can_discard, keep_unmatched,
+                                           ncaptures > 0 ? captures : NULL,
+                                           ncaptures > 0 ? ci.nmatch : 1,
+                                           &match_start, &match_len, &found);
+    if( !found ) {
+      for( i = 0; i < ncaptures; i++ ) {
+        captures[i].offset = -1;
+        captures[i].len = 0;
+      }
+    }
+    goto error;
+  }
+
   // Require at least 1 byte and at most 1024 bytes.
   need = re->min_match_length_bytes();
   if( need <= 0 ) need = 1;
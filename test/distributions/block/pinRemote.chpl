@@ -0,0 +1,36 @@
+use BlockDist;
+
+config const n = 20;
+
+const D = {1..n} dmapped Block({1..n});
+var A: [D] int = [i in D] i;
+
+// Each locale pins its right-hand neighbor range plus a few scattered indices
+coforall loc in Locales do on loc {
+  const myInds = D.localSubdomain();
+  if myInds.size > 0 {
+    A.pinRemote(myInds.high+1..min(n, myInds.high+3));
+    A.pinRemote([1, n]);
+    A.pinRemote(n/2);
+  }
+}
+
+proc check(expected, msg) {
+  var ok = true;
+  coforall loc in Locales with (&& reduce ok) do on loc {
+    for i in D do
+      ok &&= (A[i] == expected(i));
+  }
+  writeln(msg, ": ", if ok then "ok" else "MISMATCH");
+}
+
+check(lambda(i:int) { return i; }, "after pinning");
+
+// Writes go to the owning locale; a refresh makes them visible everywhere
+A = [i in D] -i;
+A.refreshPinned();
+check(lambda(i:int) { return -i; }, "after refresh");
+
+A.unpinRemote();
+A = [i in D] 2*i;
+check(lambda(i:int) { return 2*i; }, "after unpinning");
@@ -0,0 +1,57 @@
+// Compares building an associative domain (and an array over it) one
+// index at a time with building it with a single parallel bulkAdd.
+// Run with --dataParTasksPerLocale=N to see how bulkAdd scales.
+
+config const timing = true;
+config const perf = false;
+config const correctness = false;
+
+config const size = 10000000;
+
+use Time;
+
+var keys: [1..size] int;
+// scramble the keys so that consecutive ones land far apart
+forall (k, i) in zip(keys, 1..) do k = (i * 40503) % (size * 2);
+
+var ok = true;
+
+proc check(D: domain(int), A) {
+  if D.size != size then ok = false;
+  for k in keys do
+    if !D.contains(k) || A[k] != 0 then ok = false;
+}
+
+{
+  var t = new Timer();
+  t.start();
+
+  var D: domain(int);
+  var A: [D] int;
+  for k in keys do
+    D += k;
+
+  t.stop();
+
+  if correctness then check(D, A);
+  if timing then writef("serial add: % 6.3r\n", t.elapsed());
+}
+
+{
+  var t = new Timer();
+  t.start();
+
+  var D: domain(int);
+  var A: [D] int;
+  D.bulkAdd(keys);
+
+  t.stop();
+
+  if correctness then check(D, A);
+  if timing then writef("bulkAdd: % 6.3r\n", t.elapsed());
+}
+
+if perf || correctness {
+  if ok then writeln("SUCCESS");
+  else writeln("FAILURE");
+}
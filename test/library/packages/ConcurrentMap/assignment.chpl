@@ -0,0 +1,25 @@
+use ConcurrentMap;
+
+config const n = 1000;
+
+var a = new concurrentMap(int, string, numShards=8);
+var b = new concurrentMap(int, string, numShards=8);
+
+forall i in 1..n do a.add(i, i:string);
+for i in n+1..n+10 do b.add(i, "stale");
+
+// assignment replaces the contents and copies the values
+b = a;
+writeln(b.size == n, " ", !b.contains(n+1), " ", b[7] == "7");
+
+a.set(7, "changed");
+writeln(b[7], " ", a[7]);
+
+// assigning a map to itself keeps its contents
+b = b;
+writeln(b.size == n, " ", b[n] == n:string);
+
+// assigning an empty map clears
+var c = new concurrentMap(int, string, numShards=8);
+b = c;
+writeln(b.isEmpty(), " ", a.size == n);
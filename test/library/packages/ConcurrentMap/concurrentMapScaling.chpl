@@ -0,0 +1,53 @@
+// Compares a parSafe map with a concurrentMap under a mixed read/write
+// workload run from a forall.
+
+use Map, ConcurrentMap, Time;
+
+config const timing = true;
+config const perf = false;
+config const correctness = false;
+
+config const numKeys = 1 << 16;
+config const numOps = 10000000;
+// percentage of operations that are updates; the rest are lookups
+config const updatePercent = 20;
+
+proc opIsUpdate(i) return (i * 7919) % 100 < updatePercent;
+proc opKey(i) return (i * 40503) % numKeys;
+
+var t: Timer;
+
+var m = new map(int, int, parSafe=true);
+for k in 0..#numKeys do m.add(k, 0);
+
+t.start();
+forall i in 0..#numOps with (ref m) {
+  const k = opKey(i);
+  if opIsUpdate(i) then m.set(k, i);
+                   else m.contains(k);
+}
+t.stop();
+const mapTime = t.elapsed();
+
+var cm = new concurrentMap(int, int);
+for k in 0..#numKeys do cm.add(k, 0);
+
+t.clear();
+t.start();
+forall i in 0..#numOps {
+  const k = opKey(i);
+  if opIsUpdate(i) then cm.set(k, i);
+                   else cm.contains(k);
+}
+t.stop();
+const concurrentTime = t.elapsed();
+
+if timing {
+  writeln("map(parSafe=true): ", mapTime);
+  writeln("concurrentMap: ", concurrentTime);
+}
+
+if perf || correctness {
+  if m.size == numKeys && cm.size == numKeys then writeln("SUCCESS");
+  else writeln("FAILURE");
+}
@@ -0,0 +1,65 @@
+use ConcurrentMap;
+
+config const n = 100000;
+
+var m = new concurrentMap(int, int);
+
+// concurrent adds, with every key added by two iterations
+var numAdded = 0;
+forall i in 1..2*n with (+ reduce numAdded) do
+  if m.add(i % n, i % n) then numAdded += 1;
+writeln(numAdded == n, " ", m.size == n);
+
+// concurrent counting
+forall i in 1..n do
+  m.getAndAdd(i % 10, 1);
+const countSum = + reduce [i in 0..9] m[i];
+writeln(countSum == 45 + n);
+
+// concurrent updates via a function object
+record doubler {
+  proc this(k: int, ref v: int) {
+    v *= 2;
+    return v;
+  }
+}
+forall i in 10..#100 do
+  m.update(i, new doubler());
+const doubled = && reduce [i in 10..#100] (m[i] == 2*i);
+writeln(doubled);
+
+// mixed reads, writes and removes
+forall i in 0..#n {
+  select i % 4 {
+    when 0 do m.remove(i);
+    when 1 do m.set(i, -i);
+    when 2 do m.addOrSet(i + n, i);
+    otherwise do assert(m.contains(i));
+  }
+}
+var ok = true;
+for i in 200..#(n-200) {
+  select i % 4 {
+    when 0 do if m.contains(i) then ok = false;
+    when 1 do if m[i] != -i then ok = false;
+    when 2 do if m.get(i + n, -1) != i then ok = false;
+    otherwise do if m[i] != i then ok = false;
+  }
+}
+writeln(ok);
+
+// parallel iteration and copying
+var total = 0;
+forall k in m with (+ reduce total) do total += 1;
+writeln(total == m.size);
+
+var m2 = m;
+writeln(m2.size == m.size, " ", m2.get(1, 0) == -1);
+
+m.clear();
+writeln(m.isEmpty(), " ", m2.size > 0);
+
+var small = new concurrentMap(string, real, numShards=4);
+small.add("a", 1.0);
+small.add("b", 2.0);
+writeln(small.size, " ", small.contains("a"), " ", small.contains("c"));
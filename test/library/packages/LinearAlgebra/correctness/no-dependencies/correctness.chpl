@@ -820,6 +820,54 @@ use IO;
     assertEqual(Asps.dot(v), Av, 'Asps.dot(v)');
   }
 
+  /* dot - CSC matrix-vector and vector-matrix */
+  {
+    var A = Matrix([1,1,0],
+                   [0,1,1]);
+    var cscDom: sparse subdomain(A.domain) dmapped CS(compressRows=false);
+    cscDom += [(1,1), (1,2), (2,2), (2,3)];
+    var Asps: [cscDom] int;
+    forall (i,j) in cscDom do Asps[i,j] = A[i,j];
+    assertEqual(Asps.dot(Vector(1,2,3)), Vector(3, 5), 'cscA.dot(v)');
+    assertEqual(Vector(2,3).dot(Asps), Vector(2, 5, 3), 'v.dot(cscA)');
+  }
+
+  /* CSRMatrix - from compressed representation */
+  {
+    var A = Matrix([1,0,2],
+                   [0,0,0],
+                   [0,3,4]);
+    const indptr = [1, 3, 3, 5],
+          indices = [1, 3, 2, 3],
+          data = [1, 2, 3, 4];
+    var Asps = CSRMatrix(1..3, 1..3, indptr, indices, data, sortedIndices=true);
+    assertEqual(Asps, CSRMatrix(A), 'CSRMatrix(rows, cols, indptr, indices, data)');
+  }
+
+  /* SpMV */
+  {
+    var A = Matrix([1,1,0],
+                   [0,1,1]);
+    var Asps = CSRMatrix(A);
+    var v = Vector(1,2,3);
+    var Av: [1..2] int;
+    SpMV(Asps, v, Av);
+    assertEqual(Av, Vector(3, 5), 'SpMV(Asps, v, Av)');
+  }
+
+  /* SpMM */
+  {
+    var A = Matrix([1,1,0],
+                   [0,1,1]);
+    var B = Matrix([1,2],
+                   [3,4],
+                   [5,6]);
+    var Asps = CSRMatrix(A);
+    var C: [1..2, 1..2] int;
+    SpMM(Asps, B, C);
+    assertEqual(C, A.dot(B), 'SpMM(Asps, B, C)');
+  }
+
   /* dot - matrix-scalar */
   {
     var A: [IDom] real = 1;
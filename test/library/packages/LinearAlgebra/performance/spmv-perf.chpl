@@ -0,0 +1,70 @@
+use LinearAlgebra;
+use LinearAlgebra.Sparse;
+use MatrixMarket;
+use IO;
+use Time;
+
+config const fname = "",        // MatrixMarket file to read
+             n = 1000,          // size of the generated matrix if no file
+             band = 5,          // half-bandwidth of the generated matrix
+             iters = 10,
+             correctness = false;
+
+// Generate a banded MatrixMarket file when no input is given
+proc writeBanded(path: string) {
+  var nnz = 0;
+  for i in 1..n do
+    nnz += (min(n, i+band) - max(1, i-band) + 1);
+
+  var f = open(path, iomode.cw);
+  var w = f.writer();
+  w.writeln("%%MatrixMarket matrix coordinate real general");
+  w.writeln(n, " ", n, " ", nnz);
+  for i in 1..n do
+    for j in max(1, i-band)..min(n, i+band) do
+      w.writeln(i, " ", j, " ", (i + j) % 7 + 1.0);
+  w.close();
+  f.close();
+}
+
+const path = if fname == "" then "spmv-perf.mtx" else fname;
+if fname == "" then writeBanded(path);
+
+const Acoo = mmreadsp(real, path);
+var csrDom = CSRDomain(Acoo.domain.parentDom);
+csrDom += Acoo.domain;
+var A: [csrDom] real;
+forall (i, j) in csrDom do A[i, j] = Acoo[i, j];
+const (M, N) = A.shape;
+
+var X: [1..N] real = [j in 1..N] (j % 3):real;
+var Y, Yref: [1..M] real;
+
+var t: Timer;
+
+// Reference: walk each row with dimIter and look up every element
+t.start();
+for 1..iters {
+  forall i in A.domain.dim(0) {
+    var sum = 0.0;
+    for j in A.domain.dimIter(1, i) do
+      sum += A[i, j] * X[j];
+    Yref[i] = sum;
+  }
+}
+t.stop();
+const refTime = t.elapsed();
+
+t.clear();
+t.start();
+for 1..iters do
+  SpMV(A, X, Y);
+t.stop();
+
+if correctness {
+  writeln(max reduce abs(Y - Yref) < 1e-9);
+} else {
+  writeln("nnz: ", A.domain.size);
+  writeln("dimIter lookup: ", refTime);
+  writeln("SpMV: ", t.elapsed());
+}
@@ -0,0 +1,8 @@
+use StructOfArrays;
+
+record R {
+  var x: int;
+}
+
+var A = new SoAArray(R, {1..3});
+A.field("y") = 1;
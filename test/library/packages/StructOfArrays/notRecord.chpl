@@ -0,0 +1,7 @@
+use StructOfArrays;
+
+class C {
+  var x: int;
+}
+
+var A = new SoAArray(C, {1..3});
@@ -0,0 +1,72 @@
+// Move particles whose position and velocity are a few of the fields of a
+// larger record, with the particles stored as an array of records and as an
+// SoAArray.
+use StructOfArrays, Time;
+
+config const n = 10_000;
+config const steps = 10;
+config const dt = 0.01;
+config const printTimings = false;
+
+record Particle {
+  var x, y, z: real;
+  var vx, vy, vz: real;
+  var fx, fy, fz: real;
+  var mass: real;
+  var id: int;
+}
+
+var t: Timer;
+
+var A: [1..n] Particle;
+
+forall (p, i) in zip(A, 1..) {
+  p.vx = i;
+  p.vy = 1.0;
+  p.vz = -1.0;
+  p.mass = 1.0;
+  p.id = i;
+}
+
+t.start();
+for 1..steps {
+  forall p in A {
+    p.x += p.vx * dt;
+    p.y += p.vy * dt;
+    p.z += p.vz * dt;
+  }
+}
+t.stop();
+const aosTime = t.elapsed();
+t.clear();
+
+var S = new SoAArray(Particle, {1..n});
+
+forall (p, i) in zip(S, 1..) {
+  p.field("vx") = i;
+  p.field("vy") = 1.0;
+  p.field("vz") = -1.0;
+  p.field("mass") = 1.0;
+  p.field("id") = i;
+}
+
+t.start();
+for 1..steps {
+  forall (x, y, z, vx, vy, vz) in zip(S.field("x"), S.field("y"),
+                                      S.field("z"), S.field("vx"),
+                                      S.field("vy"), S.field("vz")) {
+    x += vx * dt;
+    y += vy * dt;
+    z += vz * dt;
+  }
+}
+t.stop();
+const soaTime = t.elapsed();
+
+const same = && reduce [i in 1..n] (A[i] == S[i].read());
+writeln("Validation: ", if same then "SUCCESS" else "FAILURE");
+
+if printTimings {
+  writeln("AoS time: ", aosTime);
+  writeln("SoA time: ", soaTime);
+}
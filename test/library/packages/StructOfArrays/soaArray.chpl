@@ -0,0 +1,39 @@
+use StructOfArrays, BlockDist;
+
+record Particle {
+  var x, vx: real;
+  var id: int;
+}
+
+var P = new SoAArray(Particle, {1..5});
+
+for (p, i) in zip(P, 1..) do
+  p.write(new Particle(i, 0.5*i, i));
+
+forall (x, vx) in zip(P.field("x"), P.field("vx")) do
+  x += vx;
+
+P[2].field("id") = 20;
+writeln(P);
+writeln(P[3]);
+
+var r = P[4].read();
+writeln(r);
+
+forall p in P do
+  p.field("vx") *= 2;
+writeln(P.field("vx"));
+writeln(P.size, " ", P.indices);
+
+// Field arrays of a distributed SoAArray are distributed the same way
+const BD = {1..8} dmapped Block({1..8});
+var Q = new SoAArray(Particle, BD);
+
+forall (p, i) in zip(Q, BD) do
+  p.field("id") = i;
+writeln(Q.field("id"));
+writeln(&& reduce [i in BD] (Q.field("id")[i].locale == BD.dist.idxToLocale(i)));
+
+var M = new SoAArray(Particle, {1..2, 1..2});
+M[1, 2].field("x") = 1.5;
+writeln(M.field("x"));
@@ -0,0 +1,25 @@
+use CommDiagnostics;
+
+config const n = 100;
+
+var A: [1..n] int;
+var total = 0;
+
+resetCommDiagnostics();
+startCommDiagnostics();
+on Locales[numLocales-1] {
+  for i in 1..n do
+    A[i] = i;
+  for i in 1..n by 2 do
+    total += A[i];
+}
+stopCommDiagnostics();
+
+writeln(total);
+
+// Only report communication in this file; the rest depends on the
+// internal modules.
+for s in getCommDiagnosticsBySite() {
+  if s.filename.endsWith("commDiagsBySite.chpl") then
+    writeln((s.localeId, s.op, s.line, s.count, s.numBytes));
+}
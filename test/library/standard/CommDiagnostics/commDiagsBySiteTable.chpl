@@ -0,0 +1,15 @@
+use CommDiagnostics;
+
+config const n = 100;
+
+var A: [1..n] int;
+
+resetCommDiagnostics();
+startCommDiagnostics();
+on Locales[numLocales-1] {
+  for i in 1..n do
+    A[i] = i;
+}
+stopCommDiagnostics();
+
+printCommDiagnosticsBySite(top=-1);
@@ -0,0 +1,74 @@
+use Heap, List, Sort;
+
+config const n = 1000;
+
+// Pop everything and check that it comes out in order
+proc drain(ref h, comparator) {
+  var A: [0..#h.size] h.eltType;
+  for a in A do a = h.pop();
+  return isSorted(A, new ReverseComparator(comparator)) && h.isEmpty();
+}
+
+proc testArity(param arity, comparator) {
+  var A: [1..n] int;
+  for (a, i) in zip(A, 1..) do a = (i * 7919) % 1009;
+
+  // push one at a time
+  var h1 = new arrayHeap(int, false, arity, comparator);
+  for a in A do h1.push(a);
+  const top = h1.top();
+
+  // bulk build
+  var h2 = createArrayHeap(A, arity=arity, comparator=comparator);
+
+  // pushMany into a non-empty heap, in batches small and large
+  var h3 = new arrayHeap(int, true, arity, comparator);
+  h3.pushMany(A[1..10]);
+  h3.pushMany(A[11..20]);
+  h3.pushMany(A[21..n]);
+
+  // popMany returns the elements in order
+  var h4 = h2;
+  const B = h4.popMany(n/2);
+  const ok4 = isSorted(B, new ReverseComparator(comparator)) &&
+              h4.size == n - n/2 && B[0] == top;
+
+  writeln(arity, ": ", h2.top() == top && h3.top() == top, " ",
+          drain(h1, comparator), " ", drain(h2, comparator), " ",
+          drain(h3, comparator), " ", ok4, " ", drain(h4, comparator));
+}
+
+for param arity in 2..5 {
+  testArity(arity, defaultComparator);
+  testArity(arity, reverseComparator);
+}
+testArity(16, defaultComparator);
+
+// Lists and strings
+var l = new list(string);
+for s in ["pear", "apple", "fig", "kiwi", "plum"] do l.append(s);
+var hs = new arrayHeap(string, arity=3);
+hs.push("lime");
+hs.pushMany(l);
+writeln(hs.size, " ", hs.top());
+writeln(hs.toArray().sorted());
+for s in hs.consume() do write(s, " ");
+writeln();
+writeln(hs.size);
+
+// Owned elements are moved in and out
+class C { var x: int; }
+record byX { proc key(c) return c.x; }
+var ho = new arrayHeap(owned C, comparator=new byX());
+for i in 1..20 do ho.push(new owned C((i * 7) % 20));
+for i in 1..5 do write(ho.pop().x, " ");
+writeln();
+writeln(ho.size);
+
+// Assignment, including to itself
+var ha = new arrayHeap(int);
+for i in 1..10 do ha.push(i);
+var hb = new arrayHeap(int, arity=4);
+hb = ha;
+ha = ha;
+writeln(ha.size, " ", ha.top(), " ", hb.size, " ", hb.top());
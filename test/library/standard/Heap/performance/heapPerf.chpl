@@ -0,0 +1,60 @@
+// Compare heap with arrayHeap of several arities, pushing and popping
+// random values and running a hold-model event loop (pop the earliest
+// event, push a new one later in time).
+
+use Heap, Random, Time;
+
+config const perf = false;
+config const n = if perf then 2_000_000 else 1000;
+config const holdOps = if perf then 10_000_000 else 10000;
+config const seed = 314159265;
+
+var A: [1..n] real;
+fillRandom(A, seed);
+var D: [1..holdOps] real;
+fillRandom(D, seed+2);
+
+proc test(name: string, ref h) {
+  var t: Timer;
+  t.start();
+  for a in A do h.push(a);
+  var last = h.top(), ok = true;
+  for i in 1..n {
+    const x = h.pop();
+    ok &&= x >= last;
+    last = x;
+  }
+  t.stop();
+  const pushPop = t.elapsed();
+
+  t.clear();
+  t.start();
+  for a in A[1..n/10] do h.push(a);
+  for d in D do h.push(h.pop() + d);
+  t.stop();
+
+  if perf {
+    writef("%s-push-pop=%dr\n", name, pushPop);
+    writef("%s-hold=%dr\n", name, t.elapsed());
+  } else {
+    writeln(name, ": ", ok, " ", h.size == n/10);
+  }
+}
+
+var h = new heap(real, comparator=reverseComparator);
+test("heap", h);
+var h2 = new arrayHeap(real, arity=2, comparator=reverseComparator);
+test("arrayHeap2", h2);
+var h4 = new arrayHeap(real, arity=4, comparator=reverseComparator);
+test("arrayHeap4", h4);
+var h8 = new arrayHeap(real, arity=8, comparator=reverseComparator);
+test("arrayHeap8", h8);
+
+var t: Timer;
+t.start();
+var hb = createArrayHeap(A, comparator=reverseComparator);
+t.stop();
+if perf then
+  writef("createArrayHeap=%dr\n", t.elapsed());
+else
+  writeln("createArrayHeap: ", hb.size == n);
@@ -0,0 +1,31 @@
+use Map;
+
+config const n = 10000;
+
+var m = new map(int, int);
+
+assert(m.add(-1, 1));
+
+var keys: [1..n] int = [i in 1..n] i % (n/2);
+var vals: [1..n] int = [i in 1..n] -(i % (n/2));
+
+var added = m.bulkAdd(keys, vals);
+writeln(added);
+writeln(m.size);
+
+// an existing key keeps its value
+assert(m[-1] == 1);
+
+var ok = true;
+for i in 0..#(n/2) do
+  if !m.contains(i) || m[i] != -i then ok = false;
+writeln(ok);
+
+// adding the same keys again adds nothing
+writeln(m.bulkAdd(keys, vals));
+writeln(m.size);
+
+// the map still works normally afterwards
+assert(m.add(n, n));
+assert(m.remove(0));
+writeln(m.size);
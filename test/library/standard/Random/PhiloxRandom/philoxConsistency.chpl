@@ -0,0 +1,59 @@
+// The n-th value of a PhiloxRandomStream should not depend on how it was
+// generated: by getNext, getNth, philoxRandom, or filling an array in
+// parallel, including a distributed or multidimensional one.
+
+use Random, BlockDist;
+
+config const seed = 314159265;
+
+proc check(type t, D: domain) {
+  var A: [D] t;
+  fillRandom(A, seed, algorithm=RNG.PHILOX);
+
+  var stream = createRandomStream(t, seed, parSafe=false,
+                                  algorithm=RNG.PHILOX);
+  var ok = true;
+  for (a, n) in zip(A, 0..) {
+    const expected = philoxRandom(t, seed, n);
+    if a != expected || stream.getNext() != expected then
+      ok = false;
+  }
+  if stream.getNth(D.size/2) != philoxRandom(t, seed, D.size/2) then
+    ok = false;
+
+  // A second fill from the same stream continues where the first stopped
+  var B: [D] t;
+  stream.skipToNth(7);
+  stream.fillRandom(B);
+  for (b, n) in zip(B, 7..) do
+    if b != philoxRandom(t, seed, n) then ok = false;
+
+  writeln(t:string, " ", D.rank, "D ", if ok then "OK" else "FAILED");
+}
+
+proc checkTypes(D: domain) {
+  check(real, D);
+  check(real(32), D);
+  check(complex, D);
+  check(imag, D);
+  check(int, D);
+  check(uint(32), D);
+  check(int(8), D);
+  check(bool, D);
+}
+
+checkTypes({1..1000});
+checkTypes({1..10, 0..#37});
+checkTypes({1..200 by 3});
+checkTypes({1..4, 1..5, 1..6});
+checkTypes({1..1000} dmapped Block({1..1000}));
+
+// reals are in [0, 1)
+{
+  var A: [1..100000] real;
+  fillRandom(A, seed, algorithm=RNG.PHILOX);
+  writeln("real range ", if min reduce A >= 0.0 && max reduce A < 1.0
+                         then "OK" else "FAILED");
+}
+
+writeln(new owned PhiloxRandomStream(real, seed=17, parSafe=false));
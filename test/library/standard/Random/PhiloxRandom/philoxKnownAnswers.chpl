@@ -0,0 +1,18 @@
+// Check philox4x32 against the Philox4x32-10 known-answer vectors
+// published with the Random123 library.
+
+use Random;
+
+proc show(x: 4*uint(32)) {
+  for param i in 0..3 do writef("%08xu ", x[i]);
+  writeln();
+}
+
+show(philox4x32((0:uint(32), 0:uint(32), 0:uint(32), 0:uint(32)),
+                (0:uint(32), 0:uint(32))));
+show(philox4x32((0xffffffff:uint(32), 0xffffffff:uint(32),
+                 0xffffffff:uint(32), 0xffffffff:uint(32)),
+                (0xffffffff:uint(32), 0xffffffff:uint(32))));
+show(philox4x32((0x243f6a88:uint(32), 0x85a308d3:uint(32),
+                 0x13198a2e:uint(32), 0x03707344:uint(32)),
+                (0xa4093822:uint(32), 0x299f31d0:uint(32))));
@@ -0,0 +1,34 @@
+// Elements that take the same value from the stream still get different
+// values from the fill* procedures, since the value's position in the
+// stream is part of each element's seed.
+
+use Random, Sort;
+
+config const n = 1000;
+
+// A stream of real values that are all the same
+class ConstStream {
+  type eltType = real;
+  const seed = 17;
+
+  iter iterate(D: domain, type resultType=real) {
+    for i in D do yield 0.5;
+  }
+  iter iterate(D: domain, type resultType=real, param tag)
+      where tag == iterKind.leader {
+    for block in D.these(tag=tag) do yield block;
+  }
+  iter iterate(D: domain, type resultType=real, param tag, followThis)
+      where tag == iterKind.follower {
+    for i in D.these(tag=tag, followThis=followThis) do yield 0.5;
+  }
+}
+
+var A: [1..n] real;
+fillNormal(new ConstStream(), A);
+sort(A);
+writeln(&& reduce [i in 2..n] (A[i] != A[i-1]));
+
+fillExponential(new ConstStream(), A);
+sort(A);
+writeln(&& reduce [i in 2..n] (A[i] != A[i-1]));
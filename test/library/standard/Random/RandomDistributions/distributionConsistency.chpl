@@ -0,0 +1,61 @@
+// The fill* procedures produce the same values regardless of how the
+// array is distributed or traversed, and consume arr.size stream values.
+
+use Random, BlockDist;
+
+config const n = 10000;
+config const seed = 271828183;
+
+const Space = {1..n};
+const BlockSpace = Space dmapped Block(Space);
+
+proc same(param algorithm) {
+  var A: [Space] real, B: [BlockSpace] real;
+  var I: [Space] int, J: [BlockSpace] int;
+  var ok = true;
+
+  fillNormal(A, seed=seed, algorithm=algorithm);
+  fillNormal(B, seed=seed, algorithm=algorithm);
+  ok &&= && reduce (A == B);
+
+  fillExponential(A, seed=seed, algorithm=algorithm);
+  fillExponential(B, seed=seed, algorithm=algorithm);
+  ok &&= && reduce (A == B);
+
+  fillPoisson(I, 100.0, seed, algorithm);
+  fillPoisson(J, 100.0, seed, algorithm);
+  ok &&= && reduce (I == J);
+
+  fillBinomial(I, 100, 0.4, seed, algorithm);
+  fillBinomial(J, 100, 0.4, seed, algorithm);
+  ok &&= && reduce (I == J);
+
+  const table = new aliasTable([3.0, 1.0, 4.0, 1.0, 5.0]);
+  table.fill(I, seed, algorithm);
+  table.fill(J, seed, algorithm);
+  ok &&= && reduce (I == J);
+
+  // Filling two halves from one stream matches filling the whole array
+  var stream = createRandomStream(real, seed, parSafe=false,
+                                  algorithm=algorithm);
+  fillNormal(stream, A);
+  var stream2 = createRandomStream(real, seed, parSafe=false,
+                                   algorithm=algorithm);
+  fillNormal(stream2, B[1..n/2]);
+  fillNormal(stream2, B[n/2+1..n]);
+  ok &&= && reduce (A == B);
+
+  writeln(algorithm, ": ", ok);
+}
+
+same(RNG.PCG);
+same(RNG.NPB);
+same(RNG.PHILOX);
+
+// Invalid parameters throw
+var R: [1..10] real, I: [1..10] int;
+try { fillNormal(R, stddev=-1.0); } catch e { writeln(e.message()); }
+try { fillExponential(R, 0.0); } catch e { writeln(e.message()); }
+try { fillPoisson(I, -2.0); } catch e { writeln(e.message()); }
+try { fillBinomial(I, -1, 0.5); } catch e { writeln(e.message()); }
+try { fillBinomial(I, 10, 1.5); } catch e { writeln(e.message()); }
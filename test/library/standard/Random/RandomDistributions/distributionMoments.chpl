@@ -0,0 +1,64 @@
+// Check the sample moments of each distribution against the exact ones,
+// drawing uniform values from each RNG.
+
+use Random;
+
+config const n = 200000;
+config const seed = 314159265;
+
+// Is the sample mean within 5 standard errors of the exact mean, and the
+// sample variance within 5% of the exact variance?
+proc check(name: string, A: [], mean: real, variance: real) {
+  const m = (+ reduce A):real / n;
+  const v = (+ reduce ((A:real - m) ** 2)) / (n - 1);
+  const ok = abs(m - mean) <= 5.0 * sqrt(variance / n) &&
+             abs(v - variance) <= 0.05 * variance;
+  writeln(name, ": ", if ok then "OK" else "FAIL mean=" + m:string +
+                                           " variance=" + v:string);
+}
+
+proc test(param algorithm) {
+  writeln(algorithm);
+  var R: [1..n] real;
+  var I: [1..n] int;
+
+  fillNormal(R, 3.0, 2.0, seed, algorithm);
+  check("normal", R, 3.0, 4.0);
+
+  fillExponential(R, 0.5, seed, algorithm);
+  check("exponential", R, 2.0, 4.0);
+
+  for mean in [0.0, 0.5, 7.5, 40.0, 5000.0] {
+    fillPoisson(I, mean, seed, algorithm);
+    check("poisson(" + mean:string + ")", I, mean, mean);
+  }
+
+  for (trials, p) in [(20, 0.25), (1000, 0.5), (500, 0.97), (10, 1.0)] {
+    fillBinomial(I, trials, p, seed, algorithm);
+    check("binomial(" + trials:string + ", " + p:string + ")", I,
+          trials * p, trials * p * (1 - p));
+  }
+
+  // outcomes 0..3 with probabilities 0.1, 0.2, 0, 0.7
+  const table = new aliasTable([1, 2, 0, 7]);
+  table.fill(I, seed, algorithm);
+  check("alias", I, 2.3, 1.21);
+  writeln("alias never 2: ", && reduce (I != 2));
+
+  // the single-value samplers draw from a stream
+  var stream = createRandomStream(real, seed, algorithm=algorithm);
+  for r in R do r = randomNormal(stream);
+  check("randomNormal", R, 0.0, 1.0);
+  for r in R do r = randomExponential(stream, 4.0);
+  check("randomExponential", R, 0.25, 0.0625);
+  for i in I do i = randomPoisson(stream, 12.0);
+  check("randomPoisson", I, 12.0, 12.0);
+  for i in I do i = randomBinomial(stream, 50, 0.3);
+  check("randomBinomial", I, 15.0, 10.5);
+  for i in I do i = table.sample(stream);
+  check("aliasTable.sample", I, 2.3, 1.21);
+}
+
+test(RNG.PCG);
+test(RNG.NPB);
+test(RNG.PHILOX);
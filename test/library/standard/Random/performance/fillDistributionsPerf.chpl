@@ -0,0 +1,59 @@
+// Time filling a large array with non-uniform values, comparing the
+// samplers against the usual transforms of uniform values.
+
+use Random, Time;
+
+config const perf = false;
+config const n = if perf then 50_000_000 else 1000;
+config const seed = 314159265;
+
+var A, B: [1..n] real;
+var I: [1..n] int;
+var t: Timer;
+
+proc report(name: string, ok: bool) {
+  if perf then
+    writef("%s-time=%dr\n", name, t.elapsed());
+  else
+    writeln(name, ": ", ok);
+  t.clear();
+}
+
+t.start();
+fillRandom(A, seed);
+fillRandom(B, seed+2);
+A = sqrt(-2.0 * log(A)) * cos(2.0 * pi * B);
+t.stop();
+report("box-muller", && reduce (A == A));
+
+t.start();
+fillNormal(A, seed=seed);
+t.stop();
+report("normal", && reduce (A == A));
+
+t.start();
+fillRandom(A, seed);
+A = -log(A);
+t.stop();
+report("inverse-exponential", && reduce (A >= 0.0));
+
+t.start();
+fillExponential(A, seed=seed);
+t.stop();
+report("exponential", && reduce (A >= 0.0));
+
+t.start();
+fillPoisson(I, 100.0, seed);
+t.stop();
+report("poisson", && reduce (I >= 0));
+
+t.start();
+fillBinomial(I, 1000, 0.3, seed);
+t.stop();
+report("binomial", && reduce [i in I] (i >= 0 && i <= 1000));
+
+t.start();
+const table = new aliasTable([1.0, 2.0, 3.0, 4.0]);
+table.fill(I, seed);
+t.stop();
+report("alias", && reduce [i in I] (i >= 0 && i <= 3));
@@ -0,0 +1,24 @@
+// Time filling a large array with each RNG.
+
+use Random, Time;
+
+config const perf = false;
+config const n = if perf then 100_000_000 else 1000;
+config const seed = 314159265;
+
+var A: [1..n] real;
+
+proc test(param algorithm) {
+  var t: Timer; t.start();
+  fillRandom(A, seed, algorithm);
+  t.stop();
+
+  if perf then
+    writef("%s-time=%dr\n", algorithm:string, t.elapsed());
+  else
+    writeln(algorithm, ": ", + reduce A > 0.0);
+}
+
+test(RNG.PCG);
+test(RNG.NPB);
+test(RNG.PHILOX);
@@ -0,0 +1,16 @@
+// A profile collected by running a --profile-generate build of this
+// program should be used by a --profile-use build of it.
+config const n = 1000;
+
+// CHECK: @hot{{.*}} !prof
+proc hot(i: int) {
+  if i % 7 == 0 then
+    return i / 7;
+  return i;
+}
+
+var sum = 0;
+for i in 1..n do sum += hot(i);
+
+// CHECK: 439582
+writeln(sum);
@@ -0,0 +1,2 @@
+// --llvm-runtime-lto needs the LLVM backend
+writeln("hi");
@@ -0,0 +1,27 @@
+// Runtime functions optimized along with the generated code should behave
+// as they do when called in the runtime library.
+config const n = 1000;
+
+class C {
+  var x: int;
+}
+
+var a: [1..n] int;
+forall i in 1..n do a[i] = i;
+writeln(+ reduce a);
+
+var count: atomic int;
+coforall t in 1..4 do count.add(t);
+writeln(count.read());
+
+var s = "";
+for i in 1..5 do s += i:string;
+writeln(s, " ", s.size);
+
+var total = 0;
+for i in 1..n {
+  var c = new unmanaged C(i);
+  total += c.x;
+  delete c;
+}
+writeln(total);
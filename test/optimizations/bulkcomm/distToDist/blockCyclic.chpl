@@ -0,0 +1,112 @@
+use util;
+use BlockDist;
+use CyclicDist;
+use CommDiagnostics;
+
+config const n = 60;
+
+config const debug = false;
+
+proc printDebug(msg: string...) {
+  if debug then writeln((...msg));
+}
+
+proc makeDist(Dom : domain, param cyclic : bool) {
+  if cyclic then return Dom dmapped Cyclic(startIdx=Dom.low);
+  else return Dom dmapped Block(Dom);
+}
+
+proc testCore(DestDom : domain, param destCyclic : bool,
+              SrcDom  : domain, param srcCyclic  : bool) {
+  const AD = makeDist(DestDom, destCyclic);
+  const BD = makeDist(SrcDom, srcCyclic);
+
+  var A : [AD] int;
+  var B : [BD] int;
+
+  printDebug("      Simple Whole-Array Assignment");
+  stridedAssign(A, B);
+
+  printDebug("      Simple Strided Assignment");
+  stridedAssign(A, DestDom by 2, B, SrcDom by 2);
+
+  printDebug("      Single-Element Slice");
+  stridedAssign(A, DestDom by DestDom.shape, B, SrcDom by SrcDom.shape);
+
+  {
+    printDebug("      Half-Domain Assignment");
+    var HalfDest = DestDom.expand((DestDom.shape / -4) * DestDom.stride);
+    var HalfSrc  = SrcDom.expand((SrcDom.shape / -4) * SrcDom.stride);
+    stridedAssign(A, HalfDest, B, HalfSrc);
+  }
+
+  {
+    printDebug("      Shifted Assignment");
+    var Shifted = DestDom.translate(DestDom.stride * 3);
+    const SA = makeDist(Shifted, destCyclic);
+    var S : [SA] int;
+    stridedAssign(S, B);
+  }
+}
+
+proc testDists(param rank : int, param destCyclic : bool, param srcCyclic : bool) {
+  printDebug("  ----- rank=", rank:string, " dest cyclic=", destCyclic:string,
+             " src cyclic=", srcCyclic:string, " -----");
+  var denseRanges : rank*range;
+  const len = if rank <= 2 then n else n/3;
+  for i in 0..#rank do denseRanges(i) = 1..len;
+
+  var stridedRanges : rank*range(stridable=true);
+  for i in 0..#rank do stridedRanges(i) = 1.. by (i + 2) # len;
+
+  const Dense = {(...denseRanges)};
+  const Strided = {(...stridedRanges)};
+
+  printDebug("    ##### Dense <-- Dense #####");
+  testCore(Dense, destCyclic, Dense, srcCyclic);
+  printDebug("    ##### Dense <-- Strided #####");
+  testCore(Dense, destCyclic, Strided, srcCyclic);
+  printDebug("    ##### Strided <-- Dense #####");
+  testCore(Strided, destCyclic, Dense, srcCyclic);
+}
+
+proc testDim(param rank : int) {
+  testDists(rank, false, true);
+  testDists(rank, true, false);
+  testDists(rank, true, true);
+}
+
+//
+// Check that whole-array assignments between Block and Cyclic move each
+// locale's chunk in bulk, rather than one remote GET per element.
+//
+proc testBulk(param destCyclic : bool, param srcCyclic : bool) {
+  const Dom = {1..n, 1..n};
+  var A : [makeDist(Dom, destCyclic)] int;
+  var B : [makeDist(Dom, srcCyclic)] int = 1;
+
+  startCommDiagnostics();
+  A = B;
+  stopCommDiagnostics();
+  const diags = getCommDiagnostics();
+  resetCommDiagnostics();
+
+  const gets = + reduce (diags.get + diags.get_nb);
+  writeln(if destCyclic then "Cyclic" else "Block", " = ",
+          if srcCyclic then "Cyclic" else "Block", ": ",
+          if gets < Dom.size / 4 then "bulk" else "element-wise");
+  printDebug("      GETs: ", gets:string);
+  if !(&& reduce (A == 1)) then halt("mismatch in bulk assignment");
+}
+
+proc main() {
+  util.errorIfMismatch = true;
+  util.debugDefault = debug;
+
+  testDim(1);
+  testDim(2);
+  testDim(3);
+
+  testBulk(false, true);
+  testBulk(true, false);
+}
@@ -0,0 +1,86 @@
+// Virtual method calls that class hierarchy analysis can resolve to one or
+// two implementations, and ones that it can't.
+
+class Shape {
+  proc area(): real { return 0.0; }
+  proc name(): string { return "shape"; }
+}
+
+class Square : Shape {
+  var side: real;
+  override proc area(): real { return side*side; }
+  override proc name(): string { return "square"; }
+}
+
+class Rect : Shape {
+  var w, h: real;
+  override proc area(): real { return w*h; }
+}
+
+class Circle : Shape {
+  var r: real;
+  override proc area(): real { return 3.0*r*r; }
+}
+
+// Only Square is ever allocated below Unit, so calls are monomorphic
+class Unit {
+  proc value(): int { return 1; }
+}
+
+class Ten : Unit {
+  override proc value(): int { return 10; }
+}
+
+// Base sets the cid and then calls a method from its initializer, so the
+// Base implementation is reachable even though Base is never allocated.
+class Base {
+  var x: int;
+  proc init() {
+    this.complete();
+    x = describe();
+  }
+  proc describe(): int { return 1; }
+}
+
+class Derived : Base {
+  proc init() {
+    super.init();
+  }
+  override proc describe(): int { return 2; }
+}
+
+proc total(shapes: [] borrowed Shape) {
+  var sum = 0.0;
+  for s in shapes do
+    sum += s.area();
+  return sum;
+}
+
+proc names(shapes: [] borrowed Shape) {
+  for s in shapes do
+    write(s.name(), " ");
+  writeln();
+}
+
+proc getValue(u: borrowed Unit) {
+  return u.value();
+}
+
+proc getDescribe(b: borrowed Base) {
+  return b.describe();
+}
+
+var sq = new owned Square(2.0);
+var re = new owned Rect(2.0, 3.0);
+var ci = new owned Circle(1.0);
+var shapes = [sq.borrow(): borrowed Shape, re.borrow(): borrowed Shape,
+              ci.borrow(): borrowed Shape];
+
+writeln(total(shapes));
+names(shapes);
+
+var t = new owned Ten();
+writeln(getValue(t.borrow()));
+
+var d = new owned Derived();
+writeln(d.x, " ", getDescribe(d.borrow()));
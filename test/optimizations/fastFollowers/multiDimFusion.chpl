@@ -0,0 +1,118 @@
+// Zippered foralls and promoted expressions over aligned multidimensional
+// arrays use single-loop fast followers when every chunk of the leader is
+// a run of whole rows, and fall back to the regular followers otherwise.
+use BlockDist, ChapelDebugPrint;
+
+config const n = 100;
+
+proc fill(B: []) {
+  var r = 0.0;
+  for b in B {
+    b = r;
+    r += 1.0;
+  }
+}
+
+proc check(name: string, A: [], B: [], C: []) {
+  const alpha = 3.0;
+  A = 1.0;
+  fill(B);
+
+  C = A + alpha*B;
+  var ok = true;
+  for (a, b, c) in zip(A, B, C) do
+    if c != a + alpha*b then ok = false;
+
+  const dot = + reduce (B*C);
+  var expected = 0.0;
+  for (b, c) in zip(B, C) do expected += b*c;
+
+  writeln(name, ": ", ok && dot == expected);
+}
+
+// Each chunk is two whole rows, so the fast follower is used
+{
+  var A, B: [1..8, 1..4] real;
+  fill(B);
+  chpl__testParStart();
+  A = B + 1.0;
+  chpl__testParStop();
+  writeln(A);
+}
+
+// The rows are split across tasks, so the regular follower is used
+{
+  var A, B: [1..2, 1..8] real;
+  fill(B);
+  chpl__testParStart();
+  A = B + 1.0;
+  chpl__testParStop();
+  writeln(A);
+}
+
+// A Block array inside its bounding box follows each chunk of its local
+// block with the fast follower, whether or not the chunk is whole rows
+{
+  const D = {1..8, 1..4} dmapped Block({1..16, 1..4}, Locales[0..0]);
+  var A, B: [D] real;
+  fill(B);
+  chpl__testParStart();
+  A = B + 1.0;
+  chpl__testParStop();
+  writeln(A);
+}
+
+{
+  const D = {1..2, 1..8} dmapped Block({1..4, 1..8}, Locales[0..0]);
+  var A, B: [D] real;
+  fill(B);
+  chpl__testParStart();
+  A = B + 1.0;
+  chpl__testParStop();
+  writeln(A);
+}
+
+{
+  var A, B, C: [1..n, 1..n] real;
+  check("2D", A, B, C);
+}
+
+{
+  var A, B, C: [1..n, 0..2, 1..7] real;
+  check("3D", A, B, C);
+}
+
+{
+  var A: [1..n, 1..n] real;
+  var B: [0..n-1, 0..n-1] real;
+  var C: [2..n+1, -1..n-2] real;
+  check("same shape", A, B, C);
+}
+
+{
+  var A, B, C: [1..3, 1..n] real;
+  check("few rows", A, B, C);
+}
+
+{
+  var A, B, C: [1..n by 2, 1..n] real;
+  check("strided", A, B, C);
+}
+
+{
+  const D = {1..n, 1..n} dmapped Block({1..n, 1..n});
+  var A, B, C: [D] real;
+  check("Block", A, B, C);
+}
+
+{
+  const D = {0..n+1, 1..n} dmapped Block({1..n, 1..n});
+  var A, B, C: [D] real;
+  check("Block outside bounding box", A, B, C);
+}
+
+{
+  const D = {1..n/2, 1..n} dmapped Block({1..n, 1..n});
+  var A, B, C: [D] real;
+  check("Block inside bounding box", A, B, C);
+}
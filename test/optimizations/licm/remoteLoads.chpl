@@ -0,0 +1,83 @@
+// Loads through references to another locale that are not written in the
+// loop should be hoisted, and done as a single GET when most of the bytes of
+// a record are read.
+use CommDiagnostics;
+
+config const n = 1000;
+
+record R {
+  var a: int;
+  var b: int;
+}
+
+// most of the fields are read, but few of the bytes
+record RBig {
+  var a: int;
+  var b: int;
+  var unused: 100*int;
+}
+
+class C {
+  var x: int;
+}
+
+proc sumFields(const ref r: R) {
+  var sum = 0;
+  for i in 1..n do
+    sum += r.a * i + r.b;
+  return sum;
+}
+
+proc sumFields(const ref r: RBig) {
+  var sum = 0;
+  for i in 1..n do
+    sum += r.a * i + r.b;
+  return sum;
+}
+
+proc sumField(c: borrowed C) {
+  var sum = 0;
+  for i in 1..n do
+    sum += c.x + i;
+  return sum;
+}
+
+// 'x' may refer to 'r.a', so 'r.a' can't be hoisted
+proc sumWritten(const ref r: R, ref x: int) {
+  var sum = 0;
+  for i in 1..n {
+    x += 1;
+    sum += r.a;
+  }
+  return sum;
+}
+
+var r = new R(2, 7);
+var rBig = new RBig(2, 7);
+var c = new owned C(3);
+
+proc report(name: string, result: int) {
+  writeln(name, ": ", result, " gets: ", getCommDiagnostics()[numLocales-1].get);
+}
+
+var s1, s2, s3, s4: int;
+
+startCommDiagnostics();
+on Locales[numLocales-1] do s1 = sumFields(r);
+stopCommDiagnostics();
+report("sumFields", s1);
+
+resetCommDiagnostics();
+startCommDiagnostics();
+on Locales[numLocales-1] do s4 = sumFields(rBig);
+stopCommDiagnostics();
+report("sumFields(RBig)", s4);
+
+resetCommDiagnostics();
+startCommDiagnostics();
+on Locales[numLocales-1] do s2 = sumField(c.borrow());
+stopCommDiagnostics();
+report("sumField", s2);
+
+on Locales[numLocales-1] do s3 = sumWritten(r, r.a);
+writeln("sumWritten: ", s3, " ", r.a);
@@ -0,0 +1,56 @@
+// Class instances that do not escape are allocated on the stack, ones that
+// do stay on the heap.
+
+class Counter {
+  var count: int;
+  proc add(x: int) { count += x; }
+}
+
+class Noisy {
+  var id: int;
+  proc deinit() { writeln("deinit ", id); }
+}
+
+var saved: unmanaged Counter?;
+
+proc sumLocal(n: int) {
+  var total = 0;
+  for i in 1..n {
+    var c = new unmanaged Counter();
+    c.add(i);
+    c.add(i);
+    total += c.count;
+    delete c;
+  }
+  return total;
+}
+
+proc deinitRuns() {
+  var x = new unmanaged Noisy(1);
+  delete x;
+}
+
+proc leak(n: int) {
+  var c = new unmanaged Counter(n);
+  saved = c;
+}
+
+proc make(n: int) {
+  var c = new unmanaged Counter(n);
+  return c;
+}
+
+proc useOwned() {
+  var o = new owned Counter(3);
+  return o.count;
+}
+
+writeln(sumLocal(10));
+deinitRuns();
+leak(5);
+writeln(saved!.count);
+delete saved;
+var m = make(7);
+writeln(m.count);
+delete m;
+writeln(useOwned());
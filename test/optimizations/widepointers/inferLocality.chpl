@@ -0,0 +1,49 @@
+// Calls passing local data to formals that are wide because of other calls
+// are redirected to a clone in which those formals are treated as local.
+
+class C {
+  var x: int;
+
+  proc bump() {
+    x += 1;
+  }
+}
+
+record R {
+  var a: int;
+}
+
+proc addTo(c: borrowed C, n: int) {
+  for i in 1..n do
+    c.x += i;
+}
+
+proc incr(ref r: R, n: int) {
+  for i in 1..n do
+    r.a += i;
+}
+
+var remote = new owned C(100);
+var rr: R;
+
+on Locales[numLocales-1] {
+  addTo(remote.borrow(), 3);
+  remote.bump();
+  incr(rr, 2);
+}
+
+proc main() {
+  var c = new unmanaged C(1);
+  addTo(c, 10);
+  c.bump();
+
+  var r: R;
+  incr(r, 4);
+
+  // Not known to be local
+  addTo(remote.borrow(), 4);
+
+  writeln(c.x, " ", r.a);
+  writeln(remote.x, " ", rr.a);
+  delete c;
+}
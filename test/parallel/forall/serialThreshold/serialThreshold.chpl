@@ -0,0 +1,49 @@
+// Loops over fewer indices than dataParSerialThreshold run on the current
+// task instead of creating tasks.
+use DynamicIters;
+
+config const n = 50;
+
+const D = {1..n};
+var A: [D] int;
+
+proc report(name: string, maxTasks: int) {
+  writeln(name, ": ", + reduce A, " serial: ", maxTasks == 1);
+  A = 0;
+}
+
+var maxTasks = 0;
+
+forall i in 1..n with (max reduce maxTasks) {
+  A[i] = i;
+  maxTasks = max(maxTasks, here.runningTasks());
+}
+report("range", maxTasks);
+
+maxTasks = 0;
+forall i in D with (max reduce maxTasks) {
+  A[i] = i;
+  maxTasks = max(maxTasks, here.runningTasks());
+}
+report("domain", maxTasks);
+
+maxTasks = 0;
+forall (a, i) in zip(A, D) with (max reduce maxTasks) {
+  a = i;
+  maxTasks = max(maxTasks, here.runningTasks());
+}
+report("array", maxTasks);
+
+maxTasks = 0;
+forall i in dynamic(1..n) with (max reduce maxTasks) {
+  A[i] = i;
+  maxTasks = max(maxTasks, here.runningTasks());
+}
+report("dynamic", maxTasks);
+
+maxTasks = 0;
+forall i in guided(D) with (max reduce maxTasks) {
+  A[i] = i;
+  maxTasks = max(maxTasks, here.runningTasks());
+}
+report("guided", maxTasks);
@@ -0,0 +1,72 @@
+// channel.matches should report the same matches as searching the whole
+// text in memory, including matches that cross I/O buffer boundaries.
+
+use IO, List, Regexp;
+
+config const n = 1000000;
+
+var text: string;
+{
+  var alphabet = "abcxyz 019\n";
+  var x = 12345: uint;
+  var parts: [0..#n] string;
+  for i in 0..#n {
+    x = x * 6364136223846793005 + 1442695040888963407;
+    parts[i] = alphabet[((x >> 33) % alphabet.size: uint): int];
+  }
+  // Plant matches across the I/O buffer boundaries
+  const tokens = ["abc", "xyz19", "\nab\n", "z 9", "c  \n"];
+  for k in 1..n/65536 {
+    const tok = tokens[k % tokens.size];
+    const start = k*65536 - 1 - (k % tok.size);
+    for (j, ch) in zip(0.., tok.items()) do parts[start+j] = ch;
+  }
+  text = "".join(parts);
+}
+
+const f = opentmp();
+{
+  var w = f.writer();
+  w.write(text);
+  w.close();
+}
+
+proc check(pattern: string) {
+  const re = compile(pattern);
+  var expected, got: list((int, int, int));
+  for (m, c) in re.matches(text, 1) do
+    expected.append((m.offset: int, m.size, c.offset: int));
+
+  var r = f.reader();
+  for (m, c) in r.matches(re, 1) {
+    var s: string;
+    r.extractMatch(m, s);
+    if s != text[m.offset..#m.size] then
+      writeln(pattern, ": wrong text at ", m.offset);
+    got.append((m.offset: int, m.size, c.offset: int));
+  }
+  r.close();
+
+  if expected.size == 0 then
+    writeln(pattern, ": no matches");
+  else if got.size != expected.size ||
+          || reduce [i in 0..#got.size] got[i] != expected[i] then
+    writeln(pattern, ": expected ", expected, " got ", got);
+  else
+    writeln(pattern, ": OK");
+}
+
+check("(a)bc");
+check("x(y)?z[0-9]{2}");
+check("\\b(ab|ba)\\b");
+check("(c) *\\n");
+check("(?m)^([a-z ])[a-z0-9 ]{0,5}$");
+check("(z)[^\\n]*9");
+
+// Searching an empty channel should not find anything
+{
+  const empty = openmem();
+  var r = empty.reader();
+  writeln("empty: ", r.search(compile("a?b")).matched);
+  writeln("empty: ", r.search(compile("")).matched);
+}
@@ -0,0 +1,64 @@
+// Scan a synthetic log file with channel.matches and channel.search.
+
+use IO, Regexp, Time;
+
+config const numLines = 1000000;
+config const timing = true;
+
+const f = opentmp();
+{
+  var w = f.writer();
+  for i in 0..#numLines {
+    if i % 1000 == 999 then
+      w.writeln("2020-06-01 12:00:00 svc", i % 17, " ERROR ", i % 1000,
+                " request failed");
+    else
+      w.writeln("2020-06-01 12:00:00 svc", i % 17, " INFO request ok id=", i);
+  }
+  w.writeln("LAST LINE");
+  w.close();
+}
+
+var t: Timer;
+
+t.start();
+var count = 0;
+{
+  var r = f.reader();
+  for (m,) in r.matches(compile("ERROR [0-9]{3}")) {
+    var s: string;
+    r.extractMatch(m, s);
+    if s == "ERROR 999" then count += 1;
+  }
+}
+t.stop();
+if timing then writeln("bounded matches: ", t.elapsed());
+t.clear();
+
+t.start();
+var found: bool;
+{
+  var r = f.reader();
+  found = r.search(compile("LAST LINE")).matched;
+}
+t.stop();
+if timing then writeln("bounded search: ", t.elapsed());
+t.clear();
+
+t.start();
+var unboundedCount = 0;
+{
+  var r = f.reader();
+  for (m,) in r.matches(compile("ERROR [0-9]+")) {
+    var s: string;
+    r.extractMatch(m, s);
+    if s == "ERROR 999" then unboundedCount += 1;
+  }
+}
+t.stop();
+if timing then writeln("unbounded matches: ", t.elapsed());
+
+if count == numLines/1000 && unboundedCount == count && found then
+  writeln("SUCCESS");
+else
+  writeln("FAILURE ", count, " ", unboundedCount, " ", found);
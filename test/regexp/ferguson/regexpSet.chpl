@@ -0,0 +1,70 @@
+use Regexp;
+use IO;
+
+writeln("+string set");
+{
+  var s = compileSet(["ERROR", "WARN(ING)?", "time(out)?", "^\\d+$"]);
+  writeln(s.size);
+  writeln(s);
+  writeln(s.matchingPatterns("WARNING: timeout on node 3"));
+  writeln(s.matchingPatterns("12345"));
+  writeln(s.matchingPatterns("nothing here").size);
+  writeln(s.matchesAny("an ERROR"), " ", s.matchesAny("fine"));
+
+  // copies share the compiled set
+  var t = s;
+  writeln(t.matchingPatterns("ERROR at time 5"));
+}
+
+writeln("+bytes set");
+{
+  var s = compileSet([b"\xff\xfe", b"ab+c"]);
+  writeln(s.matchingPatterns(b"xx\xff\xfeabbbc"));
+}
+
+writeln("+options");
+{
+  var s = compileSet(["error", "a.b"], ignoreCase=true, literal=true);
+  writeln(s.matchingPatterns("ERROR in a.b"));
+  writeln(s.matchingPatterns("axb"));
+}
+
+writeln("+bad pattern");
+try {
+  var s = compileSet(["ok", "(unclosed"]);
+} catch e: BadRegexpError {
+  writeln(e.message());
+} catch {
+  writeln("unexpected error");
+}
+
+writeln("+empty set");
+{
+  var empty: [1..0] string;
+  var s = compileSet(empty);
+  writeln(s.size, " ", s.matchesAny("anything"));
+}
+
+writeln("+channel");
+{
+  var f = openmem();
+  {
+    var w = f.writer();
+    w.writeln("INFO starting");
+    w.writeln("WARN disk almost full");
+    w.writeln("ERROR timeout talking to node 7");
+    w.write("INFO done");
+    w.close();
+  }
+  var s = compileSet(["ERROR", "WARN", "timeout", "done$"]);
+  var r = f.reader();
+  for (m, id) in r.matches(s) do
+    writeln(m.offset, " ", m.size, " ", id);
+  r.close();
+
+  r = f.reader();
+  for (m, id) in r.matches(s, maxmatches=2) do
+    writeln(m.offset, " ", m.size, " ", id);
+  writeln("offset ", r.offset());
+  r.close();
+}
@@ -0,0 +1,14 @@
+use Regexp;
+
+// A default-initialized set has no patterns and matches nothing
+var s: regexpSet(string);
+writeln(s.size);
+writeln(s);
+writeln(s.matchesAny("anything"));
+writeln(s.matchingPatterns("anything").size);
+
+var t = s;
+writeln(t.size);
+
+var b: regexpSet(bytes);
+writeln(b.matchesAny(b"anything"), " ", b.matchingPatterns(b"x").size);
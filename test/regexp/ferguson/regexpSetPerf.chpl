@@ -0,0 +1,42 @@
+// Classify synthetic log lines against many patterns, once with a regexpSet
+// and once by trying each compiled regexp in turn.
+
+use Regexp, Time;
+
+config const numPatterns = 200;
+config const numLines = 10000;
+config const timing = true;
+
+var patterns: [0..#numPatterns] string;
+for i in 0..#numPatterns do
+  patterns[i] = "svc" + i:string + "\\b.*(fail|timeout)";
+
+var lines: [0..#numLines] string;
+for i in 0..#numLines do
+  lines[i] = "2020-06-01 12:00:00 svc" + ((i*37) % (2*numPatterns)):string +
+             (if i % 3 == 0 then " request timeout" else " request ok");
+
+var t: Timer;
+
+t.start();
+const set = compileSet(patterns);
+var setCounts: [0..#numPatterns] int;
+for line in lines do
+  for id in set.matchingPatterns(line) do
+    setCounts[id] += 1;
+t.stop();
+if timing then writeln("regexpSet: ", t.elapsed());
+t.clear();
+
+t.start();
+var res: [0..#numPatterns] regexp(string);
+for (r, p) in zip(res, patterns) do r = compile(p);
+var loopCounts: [0..#numPatterns] int;
+for line in lines do
+  for (r, i) in zip(res, 0..) do
+    if r.search(line) then loopCounts[i] += 1;
+t.stop();
+if timing then writeln("per-pattern loop: ", t.elapsed());
+
+if setCounts.equals(loopCounts) && + reduce setCounts > 0 then
+  writeln("SUCCESS");
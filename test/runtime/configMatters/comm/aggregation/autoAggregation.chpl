@@ -0,0 +1,41 @@
+// Test that remote assignments at the end of forall bodies produce the
+// right results when they are aggregated (--auto-aggregation), both for
+// scatters (aggregated PUTs) and gathers (aggregated GETs).
+
+use BlockDist, Random;
+
+config const n = 100000;
+
+const D = {0..#n} dmapped Block({0..#n});
+var A, B, Src, Neg: [D] int;
+var perm, next: [D] int;
+
+// build a permutation so every element is written exactly once
+forall i in D {
+  perm[i] = i;
+  Src[i] = 2*i;
+  Neg[i] = -i;
+}
+shuffle(perm, seed=314159);
+forall i in D do next[i] = perm[(i+1)%n];
+
+// scatter: remote puts
+forall i in D do
+  A[perm[i]] = Src[i];
+
+// gather: remote gets
+forall i in D do
+  B[i] = A[next[i]];
+
+// nested in an on-statement, so the on-body task flushes its buffers
+on Locales[numLocales-1] {
+  forall i in D do
+    A[perm[i]] = Neg[i];
+}
+
+var ok = true;
+forall i in D with (&& reduce ok) {
+  ok &&= B[i] == 2*((i+1)%n);
+  ok &&= A[perm[i]] == -i;
+}
+writeln(if ok then "OK" else "FAILED");
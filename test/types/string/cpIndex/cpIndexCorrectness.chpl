@@ -0,0 +1,54 @@
+// Check codepoint indexing and slicing of long non-ASCII strings, which use
+// a breadcrumb index, against a walk over the codepoints.
+
+config const n = 1000;
+
+proc build(n: int) {
+  const pieces = ["a", "é", "€", "😀", "bc"];
+  var s: string;
+  for i in 0..#n do s += pieces[(i*7) % pieces.size];
+  return s;
+}
+
+proc check(const ref s: string) {
+  var cps: [0..#s.size] string;
+  for (c, i) in zip(s.items(), 0..) do cps[i] = c;
+
+  for i in 0..#s.size {
+    if s[i] != cps[i] then halt("s[", i, "] mismatch");
+    if s.codepoint(i) != cps[i].toCodepoint() then
+      halt("s.codepoint(", i, ") mismatch");
+  }
+
+  for lo in 0..#s.size by 37 {
+    for len in [0, 1, 5, 31, 32, 33, 100] {
+      const hi = min(lo+len-1, s.size-1);
+      var expected: string;
+      for i in lo..hi do expected += cps[i];
+      if s[lo..hi] != expected then halt("s[", lo, "..", hi, "] mismatch");
+    }
+    var tail: string;
+    for i in lo..<s.size do tail += cps[i];
+    if s[lo..] != tail then halt("s[", lo, "..] mismatch");
+  }
+}
+
+var s = build(n);
+check(s);
+
+// appending and assigning must drop the old index
+s += "ü";
+check(s);
+if s[s.size-1] != "ü" then halt("append not seen");
+
+s = build(n/2) + "xyz";
+check(s);
+if s[s.size-1] != "z" then halt("assignment not seen");
+
+// indexing the same string from many tasks
+const t = build(n);
+forall i in 0..#t.size with (const ref t) {
+  if t[i] != t[i:codepointIndex] then halt("parallel mismatch at ", i);
+}
+
+writeln("OK");
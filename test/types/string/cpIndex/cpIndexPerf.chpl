@@ -0,0 +1,54 @@
+// Random codepoint indexing and slicing of a long non-ASCII string. Without
+// the breadcrumb index every access walks from the start of the string.
+
+use Time, Random;
+
+config const n = 100000;
+config const numAccesses = 100000;
+config const timing = true;
+
+var s: string;
+{
+  const pieces = ["a", "é", "€", "😀", "bc"];
+  for i in 0..#n do s += pieces[(i*7) % pieces.size];
+}
+const numCodepoints = s.size;
+
+var idxs: [0..#numAccesses] int;
+fillRandom(idxs, seed=17);
+idxs = mod(idxs, numCodepoints);
+
+var t: Timer;
+
+t.start();
+var nBytes = 0;
+for i in idxs do nBytes += s[i].numBytes;
+t.stop();
+if timing then writeln("index: ", t.elapsed());
+t.clear();
+
+t.start();
+var cpSum = 0;
+for i in idxs do cpSum += s.codepoint(i);
+t.stop();
+if timing then writeln("codepoint: ", t.elapsed());
+t.clear();
+
+t.start();
+var sliceLen = 0;
+for i in idxs do sliceLen += s[i..#min(10, numCodepoints-i)].size;
+t.stop();
+if timing then writeln("slice: ", t.elapsed());
+
+// check the results against a single walk over the string
+var cps: [0..#numCodepoints] int;
+for (cp, i) in zip(s.codepoints(), 0..) do cps[i] = cp;
+var expectedBytes = 0, expectedSum = 0, expectedLen = 0;
+for i in idxs {
+  expectedBytes += codepointToString(cps[i]:int(32)).numBytes;
+  expectedSum += cps[i];
+  expectedLen += min(10, numCodepoints-i);
+}
+
+if nBytes == expectedBytes && cpSum == expectedSum && sliceLen == expectedLen then
+  writeln("SUCCESS");
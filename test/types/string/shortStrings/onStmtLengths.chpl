@@ -0,0 +1,25 @@
+// Strings and bytes of every length around the inline serialization
+// threshold survive being passed to an on-statement.
+
+config const maxLen = 40;
+
+const alphabet = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOP";
+const target = Locales[numLocales-1];
+
+var ok = true;
+for len in 0..maxLen {
+  const s = alphabet[0..#len];
+  const b = s:bytes;
+  const u = "é" * len;
+
+  on target {
+    if s.size != len || s != alphabet[0..#len] then ok = false;
+    if b.size != len || b != alphabet[0..#len]:bytes then ok = false;
+    if u.size != len || u.numBytes != 2*len then ok = false;
+
+    // a copy made on the remote locale must outlive the original
+    var copies: [1..2] string = [s, u];
+    if copies[1] != s || copies[2].size != len then ok = false;
+  }
+}
+writeln(if ok then "SUCCESS" else "FAILURE");
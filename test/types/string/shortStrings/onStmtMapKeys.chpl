@@ -0,0 +1,34 @@
+// Counts short string keys in one map(string, int) per locale, sending
+// each key to the locale that owns it, as a distributed word count does.
+
+use BlockDist, Map, Time;
+
+config const numKeys = 10000;
+config const numOps = 1000000;
+config const timing = true;
+
+var keys: [0..#numKeys] string = [i in 0..#numKeys] "key-" + i:string;
+
+const PrivSpace = LocaleSpace dmapped Block(LocaleSpace);
+var counts: [PrivSpace] map(string, int);
+
+var t: Timer;
+t.start();
+for i in 0..#numOps {
+  const k = (i * 40503) % numKeys;
+  const key = keys[k];
+  on counts[k % numLocales] do
+    counts[here.id][key] += 1;
+}
+t.stop();
+
+if timing then
+  writeln("on-stmt map<string,int>: ", t.elapsed());
+
+var total = 0, size = 0;
+for c in counts {
+  for v in c.values() do total += v;
+  size += c.size;
+}
+if total == numOps && size == min(numKeys, numOps) then
+  writeln("SUCCESS");
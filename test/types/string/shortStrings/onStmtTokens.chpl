@@ -0,0 +1,49 @@
+// Passes short tokens one at a time to an on-statement on another locale.
+// Tokens up to CHPL_SHORT_STRING_SIZE bytes are serialized inline, so the
+// remote side should not need to GET their data.
+
+use CommDiagnostics, Time;
+
+enum types { asciiString, byteString }
+
+config param testType = types.asciiString;
+
+type dataType = if testType == types.byteString then bytes else string;
+
+config const numTokens = 100000;
+config const timing = true;
+
+const words = ["a", "the", "map", "token", "string", "element",
+               "distribution", "communication", "short-key-0123"];
+const target = Locales[numLocales-1];
+
+var tokens: [0..#numTokens] dataType =
+  [i in 0..#numTokens] words[(i*31) % words.size]:dataType;
+
+var totalLen: atomic int;
+
+var t: Timer;
+startCommDiagnostics();
+t.start();
+for i in tokens.domain {
+  const tok = tokens[i];
+  on target do
+    totalLen.add(tok.size);
+}
+t.stop();
+stopCommDiagnostics();
+
+const gets = + reduce (getCommDiagnostics().get +
+                       getCommDiagnostics().get_nb);
+
+var expectedLen = 0;
+for i in 0..#numTokens do
+  expectedLen += words[(i*31) % words.size].size;
+
+if timing then
+  writeln("on-stmt tokens: ", t.elapsed());
+
+if totalLen.read() == expectedLen && gets == 0 then
+  writeln("SUCCESS");
+else
+  writeln("FAILURE: ", totalLen.read(), " ", expectedLen, " ", gets, " GETs");
@@ -0,0 +1,40 @@
+// Validation scans ASCII runs many bytes at a time; check that multibyte
+// characters, escapes and invalid bytes are handled at every offset around
+// the block boundaries.
+
+const multibyte = [b"\xc3\xa9", b"\xe2\x82\xac", b"\xf0\x9f\x98\x80"];
+
+var ok = true;
+for len in 1..70 {
+  for off in 0..<len {
+    for mb in multibyte {
+      var b = b"a" * off + mb + b"b" * (len - off);
+      try! {
+        const s = createStringWithNewBuffer(b.c_str(), b.size);
+        if s.size != len + 1 then ok = false;
+        if s.numBytes != b.size then ok = false;
+        var n = 0;
+        for cp in s.codepoints() do n += 1;
+        if n != len + 1 then ok = false;
+      }
+    }
+
+    // a lone continuation byte, and a truncated sequence at the end
+    for bad in [b"\x80", b"\xe2\x82"] {
+      var b = b"a" * off + bad + (if bad.size == 1 then b"b" * (len - off)
+                                                 else b"");
+      try {
+        createStringWithNewBuffer(b.c_str(), b.size);
+        ok = false;
+      } catch e: DecodeError {
+      } catch {
+        ok = false;
+      }
+
+      // escaped, the bad bytes become one codepoint each
+      const s = b.decode(policy=decodePolicy.escape);
+      if s.size != b.size then ok = false;
+    }
+  }
+}
+writeln(ok);
@@ -0,0 +1,38 @@
+// Times validating large buffers as UTF-8 and walking their codepoints.
+
+use Time;
+
+config const n = 100000000;
+config const timing = true;
+
+var asciiBytes = b"0123456789abcdefghijklmnopqrstuvwxyz" * (n / 36);
+var mixedBytes = b"0123456789 caf\xc3\xa9 \xe2\x82\xac " * (n / 21);
+
+var t: Timer;
+
+t.start();
+const ascii = try! createStringWithNewBuffer(asciiBytes.c_str(), asciiBytes.size);
+t.stop();
+const asciiTime = t.elapsed();
+
+t.clear();
+t.start();
+const mixed = try! createStringWithNewBuffer(mixedBytes.c_str(), mixedBytes.size);
+t.stop();
+const mixedTime = t.elapsed();
+
+t.clear();
+t.start();
+var sum = 0;
+for cp in ascii.codepoints() do sum += cp;
+t.stop();
+const iterTime = t.elapsed();
+
+if timing {
+  writeln("validate ascii: ", asciiTime);
+  writeln("validate mixed: ", mixedTime);
+  writeln("ascii codepoints: ", iterTime);
+}
+
+if ascii.size == asciiBytes.size && mixed.size == mixedBytes.size - 3 * (n / 21) && sum > 0 then
+  writeln("SUCCESS");
@@ -32,11 +32,19 @@
 #include <time.h>
 #include <assert.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 
 // C++ Libraries
 #include <set>
+#include <vector>
+#include <algorithm>
+
+// Binary record layout, shared with the runtime
+#include "chpl-visual-debug-format.h"
 
 #ifndef MAXPATHLEN
 #define MAXPATHLEN 2048
@@ -44,8 +52,12 @@
 
 #define MAX_LINE_LEN 1024
 
-#define EXPECTED_VMAJOR 1
-#define EXPECTED_VMINOR 4
+// Version 2.0 files are written by current runtimes, 1.4 files by
+// older ones.
+#define EXPECTED_VMAJOR CHPL_VDEBUG_VER_MAJOR
+#define EXPECTED_VMINOR CHPL_VDEBUG_VER_MINOR
+#define TEXT_VMAJOR 1
+#define TEXT_VMINOR 4
 
 void DataModel::newList()
 {
@@ -146,14 +158,20 @@ int DataModel::LoadData(const char * filename, bool fromArgv)
   }
   fclose(data);
 
-  // Should make this more parameterized !!!!
-  if (VerMajor != EXPECTED_VMAJOR || VerMinor != EXPECTED_VMINOR) {
+  if ((VerMajor != EXPECTED_VMAJOR || VerMinor != EXPECTED_VMINOR)
+      && (VerMajor != TEXT_VMAJOR || VerMinor != TEXT_VMINOR)) {
     if (!fromArgv)
-      fl_alert("VisualDebug data files are not version %d.%d - got %d.%d", EXPECTED_VMAJOR, EXPECTED_VMINOR, VerMajor, VerMinor);
+      fl_alert("VisualDebug data files are not version %d.%d or %d.%d - got %d.%d",
+               EXPECTED_VMAJOR, EXPECTED_VMINOR, TEXT_VMAJOR, TEXT_VMINOR,
+               VerMajor, VerMinor);
     else
-      printf("VisualDebug data files are not version %d.%d - got %d.%d\n", EXPECTED_VMAJOR, EXPECTED_VMINOR, VerMajor, VerMinor);
+      printf("VisualDebug data files are not version %d.%d or %d.%d - got %d.%d\n",
+             EXPECTED_VMAJOR, EXPECTED_VMINOR, TEXT_VMAJOR, TEXT_VMINOR,
+             VerMajor, VerMinor);
     return 0;
   }
+  verMajor = VerMajor;
+  verMinor = VerMinor;
 
   char fname[namesize+15];
   // printf ("LoadData: nlocalse = %d, fnum = %d seq = %.3lf\n", nlocales, fnum, seq);
@@ -808,6 +826,7 @@ int DataModel::LoadFile (const char *fileToOpen, int index, double seq)
   int VerMajor, VerMinor;
 
   int  nErrs = 0;
+  bool sawClock = false;
 
   if (!data) return 0;
 
@@ -835,7 +854,8 @@ int DataModel::LoadFile (const char *fileToOpen, int index, double seq)
 
   // Verify the data
 
-  if (floc != numLocales || findex != index || fabs(seq-fseq) > .01 || VerMinor != EXPECTED_VMINOR) {
+  if (floc != numLocales || findex != index || fabs(seq-fseq) > .01
+      || VerMajor != verMajor || VerMinor != verMinor) {
     fprintf (stderr, "Data file %s does not match other data.\n", fileToOpen);
     return 0;
   }
@@ -900,6 +920,26 @@ int DataModel::LoadFile (const char *fileToOpen, int index, double seq)
 
     int cvt;
 
+    // Version 2.0: the rest of the file is binary records
+    if (verMajor >= 2 && strstr(line, "Clock:") == line) {
+      long clockNs;
+      int binErrs;
+      if (sscanf(line, "Clock: %ld", &clockNs) != 1) {
+        fprintf (stderr, "Bad 'Clock' line: %s\n", fileToOpen);
+        fclose(data);
+        return 0;
+      }
+      binErrs = LoadBinaryRecords(fileToOpen, ftell(data), findex, clockNs,
+                                  e_sec, e_usec, itr, vdbTids, nid0vdbtask);
+      if (binErrs < 0) {
+        fclose(data);
+        return 0;
+      }
+      nErrs += binErrs;
+      sawClock = true;
+      break;
+    }
+
     // Process the line
     linedata = strchr(line, ':');
     if (linedata) {
@@ -1180,65 +1220,8 @@ int DataModel::LoadFile (const char *fileToOpen, int index, double seq)
     }
 
     //  Add the newEvent to the list, group Starts, Tags, Resumes and Ends together.
-    if (newEvent) {
-      if (theEvents.empty()) {
-        theEvents.push_front (newEvent);
-      } else if (itr == theEvents.end()) {
-        theEvents.insert(itr, newEvent);
-      } else {
-        if (newEvent->Ekind() <= Ev_end) {
-          // Group together
-          while (itr != theEvents.end()
-                 && (*itr)->Ekind() != newEvent->Ekind())
-            itr++;
-          if (itr == theEvents.end() || (*itr)->Ekind() != newEvent->Ekind()) {
-            fprintf (stderr, "Internal error, event mismatch. file '%s'\n", fileToOpen); \
-            printf ("newEvent: "); newEvent->print();
-            if (itr != theEvents.end()) {
-               printf ("itr: "); (*itr)->print();
-            } else {
-               printf ("At end of list\n");
-            }
-          } else {
-            // More complicated ... move past proper kinds ...
-            E_tag *tp = NULL;
-            if (newEvent->Ekind() == Ev_start || newEvent->Ekind() == Ev_end) {
-              // Just find the end of the group
-              while (itr != theEvents.end() && (*itr)->Ekind() == newEvent->Ekind())
-                itr++;
-            } else {
-              // Need to move past them only if they have the same tag!
-              if (newEvent->Ekind() == Ev_tag) {
-                // Work with tags
-                tp = (E_tag *)newEvent;
-                while (itr != theEvents.end()
-                       && (*itr)->Ekind() == Ev_tag
-                       && ((E_tag *)(*itr))->tagNo() == tp->tagNo())
-                  itr++;
-              } else {
-                // Work with pauses
-                E_pause *rp = (E_pause *)newEvent;
-                while (itr != theEvents.end()
-                       && (*itr)->Ekind() == Ev_pause
-                       && ((E_pause *)(*itr))->tagId() == rp->tagId())
-                  itr++;
-              }
-            }
-            /*std::list<Event*>::iterator newElem = */ theEvents.insert (itr, newEvent);
-            //      if (tp != NULL && tp->nodeId() == 0) {
-            //        tagVec[tp->tagNo()-1] = newElem;
-            //      }
-          }
-        } else {
-          // Insert by time
-          while (itr != theEvents.end() &&
-                 (*itr)->Ekind() > Ev_end &&
-                 **itr < *newEvent)
-            itr++;
-          theEvents.insert (itr, newEvent);
-        }
-      }
-    }
+    if (newEvent)
+      insertEvent(itr, newEvent, fileToOpen);
   }
 
   // Remove any task or Btask records that are in the vdbTids db.
@@ -1278,11 +1261,323 @@ int DataModel::LoadFile (const char *fileToOpen, int index, double seq)
   //         fileToOpen, ignoreFork, ignoreTask);
   //  }
 
-  if ( !feof(data) ) return 0;
+  if (verMajor >= 2 && !sawClock) {
+    fprintf (stderr, "Data file %s has no 'Clock' line.\n", fileToOpen);
+    fclose(data);
+    return 0;
+  }
+
+  if ( !sawClock && !feof(data) ) return 0;
 
+  fclose(data);
   return 1;
 }
 
+//  Add the newEvent to the list, group Starts, Tags, Resumes and Ends together.
+
+void DataModel::insertEvent (std::list<Event *>::iterator &itr, Event *newEvent,
+                             const char *filename)
+{
+  if (theEvents.empty()) {
+    theEvents.push_front (newEvent);
+  } else if (itr == theEvents.end()) {
+    theEvents.insert(itr, newEvent);
+  } else {
+    if (newEvent->Ekind() <= Ev_end) {
+      // Group together
+      while (itr != theEvents.end()
+             && (*itr)->Ekind() != newEvent->Ekind())
+        itr++;
+      if (itr == theEvents.end() || (*itr)->Ekind() != newEvent->Ekind()) {
+        fprintf (stderr, "Internal error, event mismatch. file '%s'\n", filename); \
+        printf ("newEvent: "); newEvent->print();
+        if (itr != theEvents.end()) {
+           printf ("itr: "); (*itr)->print();
+        } else {
+           printf ("At end of list\n");
+        }
+      } else {
+        // More complicated ... move past proper kinds ...
+        E_tag *tp = NULL;
+        if (newEvent->Ekind() == Ev_start || newEvent->Ekind() == Ev_end) {
+          // Just find the end of the group
+          while (itr != theEvents.end() && (*itr)->Ekind() == newEvent->Ekind())
+            itr++;
+        } else {
+          // Need to move past them only if they have the same tag!
+          if (newEvent->Ekind() == Ev_tag) {
+            // Work with tags
+            tp = (E_tag *)newEvent;
+            while (itr != theEvents.end()
+                   && (*itr)->Ekind() == Ev_tag
+                   && ((E_tag *)(*itr))->tagNo() == tp->tagNo())
+              itr++;
+          } else {
+            // Work with pauses
+            E_pause *rp = (E_pause *)newEvent;
+            while (itr != theEvents.end()
+                   && (*itr)->Ekind() == Ev_pause
+                   && ((E_pause *)(*itr))->tagId() == rp->tagId())
+              itr++;
+          }
+        }
+        /*std::list<Event*>::iterator newElem = */ theEvents.insert (itr, newEvent);
+        //      if (tp != NULL && tp->nodeId() == 0) {
+        //        tagVec[tp->tagNo()-1] = newElem;
+        //      }
+      }
+    } else {
+      // Insert by time
+      while (itr != theEvents.end() &&
+             (*itr)->Ekind() > Ev_end &&
+             **itr < *newEvent)
+        itr++;
+      theEvents.insert (itr, newEvent);
+    }
+  }
+}
+
+// Binary records are read in time order, so this holds what's needed to
+// sort them without copying them.
+
+struct binRecord {
+  uint64_t time;
+  size_t offset;
+  bool operator< (const binRecord &other) const { return time < other.time; }
+};
+
+// Load the binary records of a version 2 data file, starting at offset.
+// Returns the number of bad records or -1 if the file can't be read.
+
+int DataModel::LoadBinaryRecords (const char *filename, long offset, int findex,
+                                  long clockNs, long startSec, long startUsec,
+                                  std::list<Event *>::iterator &itr,
+                                  std::set<int> &vdbTids, int &nid0vdbtask)
+{
+  struct stat sb;
+  int fd = open(filename, O_RDONLY);
+  int nErrs = 0;
+
+  if (fd < 0) return -1;
+  if (fstat(fd, &sb) < 0) {
+    close(fd);
+    return -1;
+  }
+  size_t fsize = sb.st_size;
+  if (offset < 0 || (size_t)offset >= fsize) {
+    // No events were recorded
+    close(fd);
+    return 0;
+  }
+  char *base = (char *) mmap(NULL, fsize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    fprintf (stderr, "Could not map %s: %s\n", filename, strerror(errno));
+    return -1;
+  }
+
+  // Records are only 8 byte aligned relative to each other, so each one is
+  // copied into this before it is looked at.
+  union {
+    chpl_vdebug_rec_hdr_t hdr;
+    chpl_vdebug_rec_task_t task;
+    chpl_vdebug_rec_task_id_t taskId;
+    chpl_vdebug_rec_comm_t comm;
+    chpl_vdebug_rec_fork_t fork;
+    chpl_vdebug_rec_tag_t tag;
+    chpl_vdebug_rec_tagname_t tagname;
+  } rec;
+
+  // Find the records.  Each thread buffered its own records, so they are
+  // sorted by time before being turned into events.  Tag names are entered
+  // first since tag events need them.
+  std::vector<binRecord> recs;
+  size_t pos = offset;
+  while (pos + sizeof(chpl_vdebug_rec_hdr_t) <= fsize) {
+    memcpy(&rec.hdr, base + pos, sizeof(rec.hdr));
+    if (rec.hdr.size < sizeof(rec.hdr) || pos + rec.hdr.size > fsize) {
+      fprintf (stderr, "Bad record at offset %ld in %s\n", (long)pos, filename);
+      nErrs++;
+      break;
+    }
+    if (rec.hdr.kind == chpl_vdebug_rec_tagname) {
+      char tmpname[256];
+      memcpy(&rec.tagname, base + pos, sizeof(rec.tagname));
+      int len = rec.tagname.length;
+      if (len < 0 || len > 255
+          || sizeof(rec.tagname) + len > rec.hdr.size || rec.tagname.tagno < 0) {
+        printf ("bad tag name record\n");
+        nErrs++;
+      } else {
+        memcpy(tmpname, base + pos + sizeof(rec.tagname), len);
+        tmpname[len] = 0;
+        const char *tag = strDB.getString(tmpname);
+        while (tagNames.size() <= (unsigned)rec.tagname.tagno)
+          tagNames.resize(2*tagNames.size());
+        tagNames[rec.tagname.tagno] = tag;
+      }
+    } else {
+      binRecord br = { rec.hdr.time, pos };
+      recs.push_back(br);
+    }
+    pos += rec.hdr.size;
+  }
+  std::stable_sort(recs.begin(), recs.end());
+
+  long long startNs = (long long)startSec * 1000000000LL
+                      + (long long)startUsec * 1000LL;
+
+  for (size_t ix = 0; ix < recs.size(); ix++) {
+    Event *newEvent = NULL;
+    size_t size;
+
+    memcpy(&rec.hdr, base + recs[ix].offset, sizeof(rec.hdr));
+    size = rec.hdr.size < sizeof(rec) ? rec.hdr.size : sizeof(rec);
+    memcpy(&rec, base + recs[ix].offset, size);
+
+    // Convert the monotonic clock to the time of day
+    long long evNs = startNs + ((long long)rec.hdr.time - (long long)clockNs);
+    long sec = evNs / 1000000000LL;
+    long usec = (evNs % 1000000000LL) / 1000;
+    int nid = rec.hdr.nodeID;
+
+    switch (rec.hdr.kind) {
+
+      case chpl_vdebug_rec_mark:
+        if (size < sizeof(rec.taskId)) { nErrs++; break; }
+        if (nid == 0)
+          nid0vdbtask = rec.taskId.taskID;
+        else
+          (void)vdbTids.insert(rec.taskId.taskID);
+        break;
+
+      case chpl_vdebug_rec_task:
+        if (size < sizeof(rec.task)) { nErrs++; break; }
+        {
+          int taskid = rec.task.taskID;
+          int parentId = rec.task.parentTaskID;
+          int nfileno = rec.task.fileno;
+          int fid = rec.task.fid;
+          // On tasks are not real children of VDebug tasks
+          if (!rec.task.isExecuteOn && (vdbTids.find(parentId) != vdbTids.end()
+                                        || (nid == 0 && parentId == nid0vdbtask))) {
+            // new task (taskid) is also a vdbtask
+            (void)vdbTids.insert(taskid);
+          } else {
+            if (nfileno < 0 || nfileno >= fileTblSize) nfileno = 0;
+            if (fid < 0) fid = 0;
+            newEvent = new E_task (sec, usec, nid, taskid, fid,
+                                   rec.task.isExecuteOn != 0,
+                                   rec.task.lineno, nfileno);
+          }
+        }
+        break;
+
+      case chpl_vdebug_rec_put_nb:
+      case chpl_vdebug_rec_get_nb:
+      case chpl_vdebug_rec_put:
+      case chpl_vdebug_rec_get:
+      case chpl_vdebug_rec_put_strd:
+      case chpl_vdebug_rec_get_strd:
+        if (size < sizeof(rec.comm)) { nErrs++; break; }
+        {
+          int taskid = rec.comm.taskID;
+          int nfileno = rec.comm.fileno;
+          int isGet = (rec.hdr.kind == chpl_vdebug_rec_get_nb
+                       || rec.hdr.kind == chpl_vdebug_rec_get
+                       || rec.hdr.kind == chpl_vdebug_rec_get_strd);
+          if (vdbTids.find(taskid) != vdbTids.end()) {
+            // Ignore this comm as being part of the xxxVdebug system
+            break;
+          }
+          if (nfileno < 0 || nfileno >= fileTblSize) nfileno = 0;
+          if (isGet)
+            newEvent = new E_comm (sec, usec, rec.comm.remoteNodeID, nid,
+                                   rec.comm.elemSize, rec.comm.length, isGet,
+                                   taskid, rec.comm.lineno, nfileno);
+          else
+            newEvent = new E_comm (sec, usec, nid, rec.comm.remoteNodeID,
+                                   rec.comm.elemSize, rec.comm.length, isGet,
+                                   taskid, rec.comm.lineno, nfileno);
+        }
+        break;
+
+      case chpl_vdebug_rec_fork:
+      case chpl_vdebug_rec_fork_nb:
+      case chpl_vdebug_rec_fork_fast:
+        if (size < sizeof(rec.fork)) { nErrs++; break; }
+        {
+          int taskid = rec.fork.taskID;
+          int fid = rec.fork.fid;
+          if (vdbTids.find(taskid) != vdbTids.end()) {
+            break;
+          }
+          if (fid < 0) fid = 0;
+          newEvent = new E_fork(sec, usec, nid, rec.fork.remoteNodeID,
+                                rec.fork.argSize,
+                                rec.hdr.kind == chpl_vdebug_rec_fork_fast,
+                                taskid, fid);
+        }
+        break;
+
+      case chpl_vdebug_rec_tag:
+      case chpl_vdebug_rec_pause:
+      case chpl_vdebug_rec_end:
+        if (size < sizeof(rec.tag)) { nErrs++; break; }
+        {
+          long u_sec = rec.tag.userUsec / 1000000;
+          long u_usec = rec.tag.userUsec % 1000000;
+          long s_sec = rec.tag.sysUsec / 1000000;
+          long s_usec = rec.tag.sysUsec % 1000000;
+          int tagId = rec.tag.tagno;
+          int vdbTid = rec.tag.taskID;
+          if (rec.hdr.kind == chpl_vdebug_rec_end) {
+            newEvent = new E_end(sec, usec, nid, u_sec, u_usec, s_sec, s_usec,
+                                 vdbTid);
+          } else if (tagId < 0 || (rec.hdr.kind == chpl_vdebug_rec_tag
+                                   && (unsigned)tagId >= tagNames.size())) {
+            fprintf (stderr, "Bad tag number %d: %s\n", tagId, filename);
+            nErrs++;
+          } else if (rec.hdr.kind == chpl_vdebug_rec_pause) {
+            newEvent = new E_pause(sec, usec, nid, u_sec, u_usec,
+                                   s_sec, s_usec, tagId, vdbTid);
+            if (nid == 0)
+              nid0vdbtask = 0;
+          } else {
+            newEvent = new E_tag(sec, usec, nid, u_sec, u_usec, s_sec, s_usec,
+                                 tagId, tagNames[tagId], vdbTid);
+            if (tagId >= numTags)
+              numTags = tagId+1;
+            if (nid == 0)
+              nid0vdbtask = 0;
+          }
+        }
+        break;
+
+      case chpl_vdebug_rec_etask:
+        if (size < sizeof(rec.taskId)) { nErrs++; break; }
+        if (vdbTids.find(rec.taskId.taskID) == vdbTids.end())
+          newEvent = new E_end_task(sec, usec, nid, rec.taskId.taskID);
+        break;
+
+      case chpl_vdebug_rec_btask:
+        if (size < sizeof(rec.taskId)) { nErrs++; break; }
+        if (vdbTids.find(rec.taskId.taskID) == vdbTids.end())
+          newEvent = new E_begin_task(sec, usec, nid, rec.taskId.taskID);
+        break;
+
+      default:
+        /* Skip kinds this version doesn't know */ ;
+    }
+
+    if (newEvent)
+      insertEvent(itr, newEvent, filename);
+  }
+
+  munmap(base, fsize);
+  return nErrs;
+}
+
 // Get the task data by task Id and locale.
 
 taskData * DataModel::getTaskData (long locale, long taskId, long tagNo)
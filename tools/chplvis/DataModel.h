@@ -25,6 +25,7 @@
 #include <list>
 #include <vector>
 #include <map>
+#include <set>
 #include "StringCache.h"
 
 // This class builds a list of events 
@@ -35,9 +36,10 @@
 // This is the class that reads the files as generated by runtime/src/chpl-visual-debug.c
 // in the Chapel runtime.
 //
-// Initially the data files are in ascii.  To turn these into binary data files,
-// both this class and runtime/src/chpl-visual-debug.c need to be modified to
-// write (chpl-visual-debug.c) and read (this class) in binary.
+// Version 1.4 data files are all ascii.  Version 2.0 data files start with
+// the same ascii header lines and end with binary event records described
+// in runtime/include/chpl-visual-debug-format.h.  The binary records are
+// read through an mmap of the file.
 
 // Support Structs used by DataModel
 
@@ -165,6 +167,18 @@ class DataModel {
   // Utility routines
   
   int LoadFile (const char *filename, int index, double seq);
+
+  int LoadBinaryRecords (const char *filename, long offset, int findex,
+                         long clockNs, long startSec, long startUsec,
+                         std::list<Event *>::iterator &itr,
+                         std::set<int> &vdbTids, int &nid0vdbtask);
+
+  void insertEvent (std::list<Event *>::iterator &itr, Event *newEvent,
+                    const char *filename);
+
+  // Version of the data files being loaded
+  int verMajor;
+  int verMinor;
   
   void newList ();
   
@@ -293,6 +307,8 @@ class DataModel {
     uniqueTags = true;
     utagList = NULL;
     tagNames.resize(64);
+    verMajor = 0;
+    verMinor = 0;
   }
   
   // Destructor for DataModel
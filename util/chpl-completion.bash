@@ -24,6 +24,7 @@ _chpl ()
       local devel_opts="\
 --allow-noinit-array-not-pod \
 --atomics \
+--auto-aggregation \
 --auto-local-access \
 --auto-local-access-dynamic \
 --aux-filesys \
@@ -49,6 +50,7 @@ _chpl ()
 --count-tokens \
 --cpp-lines \
 --dead-code-elimination \
+--devirtualize \
 --debug \
 --debug-short-loc \
 --default-dist \
@@ -89,6 +91,7 @@ _chpl ()
 --incremental \
 --infer-const-refs \
 --infer-local-fields \
+--infer-locality \
 --inline \
 --inline-iterators \
 --inline-iterators-yield-limit \
@@ -115,6 +118,7 @@ _chpl ()
 --llvm \
 --llvm-print-ir \
 --llvm-print-ir-stage \
+--llvm-runtime-lto \
 --llvm-wide-opt \
 --local \
 --local-checks \
@@ -141,6 +145,7 @@ _chpl ()
 --network-atomics \
 --nil-checks \
 --no-allow-noinit-array-not-pod \
+--no-auto-aggregation \
 --no-auto-local-access \
 --no-auto-local-access-dynamic \
 --no-bounds-checks \
@@ -155,6 +160,7 @@ _chpl ()
 --no-count-tokens \
 --no-cpp-lines \
 --no-dead-code-elimination \
+--no-devirtualize \
 --no-debug \
 --no-debug-short-loc \
 --no-denormalize \
@@ -177,6 +183,7 @@ _chpl ()
 --no-incremental \
 --no-infer-const-refs \
 --no-infer-local-fields \
+--no-infer-locality \
 --no-inline \
 --no-inline-iterators \
 --no-interprocedural-alias-analysis \
@@ -185,6 +192,7 @@ _chpl ()
 --no-lifetime-checking \
 --no-live-analysis \
 --no-llvm \
+--no-llvm-runtime-lto \
 --no-llvm-wide-opt \
 --no-local \
 --no-local-checks \
@@ -229,6 +237,7 @@ _chpl ()
 --no-scalar-replacement \
 --no-specialize \
 --no-split-initialization \
+--no-stack-allocate-classes \
 --no-stack-checks \
 --no-task-tracking \
 --no-tuple-copy-opt \
@@ -274,6 +283,8 @@ _chpl ()
 --print-unused-functions \
 --print-unused-internal-functions \
 --privatization \
+--profile-generate \
+--profile-use \
 --regexp \
 --region-vectorizer \
 --remote-serialization \
@@ -287,6 +298,8 @@ _chpl ()
 --report-blocking \
 --report-dead-blocks \
 --report-dead-modules \
+--report-devirtualization \
+--report-inferred-locality \
 --report-inlined-iterators \
 --report-inlining \
 --report-optimized-forall-unordered-ops \
@@ -294,6 +307,7 @@ _chpl ()
 --report-optimized-on \
 --report-promotion \
 --report-scalar-replace \
+--report-stack-allocation \
 --report-vectorized-loops \
 --savec \
 --scalar-replace-limit \
@@ -301,6 +315,7 @@ _chpl ()
 --set \
 --specialize \
 --split-initialization \
+--stack-allocate-classes \
 --stack-checks \
 --static \
 --stop-after-pass \
@@ -335,6 +350,7 @@ _chpl ()
       # non-developer options
       local nodevel_opts="\
 --atomics \
+--auto-aggregation \
 --auto-local-access \
 --auto-local-access-dynamic \
 --aux-filesys \
@@ -352,6 +368,7 @@ _chpl ()
 --count-tokens \
 --cpp-lines \
 --dead-code-elimination \
+--devirtualize \
 --debug \
 --devel \
 --div-by-zero-checks \
@@ -373,6 +390,7 @@ _chpl ()
 --ieee-float \
 --ignore-local-classes \
 --infer-local-fields \
+--infer-locality \
 --inline \
 --inline-iterators \
 --inline-iterators-yield-limit \
@@ -384,6 +402,7 @@ _chpl ()
 --license \
 --live-analysis \
 --llvm \
+--llvm-runtime-lto \
 --llvm-wide-opt \
 --local \
 --local-checks \
@@ -398,6 +417,7 @@ _chpl ()
 --munge-user-idents \
 --network-atomics \
 --nil-checks \
+--no-auto-aggregation \
 --no-auto-local-access \
 --no-auto-local-access-dynamic \
 --no-bounds-checks \
@@ -409,6 +429,7 @@ _chpl ()
 --no-count-tokens \
 --no-cpp-lines \
 --no-dead-code-elimination \
+--no-devirtualize \
 --no-debug \
 --no-devel \
 --no-div-by-zero-checks \
@@ -418,10 +439,12 @@ _chpl ()
 --no-ieee-float \
 --no-ignore-local-classes \
 --no-infer-local-fields \
+--no-infer-locality \
 --no-inline \
 --no-inline-iterators \
 --no-live-analysis \
 --no-llvm \
+--no-llvm-runtime-lto \
 --no-llvm-wide-opt \
 --no-local \
 --no-local-checks \
@@ -448,6 +471,7 @@ _chpl ()
 --no-remove-copy-calls \
 --no-scalar-replacement \
 --no-specialize \
+--no-stack-allocate-classes \
 --no-stack-checks \
 --no-task-tracking \
 --no-tuple-copy-opt \
@@ -473,6 +497,8 @@ _chpl ()
 --print-search-dirs \
 --print-unused-functions \
 --privatization \
+--profile-generate \
+--profile-use \
 --regexp \
 --remote-serialization \
 --remote-value-forwarding \
@@ -482,6 +508,7 @@ _chpl ()
 --scalar-replacement \
 --set \
 --specialize \
+--stack-allocate-classes \
 --stack-checks \
 --static \
 --target-arch \